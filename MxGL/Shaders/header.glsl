@@ -1,11 +1,11 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-//  Version of OpenGL and extensions
-//========================================================================
-
-#version 450 core
-#extension GL_ARB_bindless_texture : require
-#extension GL_ARB_shader_atomic_counter_ops: require
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Version of OpenGL and extensions
+//========================================================================
+
+#version 450 core
+#extension GL_ARB_bindless_texture : require
+#extension GL_ARB_shader_atomic_counter_ops: require
@@ -1,13 +1,27 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-in vec2  i_VertexPos;
-in ivec2 i_Pixel;
-
-void main(void)
-{
-  gl_Position  = u_Positionning.model * vec4(i_VertexPos, u_HeightMap.heightFactor * texelFetch(u_HeightMap.heightTexture, i_Pixel, 0).r, 1);
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+// Vertex of the map grid derived from its rank (no vertex attribute): one vertex per texel for the points, two per
+// segment between neighbour texels for the wireframe (MAP_LINES: row segments, then column segments)
+void main(void)
+{
+  ivec2 size = textureSize(u_HeightMap.heightTexture, 0);
+
+#ifdef MAP_LINES
+  int rowSegmentNb = (size.x - 1) * size.y;
+  int segment      = gl_VertexID / 2;
+  int end          = gl_VertexID % 2;
+  ivec2 grid       = segment < rowSegmentNb ? ivec2(segment % (size.x - 1) + end, segment / (size.x - 1))
+                                            : ivec2((segment - rowSegmentNb) / (size.y - 1), (segment - rowSegmentNb) % (size.y - 1) + end);
+#else
+  ivec2 grid       = ivec2(gl_VertexID / size.y, gl_VertexID % size.y);
+#endif
+
+  // Grid y axis opposite to the texture rows
+  vec2  position   = vec2(grid) * vec2(u_HeightMap.terrainSubdivision) / vec2(max(size - 1, ivec2(1)));
+  ivec2 pixel      = ivec2(grid.x, size.y - 1 - grid.y);
+  gl_Position  = u_Positionning.model * vec4(position, u_HeightMap.heightFactor * (texelFetch(u_HeightMap.heightTexture, pixel, 0).r * u_HeightMap.heightScale + u_HeightMap.heightOffset), 1);
+}
@@ -0,0 +1,41 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Shader Storage Buffer Object definition for the adaptive subdivision
+//  of the terrain computed on GPU (see MxTerrain::s_Subdivision).
+//    A node (uvec2) is the pair (key, level) of a square of a patch:
+//    key = patch index << 2*maxLevel | morton code << 2*(maxLevel-level)
+//    so that the node list, sorted by key, is in Z-order.
+//========================================================================
+
+const uint subdivisionNodeCapacity = 65536;  // Max number of nodes (leaves) of the subdivision
+const uint subdivisionGridSize     = 8;      // Number of subdivisions of each side of a leaf (drawn grid)
+
+layout(std430) buffer u_SubdivisionBlock
+{
+  uint  dispatch[3];                          // DispatchIndirectCommand (one group per 64 nodes of the current list)
+  uint  nodeNumber;                           // Number of nodes of the current list
+  uint  draw[5];                              // DrawElementsIndirectCommand (one instance of the leaf grid per visible node)
+  uint  current;                              // Current node list (0 or 1)
+  uint  nextNodeNumber;                       // Number of nodes of the list under construction
+  uint  splitNumber;                          // Nodes added by the splits of the frame (bounded by the capacity)
+  uint  maxLevel;                             // Max subdivision level (constrained by the 32 bits of the key)
+  uint  _alignment[3];
+  uvec2 nodes[2*subdivisionNodeCapacity];     // Both node lists (current one and the one under construction)
+  uint  actions[subdivisionNodeCapacity];     // Action decided for each node of the current list
+  uint  offsets[subdivisionNodeCapacity];     // Position of the node(s) resulting from each action in the new list
+  uvec4 drawList[subdivisionNodeCapacity];    // Visible nodes (key, level, neighbour levels, 0), read per instance
+} u_Subdivision;
+
+// Actions on a node (value is the number of resulting nodes, except for merge)
+const uint subdivisionRemove = 0;   // Sibling 1, 2 or 3 of a merge
+const uint subdivisionKeep   = 1;
+const uint subdivisionMerge  = 2;   // Sibling 0 of a merge, replaced by the parent
+const uint subdivisionSplit  = 4;
+
+uint getSubdivisionNodeCount(uint action)
+{
+  return action == subdivisionMerge ? 1 : action;
+}
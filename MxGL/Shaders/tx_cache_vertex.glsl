@@ -0,0 +1,34 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Vertex Shader replaying the terrain vertex stream captured by
+//  transform feedback at the output of the geometry shader.
+//========================================================================
+
+// Point in clipping space (already projected)
+in vec4  i_VertexPos;
+// Lit color of the vertex
+in vec4  i_VertexColor;
+// Height of the vertex
+in float i_Height;
+// Height gradient on screen (isolines)
+in float i_ScreenHeightGradient;
+
+out GSO
+{
+  vec4  VertexColor;
+  float Height;
+  float ScreenHeightGradient;
+} vso;
+
+
+void main(void)
+{
+  // Data passed unchanged to the terrain fragment shader
+  gl_Position              = i_VertexPos;
+  vso.VertexColor          = i_VertexColor;
+  vso.Height               = i_Height;
+  vso.ScreenHeightGradient = i_ScreenHeightGradient;
+}
@@ -0,0 +1,49 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Fragment color of the terrain surface (optional height color map and
+//  isolines), shared by the fragment shaders of the terrain fill.
+//========================================================================
+
+// Color from the shaded vertex color, the height and its gradient projected on screen
+vec4 getFragmentColor(vec4 vertexColor, float height, float screenHeightGradient)
+{
+  vec4 color = vertexColor;
+
+  // Optional use of a height color map to determine color
+  if (HM_COLOR_MODE == 1)
+  {
+    float u = clamp((height - u_HeightMap.minHeightColorMap) / (u_HeightMap.maxHeightColorMap - u_HeightMap.minHeightColorMap), 0, 1);
+    float v = 0.5;
+    color = texture(u_HeightMap.heightColorMap, vec2(u, v))*vertexColor;
+  }
+
+  // Optional isoline display
+  if (HM_ISOLINES)
+  {
+    if (screenHeightGradient > 0) // Avoid colouring flat zones
+    {
+      vec4 isolineColor;
+      if (HM_COLOR_MODE == 1)
+        isolineColor = vec4(0, 0, 0, 1);
+      else
+        isolineColor = vec4(1, 0.463, 0.027, 1);
+
+      float intpart = 0;
+      float fract = modf(height / u_HeightMap.isolineStep, intpart);
+
+      // 5px or 2.5px width (2.5+2.5 or 1.25+1.25) and transition with the same width
+      float width = (int(mod(height / u_HeightMap.isolineStep + 0.5, 5)) == 0) ? 2.5 : 1.25;
+      float limit = width / (screenHeightGradient * u_HeightMap.isolineStep);
+
+      //if (fract < 2 * limit || fract > 1 - 2 * limit) //Systematic computation moreefficient than a conditionnal instruction?
+      // isolineColor*color inside [0,limit] and [1-limit, 1] and mix(isolineColor,white,alpha)*color inside [limit,2*limit]
+      // and [1-2*limit, 1-limit] with alpha=(min(fract, 1-fract)-limit)/limit
+      color = mix(isolineColor, vec4(1, 1, 1, 1), clamp((min(fract, 1 - fract) - limit) / limit, 0, 1))*color;
+    }
+  }
+
+  return color;
+}
@@ -0,0 +1,44 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Fragment Shader for terrain surface representation with patch borders
+//  (green) and tesselated triangle borders (blue) drawn over the surface
+//  from the distances to the edges computed by tx_geometry_edges.glsl.
+//========================================================================
+
+// Inputs resulting from GS computation
+in GSO
+{
+  vec4  VertexColor;
+  float Height;
+  float ScreenHeightGradient;
+  noperspective vec3 EdgeDistance;
+  flat uint PatchEdges;
+} fsi;
+
+// Resulting fragment's color
+out vec4 fso_color;
+
+
+void main(void)
+{
+  fso_color = getFragmentColor(fsi.VertexColor, fsi.Height, fsi.ScreenHeightGradient);
+
+  // Nearest edge, patch borders prevailing over triangle borders
+  float edgeDistance = 1e10;
+  vec4  edgeColor    = vec4(.0, .0, 1., 1.);
+  for (uint edge = 0; edge < 3; edge++)
+  {
+    bool onPatchBorder = (fsi.PatchEdges & (1u << edge)) != 0;
+    if (fsi.EdgeDistance[edge] < edgeDistance || (onPatchBorder && fsi.EdgeDistance[edge] < edgeDistance + 1))
+    {
+      edgeDistance = fsi.EdgeDistance[edge];
+      edgeColor    = onPatchBorder ? vec4(.0, 1., .0, 1.) : vec4(.0, .0, 1., 1.);
+    }
+  }
+
+  // 1px line with antialiased transition of 1px on each side
+  fso_color = mix(edgeColor, fso_color, smoothstep(0.5, 1.5, edgeDistance));
+}
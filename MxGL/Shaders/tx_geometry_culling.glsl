@@ -0,0 +1,52 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Triangle culling shared by the geometry shaders of the terrain fill
+//  (tx_geometry.glsl and tx_geometry_edges.glsl).
+//========================================================================
+
+layout(binding = 0) uniform atomic_uint u_GeometryCounter1;
+layout(binding = 1) uniform atomic_uint u_GeometryCounter2;
+
+vec2 ndc(vec4 viewPoint)
+{
+  vec4 proj = u_Viewing.projection * viewPoint;
+  return proj.xy / proj.w;
+}
+
+// Discards non visible triangle (out of frustum and back face), counting the discarded
+// triangles, and returns the vertices in view coordinates otherwise
+bool isTriangleVisible(out vec4 viewPoints[3])
+{
+  viewPoints[0] = u_Viewing.view * gl_in[0].gl_Position;
+  viewPoints[1] = u_Viewing.view * gl_in[1].gl_Position;
+  viewPoints[2] = u_Viewing.view * gl_in[2].gl_Position;
+
+  // Patch unvisible if the 3 vertices are out of the frustum
+  vec2 ndcPos[3];
+  ndcPos[0] = ndc(viewPoints[0]);
+  ndcPos[1] = ndc(viewPoints[1]);
+  ndcPos[2] = ndc(viewPoints[2]);
+
+  float patchVisibility0 = sign(1 + ndcPos[0].x)*sign(1 - ndcPos[0].x)*sign(1 + ndcPos[0].y)*sign(1 - ndcPos[0].y);
+  float patchVisibility1 = patchVisibility0 > 0 ? 1 : sign(1 + ndcPos[1].x)*sign(1 - ndcPos[1].x)*sign(1 + ndcPos[1].y)*sign(1 - ndcPos[1].y);
+  float patchVisibility2 = patchVisibility1 > 0 ? 1 : sign(1 + ndcPos[2].x)*sign(1 - ndcPos[2].x)*sign(1 + ndcPos[2].y)*sign(1 - ndcPos[2].y);
+
+  if (patchVisibility2 < 0)
+  {
+    atomicCounterAddARB(u_GeometryCounter2, 2);
+    return false;
+  }
+
+  // Back-face culling
+  if (dot(cross(viewPoints[1].xyz, viewPoints[2].xyz), viewPoints[0].xyz) > 0) // simplification of dot(cross(p1-p0,p2-p0),p0-eye)>0 with eye=origin
+  {
+    atomicCounterAddARB(u_GeometryCounter2, 1);
+    return false;
+  }
+
+  atomicCounterIncrement(u_GeometryCounter1);
+  return true;
+}
@@ -0,0 +1,75 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Geometry Shader for terrain surface representation with its patch
+//  and triangle borders drawn in the same pass (see tx_fragment_edges.glsl):
+//  each vertex carries its distance (pixels) to the opposite edge.
+//========================================================================
+
+layout(triangles) in;
+layout(triangle_strip, max_vertices = 4) out;
+
+// Inputs resulting from TES interpolation (HeightTextureUV, VertexColor) and height
+in TESO
+{
+  vec2  HeightTextureUV;
+  vec4  VertexColor;
+  float Height;
+  uint  OnBorder;
+} gsi[];
+
+out GSO
+{
+  vec4  VertexColor;
+  float Height;
+  float ScreenHeightGradient;
+  noperspective vec3 EdgeDistance;  // Distance (pixels) to each edge, edge k being opposite to vertex k
+  flat uint PatchEdges;             // Bit k set if edge k lies on a patch border
+} gso;
+
+void main(void)
+{
+  // Discard non visible triangle (out of frustum and back face, see tx_geometry_culling.glsl)
+  vec4 viewPoints[3];
+  if (!isTriangleVisible(viewPoints))
+    return;
+
+  // Triangle heights in window coordinates
+  vec2 p0 = u_Viewing.viewport * ndc(viewPoints[0]);
+  vec2 p1 = u_Viewing.viewport * ndc(viewPoints[1]);
+  vec2 p2 = u_Viewing.viewport * ndc(viewPoints[2]);
+  float area = 0.5 * abs((p1.x - p0.x)*(p2.y - p0.y) - (p1.y - p0.y)*(p2.x - p0.x));
+  vec3 heights = 2 * area / vec3(distance(p1, p2), distance(p2, p0), distance(p0, p1));
+
+  uint patchEdges = 0;
+  for (uint index = 0; index < 3; index++)
+  {
+    if ((gsi[(index+1)%3].OnBorder & gsi[(index+2)%3].OnBorder) != 0)
+      patchEdges |= 1u << index;
+  }
+
+  for (uint index = 0; index < gl_in.length(); index++)
+  {
+    // Point set in clipping space (projection)
+    vec4 viewPoint = viewPoints[index];
+    gl_Position = u_Viewing.projection * viewPoint;
+
+    // Lit color and optional isoline gradient (see tx_shading.glsl)
+    gso.VertexColor          = getShadedColor(gl_in[index].gl_Position, viewPoint, gsi[index].HeightTextureUV, gsi[index].VertexColor);
+    gso.ScreenHeightGradient = getScreenHeightGradient(gl_in[index].gl_Position, gsi[index].HeightTextureUV);
+
+    // Null distance to both edges joining at the vertex
+    gso.EdgeDistance        = vec3(0);
+    gso.EdgeDistance[index] = heights[index];
+    gso.PatchEdges          = patchEdges;
+
+    // Passes data inchanged
+    gso.Height = gsi[index].Height;
+
+    EmitVertex();
+  }
+
+  EndPrimitive();
+}
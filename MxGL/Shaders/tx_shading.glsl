@@ -0,0 +1,87 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Per-vertex shading of the terrain surface (Gouraud lighting, optional
+//  shadow and isoline gradient), shared by the geometry shader of the
+//  tesselation pipeline and the vertex shader of the GPU subdivision.
+//========================================================================
+
+// Lit color of a terrain vertex given its position in world coordinates (worldPoint)
+// and in view coordinates (viewPoint), transparency unchanged
+vec4 getShadedColor(vec4 worldPoint, vec4 viewPoint, vec2 heightTextureUV, vec4 baseColor)
+{
+  const vec4 viewSpaceLightPosition = u_Viewing.view * u_Lighting.position;
+
+  vec3 modelNormal = getModelNormalFromTexture(heightTextureUV);
+  vec4 viewNormal  = u_Viewing.view * vec4(modelNormal, .0);
+
+  float shadow = 1;
+  //====================================================================
+  // Shadow: Alternate computation algo to shadow mapping
+  //         project line joining point to light onto the height map
+  //         and dertemine potential point of greater height masking
+  //         the light. Unsatisafctory: the shadow's edge is not accurate
+  //         and the performance is highly impaired. Quadtree of the height
+  //         map representing max height might solve performance issue
+  //         (intersect the projection with the quadtree). Quality
+  //         issue on the shadow's border.
+  //
+  if (HM_SHADOW)
+  {
+    vec4 pt   = worldPoint;
+    vec3 dir  = normalize(u_Lighting.position.xyz - pt.xyz);
+    vec3 xDir = (u_Positionning.model * vec4(1.0, 0.0, 0.0, 0.0)).xyz;
+    vec3 yDir = (u_Positionning.model * vec4(0.0, -1.0, 0.0, 0.0)).xyz;
+
+    float gradient  = dir.z / sqrt(dir.x*dir.x + dir.y*dir.y);
+    vec2 textureDir = normalize(vec2(dot(xDir, dir), dot(yDir, dir)));
+    vec2 dStep      = textureDir / float(mapSize - 1);
+    vec2 uv = heightTextureUV;
+    while (uv.x >= 0 && uv.x <= 1 && uv.y >= 0 && uv.y <= 1)
+    {
+      uv += dStep;
+      vec4  ptT = u_Positionning.model * vec4(vec2(uv.x, 1 - uv.y) * u_HeightMap.terrainSubdivision, getHeight(uv), 1.0);
+      vec4  jt  = ptT - pt;
+      float lg  = sqrt(jt.x*jt.x + jt.y*jt.y);
+      float h   = lg * gradient;
+      float limit = 2;
+      if (jt.z > h)
+      {
+        //shadow = 0; break;
+        float s = clamp(1-(jt.z-h+2)/10, 0, 1);
+        if (s < shadow)
+          shadow *= s;
+        if (shadow == 0)
+          break;
+      }
+    }
+  }
+  //================================================================
+
+  // Compute light ray incidence and diffuse and specular factors
+  // and eventually color at vertex (transparencey inchanged)
+  vec3 pointToLightDir = normalize(viewSpaceLightPosition.xyz - viewPoint.xyz);
+  vec3 pointToEyeDir   = normalize(-viewPoint.xyz);
+  vec3 modelReflection = reflect(-pointToLightDir, viewNormal.xyz);
+
+  float diffuse  = dot(pointToLightDir, viewNormal.xyz);
+  float specular = pow(max(.0, dot(pointToEyeDir.xyz, modelReflection)), u_Lighting.specularPower);
+  return vec4(min((0.1+shadow/2)*(u_Lighting.ambiantColor.xyz + diffuse*u_Lighting.diffuseColor.xyz + specular*u_Lighting.specularColor) * baseColor.rgb, 1.), baseColor.w);
+}
+
+// Height gradient projected on screen (pixels) for the optional isoline display, 0 otherwise
+float getScreenHeightGradient(vec4 worldPoint, vec2 heightTextureUV)
+{
+  if (HM_ISOLINES)
+  {
+    vec2 gradient2D = getGradient(heightTextureUV);
+    vec4 gradient3D = vec4(normalize(vec3(gradient2D.x, gradient2D.y, gradient2D.x*gradient2D.x + gradient2D.y*gradient2D.y)), 0.0);
+    vec4 p1 = u_Viewing.projection * u_Viewing.view * (worldPoint + gradient3D);
+    vec4 p2 = u_Viewing.projection * u_Viewing.view * (worldPoint - gradient3D);
+    return distance(u_Viewing.viewport * p1.xy / p1.w, u_Viewing.viewport * p2.xy / p2.w) / (2 * gradient3D.z);
+  }
+
+  return 0;
+}
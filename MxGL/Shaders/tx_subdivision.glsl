@@ -0,0 +1,205 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Node management and subdivision criteria of the terrain subdivision
+//  computed on GPU. Node squares are expressed in patch grid coordinates
+//  (the patch (i,j) covers [i,i+1]x[j,j+1] before model transformation).
+//========================================================================
+
+// Morton code <-> coordinates (x on even bits, y on odd bits)
+uint spreadBits(uint value)
+{
+  value &= 0x0000FFFFu;
+  value = (value | (value << 8)) & 0x00FF00FFu;
+  value = (value | (value << 4)) & 0x0F0F0F0Fu;
+  value = (value | (value << 2)) & 0x33333333u;
+  value = (value | (value << 1)) & 0x55555555u;
+  return value;
+}
+
+uint compactBits(uint value)
+{
+  value &= 0x55555555u;
+  value = (value | (value >> 1)) & 0x33333333u;
+  value = (value | (value >> 2)) & 0x0F0F0F0Fu;
+  value = (value | (value >> 4)) & 0x00FF00FFu;
+  value = (value | (value >> 8)) & 0x0000FFFFu;
+  return value;
+}
+
+//=================================================================================
+//                                 Node hierarchy
+//=================================================================================
+
+// Rank (0..3) of the node among its siblings
+uint getSiblingRank(uvec2 node)
+{
+  return (node.x >> (2 * (u_Subdivision.maxLevel - node.y))) & 3u;
+}
+
+uvec2 getParentNode(uvec2 node)
+{
+  uint shift = 2 * (u_Subdivision.maxLevel - node.y + 1);
+  return uvec2((node.x >> shift) << shift, node.y - 1);
+}
+
+uvec2 getChildNode(uvec2 node, uint rank)
+{
+  return uvec2(node.x | (rank << (2 * (u_Subdivision.maxLevel - node.y - 1))), node.y + 1);
+}
+
+// Square covered by the node: origin and side in patch grid coordinates
+void getNodeSquare(uvec2 node, out vec2 origin, out float size)
+{
+  uint  maxLevel = u_Subdivision.maxLevel;
+  uint  patchIndex = node.x >> (2 * maxLevel);
+  uint  morton = (node.x & ((1u << (2 * maxLevel)) - 1u)) >> (2 * (maxLevel - node.y));
+  ivec2 patchPos = ivec2(patchIndex / u_HeightMap.terrainSubdivision.y, patchIndex % u_HeightMap.terrainSubdivision.y);
+
+  size   = 1.0 / float(1u << node.y);
+  origin = vec2(patchPos) + size * vec2(compactBits(morton), compactBits(morton >> 1));
+}
+
+bool isInsideTerrain(vec2 gridPoint)
+{
+  return all(greaterThanEqual(gridPoint, vec2(0))) && all(lessThan(gridPoint, vec2(u_HeightMap.terrainSubdivision)));
+}
+
+// Leaf of the current list containing the point (patch grid coordinates inside the terrain)
+uvec2 findLeaf(vec2 gridPoint)
+{
+  uint  maxLevel = u_Subdivision.maxLevel;
+  ivec2 patchPos = min(ivec2(gridPoint), u_HeightMap.terrainSubdivision - 1);
+  uvec2 finest   = uvec2(clamp((gridPoint - vec2(patchPos)) * float(1u << maxLevel), vec2(0), vec2((1u << maxLevel) - 1u)));
+  uint  key      = (uint(patchPos.x * u_HeightMap.terrainSubdivision.y + patchPos.y) << (2 * maxLevel)) | spreadBits(finest.x) | (spreadBits(finest.y) << 1);
+
+  // Binary search of the last node with a key lower or equal (the leaves are sorted and pave the terrain)
+  uint base  = u_Subdivision.current * subdivisionNodeCapacity;
+  uint lower = 0;
+  uint upper = u_Subdivision.nodeNumber;
+  while (upper - lower > 1)
+  {
+    uint middle = (lower + upper) / 2;
+    if (u_Subdivision.nodes[base + middle].x <= key)
+      lower = middle;
+    else
+      upper = middle;
+  }
+
+  return u_Subdivision.nodes[base + lower];
+}
+
+uint findLeafLevel(vec2 gridPoint)
+{
+  return findLeaf(gridPoint).y;
+}
+
+//=================================================================================
+//                               Subdivision criteria
+//=================================================================================
+
+vec2 getGridHeightTextureUV(vec2 gridPoint)
+{
+  return vec2(gridPoint.x / u_HeightMap.terrainSubdivision.x, 1 - gridPoint.y / u_HeightMap.terrainSubdivision.y);
+}
+
+vec4 getGridWorldPoint(vec2 gridPoint, float height)
+{
+  return u_Positionning.model * vec4(gridPoint, height, 1);
+}
+
+// Node square intersecting the viewing frustum (bounding box from zero to the max height)
+bool isSquareVisible(vec2 origin, float size)
+{
+  vec2 points[4] = { origin, origin + vec2(size, 0), origin + vec2(0, size), origin + vec2(size) };
+  return isBoxVisible(u_Viewing.projection * u_Viewing.view * u_Positionning.model, points);
+}
+
+vec2 ndc(vec4 worldPoint)
+{
+  vec4 proj = u_Viewing.projection * u_Viewing.view * worldPoint;
+  return proj.xy / proj.w;
+}
+
+// Same criteria as the tesselation control shader, deltaUV being the half side of the square in uv
+float screenCovering(vec2 projVertex1, vec2 projVertex2)
+{
+  float pixelDistance = 0.5 * distance(u_Viewing.viewport * projVertex1, u_Viewing.viewport * projVertex2);
+  return pixelDistance / u_HeightMap.maxPixelSubdivisionRatio;
+}
+
+float heightDistortion(vec4 vertex0, vec4 vertex1, vec2 uv0, vec2 uv1, vec2 deltaUV)
+{
+  // Point in the middle of the edge
+  vec2 uvCenter = 0.5*(uv0 + uv1);
+  vec4 center   = vec4(0.5*(vertex0.xy + vertex1.xy), getHeight(uvCenter), 0);
+
+  vec2 orthoUV  = normalize(vec2(uv0.t - uv1.t, uv1.s - uv0.s));
+  vec2 orthoVec = normalize(vec2(vertex0.y - vertex1.y, vertex1.x - vertex0.x));
+
+  // Middles of both squares adjacent to the edge (clamped to the terrain limits)
+  vec2 delta   = orthoUV*deltaUV;
+  vec2 uv2     = clamp(uvCenter + delta, 0, 1);
+  vec2 duv     = uv2 - uvCenter;
+  vec4 vertex2 = vec4(center.xy + (u_HeightMap.terrainDimension.x*duv.x+u_HeightMap.terrainDimension.y*duv.y)*orthoVec, getHeight(uv2), 0);
+  vec2 uv3     = clamp(uvCenter - delta, 0, 1);
+  duv          = uv3 - uvCenter;
+  vec4 vertex3 = vec4(center.xy + (u_HeightMap.terrainDimension.x*duv.x+u_HeightMap.terrainDimension.y*duv.y)*orthoVec, getHeight(uv3), 0);
+
+  float mean = 0.2 * (vertex0.z + vertex1.z + vertex2.z + vertex3.z + center.z);
+  vec4  deviation = vec4(vertex0.z, vertex1.z, vertex2.z, vertex3.z) - mean;
+  float distortion = dot(deviation, deviation) + (center.z - mean)*(center.z - mean);
+
+  // Impose greater subdivision when isoline to be displayed inside the square
+  float minT = 0;
+  if (HM_ISOLINES)
+  {
+    float minHeight = min(min(min(min(center.z, vertex0.z), vertex1.z), vertex2.z), vertex3.z);
+    float maxHeight = max(max(max(max(center.z, vertex0.z), vertex1.z), vertex2.z), vertex3.z);
+    if (int(minHeight / u_HeightMap.isolineStep) != int(maxHeight / u_HeightMap.isolineStep))
+      minT = 2.0;
+  }
+
+  return max(minT, u_HeightMap.distortionFactor * sqrt(distortion / (distance(vertex0, vertex1) * distance(vertex2, vertex3))));
+}
+
+// Number of subdivisions wished for each side of the square (max over the 4 edges, 0 if not visible)
+float getSquareSubdivision(vec2 origin, float size)
+{
+  if (!isSquareVisible(origin, size))
+    return 0;
+
+  vec2 uv[4];
+  vec4 vertices[4];
+  vec2 ndcPos[4];
+  for (uint corner = 0; corner < 4; corner++)
+  {
+    // Counterclockwise corners from origin
+    vec2 gridPoint   = origin + size * vec2(corner == 1 || corner == 2 ? 1 : 0, corner >= 2 ? 1 : 0);
+    uv[corner]       = getGridHeightTextureUV(gridPoint);
+    vertices[corner] = getGridWorldPoint(gridPoint, getHeight(uv[corner]));
+    ndcPos[corner]   = ndc(vertices[corner]);
+  }
+
+  vec2 deltaUV = 0.5*size*vec2(float(1) / u_HeightMap.terrainSubdivision.x, float(1) / u_HeightMap.terrainSubdivision.y);
+
+  float subdivision = 0;
+  for (uint edge = 0; edge < 4; edge++)
+  {
+    uint next = (edge + 1) % 4;
+    float distortion = heightDistortion(vertices[edge], vertices[next], uv[edge], uv[next], deltaUV);
+    subdivision = max(subdivision, floor(clamp(screenCovering(ndcPos[edge], ndcPos[next]), 0, 4) * distortion));
+  }
+
+  return subdivision;
+}
+
+float getNodeSubdivision(uvec2 node)
+{
+  vec2  origin;
+  float size;
+  getNodeSquare(node, origin, size);
+  return getSquareSubdivision(origin, size);
+}
@@ -0,0 +1,102 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Compute Shader deciding the action on every node of the current
+//  list (keep, split or merge of 4 siblings) from the subdivision
+//  criteria. Hysteresis on merge to avoid split/merge oscillations.
+//  Adjacent leaves differ by one level at most (2:1 balance) so that
+//  the edges of a leaf are stitched to a single coarser neighbour.
+//========================================================================
+
+layout(local_size_x = 64) in;
+
+// Split forbidden next to a coarser leaf (the children would be 2 levels finer)
+bool isSplitBalanced(uvec2 node)
+{
+  vec2  origin;
+  float size;
+  getNodeSquare(node, origin, size);
+
+  // A coarser neighbour covers the whole edge: the point across its middle is enough
+  vec2  center  = origin + 0.5 * size;
+  float epsilon = 0.5 / float(1u << u_Subdivision.maxLevel);
+  vec2  across[4] = { vec2(origin.x - epsilon, center.y), vec2(center.x, origin.y - epsilon), vec2(origin.x + size + epsilon, center.y), vec2(center.x, origin.y + size + epsilon) };
+
+  for (uint edge = 0; edge < 4; edge++)
+  {
+    if (isInsideTerrain(across[edge]) && findLeafLevel(across[edge]) < node.y)
+      return false;
+  }
+  return true;
+}
+
+// Merge forbidden next to a finer leaf or to a leaf of the same level about to split (the parent would be
+// 2 levels coarser). Evaluated on the parent square so that the 4 siblings take the same decision
+bool isMergeBalanced(uvec2 parent, uint level)
+{
+  vec2  origin;
+  float size;
+  getNodeSquare(parent, origin, size);
+
+  // One point across the middle of the outer edge of each sibling (2 per edge of the parent)
+  float epsilon = 0.5 / float(1u << u_Subdivision.maxLevel);
+  for (uint side = 0; side < 8; side++)
+  {
+    uint  edge = side / 2;
+    float t    = 0.25 * size * float(1 + 2 * (side & 1u));
+    vec2  point = (edge % 2 == 0) ? vec2(edge == 0 ? origin.x - epsilon : origin.x + size + epsilon, origin.y + t)
+                                  : vec2(origin.x + t, edge == 1 ? origin.y - epsilon : origin.y + size + epsilon);
+    if (!isInsideTerrain(point))
+      continue;
+
+    uvec2 leaf = findLeaf(point);
+    if (leaf.y > level || (leaf.y == level && level < u_Subdivision.maxLevel && getNodeSubdivision(leaf) > subdivisionGridSize))
+      return false;
+  }
+  return true;
+}
+
+
+void main(void)
+{
+  uint index      = gl_GlobalInvocationID.x;
+  uint nodeNumber = u_Subdivision.nodeNumber;
+  if (index >= nodeNumber)
+    return;
+
+  uint  base   = u_Subdivision.current * subdivisionNodeCapacity;
+  uvec2 node   = u_Subdivision.nodes[base + index];
+  uint  action = subdivisionKeep;
+
+  // Merge if the 4 siblings are leaves (consecutive in Z-order) and the parent is subdivided enough.
+  // Each sibling evaluates the same condition, the first one being replaced by the parent
+  if (node.y > 0)
+  {
+    uint rank  = getSiblingRank(node);
+    uint first = index - rank;
+    if (index >= rank && first + 3 < nodeNumber)
+    {
+      uvec2 parent = getParentNode(node);
+      bool  leaves = true;
+      for (uint sibling = 0; sibling < 4; sibling++)
+      {
+        uvec2 siblingNode = u_Subdivision.nodes[base + first + sibling];
+        leaves = leaves && siblingNode.y == node.y && getParentNode(siblingNode).x == parent.x;
+      }
+
+      if (leaves && getNodeSubdivision(parent) < 0.8 * subdivisionGridSize && isMergeBalanced(parent, node.y))
+        action = (rank == 0) ? subdivisionMerge : subdivisionRemove;
+    }
+  }
+
+  // Split if the grid of the node is not subdivided enough (as long as the node capacity is not reached)
+  if (action == subdivisionKeep && node.y < u_Subdivision.maxLevel && getNodeSubdivision(node) > subdivisionGridSize && isSplitBalanced(node))
+  {
+    if (atomicAdd(u_Subdivision.splitNumber, 3) + 3 + nodeNumber <= subdivisionNodeCapacity)
+      action = subdivisionSplit;
+  }
+
+  u_Subdivision.actions[index] = action;
+}
@@ -0,0 +1,53 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Compute Shader appending the visible leaves to the draw list with the
+//  levels of their 4 neighbours (left, bottom, right, top), read by the
+//  vertex shader to stitch the edges shared with coarser leaves.
+//========================================================================
+
+layout(local_size_x = 64) in;
+
+layout(binding = 0) uniform atomic_uint u_GeometryCounter1;
+layout(binding = 1) uniform atomic_uint u_GeometryCounter2;
+
+
+void main(void)
+{
+  uint index = gl_GlobalInvocationID.x;
+  if (index >= u_Subdivision.nodeNumber)
+    return;
+
+  uvec2 node = u_Subdivision.nodes[u_Subdivision.current * subdivisionNodeCapacity + index];
+  uint  triangleNb = 2 * subdivisionGridSize * subdivisionGridSize;
+
+  vec2  origin;
+  float size;
+  getNodeSquare(node, origin, size);
+
+  if (!isSquareVisible(origin, size))
+  {
+    atomicCounterAddARB(u_GeometryCounter2, triangleNb);
+    return;
+  }
+
+  // Leaf containing the point just across the middle of each edge (same level on the terrain border)
+  vec2  center  = origin + 0.5 * size;
+  float epsilon = 0.5 / float(1u << u_Subdivision.maxLevel);
+  vec2  across[4] = { vec2(origin.x - epsilon, center.y), vec2(center.x, origin.y - epsilon), vec2(origin.x + size + epsilon, center.y), vec2(center.x, origin.y + size + epsilon) };
+
+  uint neighbourLevels = 0;
+  for (uint edge = 0; edge < 4; edge++)
+  {
+    uint level = node.y;
+    if (isInsideTerrain(across[edge]))
+      level = findLeafLevel(across[edge]);
+    neighbourLevels |= level << (8 * edge);
+  }
+
+  uint slot = atomicAdd(u_Subdivision.draw[1], 1);
+  u_Subdivision.drawList[slot] = uvec4(node.x, node.y, neighbourLevels, 0);
+  atomicCounterAddARB(u_GeometryCounter1, triangleNb);
+}
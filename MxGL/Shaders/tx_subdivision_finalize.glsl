@@ -0,0 +1,31 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Compute Shader (single invocation) swapping the node lists and
+//  preparing the indirect commands of the culling pass and of the draw.
+//========================================================================
+
+layout(local_size_x = 1) in;
+
+
+void main(void)
+{
+  uint nodeNumber = u_Subdivision.nextNodeNumber;
+
+  u_Subdivision.current     = 1 - u_Subdivision.current;
+  u_Subdivision.nodeNumber  = nodeNumber;
+  u_Subdivision.splitNumber = 0;
+
+  u_Subdivision.dispatch[0] = (nodeNumber + 63) / 64;
+  u_Subdivision.dispatch[1] = 1;
+  u_Subdivision.dispatch[2] = 1;
+
+  // Leaf grid: 2 triangles per cell, instances counted by the culling pass
+  u_Subdivision.draw[0] = 6 * subdivisionGridSize * subdivisionGridSize;
+  u_Subdivision.draw[1] = 0;
+  u_Subdivision.draw[2] = 0;
+  u_Subdivision.draw[3] = 0;
+  u_Subdivision.draw[4] = 0;
+}
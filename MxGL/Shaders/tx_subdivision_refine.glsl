@@ -0,0 +1,35 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Compute Shader applying the actions to the current list and writing
+//  the resulting nodes into the other list (Z-order preserved since the
+//  children replace their parent and vice versa).
+//========================================================================
+
+layout(local_size_x = 64) in;
+
+
+void main(void)
+{
+  uint index = gl_GlobalInvocationID.x;
+  if (index >= u_Subdivision.nodeNumber)
+    return;
+
+  uint  base     = u_Subdivision.current * subdivisionNodeCapacity;
+  uint  nextBase = (1 - u_Subdivision.current) * subdivisionNodeCapacity;
+  uvec2 node     = u_Subdivision.nodes[base + index];
+  uint  action   = u_Subdivision.actions[index];
+  uint  offset   = nextBase + u_Subdivision.offsets[index];
+
+  if (action == subdivisionKeep)
+    u_Subdivision.nodes[offset] = node;
+  else if (action == subdivisionMerge)
+    u_Subdivision.nodes[offset] = getParentNode(node);
+  else if (action == subdivisionSplit)
+  {
+    for (uint rank = 0; rank < 4; rank++)
+      u_Subdivision.nodes[offset + rank] = getChildNode(node, rank);
+  }
+}
@@ -0,0 +1,53 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Compute Shader (single work group) computing the position in the new
+//  list of the node(s) resulting from every action: exclusive prefix
+//  sum of the node counts (sequential per invocation, then Hillis-Steele
+//  scan of the partial sums in shared memory).
+//========================================================================
+
+layout(local_size_x = 1024) in;
+
+shared uint s_Sums[1024];
+
+
+void main(void)
+{
+  uint nodeNumber = u_Subdivision.nodeNumber;
+  uint thread     = gl_LocalInvocationID.x;
+  uint range      = (nodeNumber + 1023) / 1024;
+  uint start      = min(thread * range, nodeNumber);
+  uint end        = min(start + range, nodeNumber);
+
+  uint sum = 0;
+  for (uint index = start; index < end; index++)
+    sum += getSubdivisionNodeCount(u_Subdivision.actions[index]);
+
+  s_Sums[thread] = sum;
+  memoryBarrierShared();
+  barrier();
+
+  // Inclusive scan of the partial sums
+  for (uint step = 1; step < 1024; step <<= 1)
+  {
+    uint value = (thread >= step) ? s_Sums[thread - step] : 0;
+    memoryBarrierShared();
+    barrier();
+    s_Sums[thread] += value;
+    memoryBarrierShared();
+    barrier();
+  }
+
+  uint offset = s_Sums[thread] - sum;
+  for (uint index = start; index < end; index++)
+  {
+    u_Subdivision.offsets[index] = offset;
+    offset += getSubdivisionNodeCount(u_Subdivision.actions[index]);
+  }
+
+  if (thread == 1023)
+    u_Subdivision.nextNodeNumber = s_Sums[thread];
+}
@@ -0,0 +1,66 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Vertex Shader of the terrain subdivided on GPU: one instance of the
+//  leaf grid per visible node of the draw list. Vertices on an edge
+//  shared with a coarser leaf are moved onto the coarser edge to avoid
+//  cracks (the classification keeps adjacent leaves within one level).
+//========================================================================
+
+// Vertex (i,j) of the leaf grid, 0 <= i,j <= subdivisionGridSize
+in vec4 i_VertexPos;
+
+out GSO
+{
+  vec4  VertexColor;
+  float Height;
+  float ScreenHeightGradient;
+} vso;
+
+
+void main(void)
+{
+  uvec4 item  = u_Subdivision.drawList[gl_InstanceID];
+  uint  level = item.y;
+
+  vec2  origin;
+  float size;
+  getNodeSquare(item.xy, origin, size);
+
+  ivec2 vertex    = ivec2(i_VertexPos.xy);
+  vec2  gridPoint = origin + size * vec2(vertex) / subdivisionGridSize;
+  vec2  uv        = getGridHeightTextureUV(gridPoint);
+  float height    = getHeight(uv);
+
+  bool onEdge[4] = { vertex.x == 0, vertex.y == 0, vertex.x == subdivisionGridSize, vertex.y == subdivisionGridSize };
+  for (uint edge = 0; edge < 4; edge++)
+  {
+    uint neighbourLevel = (item.z >> (8 * edge)) & 0xFFu;
+    if (onEdge[edge] && neighbourLevel < level)
+    {
+      // Linear interpolation between the vertices of the coarser grid surrounding the vertex (along the edge)
+      uint  axis    = 1 - edge % 2;
+      float spacing = 1.0 / (float(1u << neighbourLevel) * subdivisionGridSize);
+      float t0      = floor(gridPoint[axis] / spacing) * spacing;
+      if (t0 != gridPoint[axis])
+      {
+        vec2 point0 = gridPoint;
+        vec2 point1 = gridPoint;
+        point0[axis] = t0;
+        point1[axis] = t0 + spacing;
+        height = mix(getHeight(getGridHeightTextureUV(point0)), getHeight(getGridHeightTextureUV(point1)), (gridPoint[axis] - t0) / spacing);
+        break;
+      }
+    }
+  }
+
+  vec4 worldPoint = getGridWorldPoint(gridPoint, height);
+  vec4 viewPoint  = u_Viewing.view * worldPoint;
+  gl_Position     = u_Viewing.projection * viewPoint;
+
+  vso.VertexColor          = getShadedColor(worldPoint, viewPoint, uv, vec4(1.0));
+  vso.Height               = height;
+  vso.ScreenHeightGradient = getScreenHeightGradient(worldPoint, uv);
+}
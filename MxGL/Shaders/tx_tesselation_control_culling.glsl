@@ -0,0 +1,81 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Tesselation Control Shader of the pipeline without geometry shader:
+//  patches out of the viewing frustum are discarded (null tesselation
+//  levels) and the triangles generated for the others are counted.
+//========================================================================
+
+// Normalized uv coordinates within the patch (output of vertex shader)
+in VSO
+{
+  vec2 HeightTextureUV; 
+  vec4 VertexColor;
+  float HeightLod;
+} tcsi[];
+
+layout(binding = 0) uniform atomic_uint u_GeometryCounter1;
+layout(binding = 1) uniform atomic_uint u_GeometryCounter2;
+
+// Quad patch
+layout(vertices = 4) out;
+
+out VSO
+{
+  vec2 HeightTextureUV;
+  vec4 VertexColor;
+  float HeightLod;
+} tcso[];
+
+
+// Patch bounding box (from zero to the max height) intersecting the viewing frustum
+bool isPatchVisible()
+{
+  vec2 points[4] = { gl_in[0].gl_Position.xy, gl_in[1].gl_Position.xy, gl_in[2].gl_Position.xy, gl_in[3].gl_Position.xy };
+  return isBoxVisible(u_Viewing.projection * u_Viewing.view, points);
+}
+
+// Number of triangles generated from the tesselation levels (quads, equal spacing)
+uint getTriangleNumber()
+{
+  uint outer = uint(gl_TessLevelOuter[0] + gl_TessLevelOuter[1] + gl_TessLevelOuter[2] + gl_TessLevelOuter[3]);
+  int  inner0 = int(ceil(gl_TessLevelInner[0]));
+  int  inner1 = int(ceil(gl_TessLevelInner[1]));
+  if (outer == 4 && inner0 <= 1 && inner1 <= 1)
+    return 2;
+
+  // Inner grid of (inner0-2)x(inner1-2) quads and the ring joining it to the outer edges
+  inner0 = max(inner0, 2) - 2;
+  inner1 = max(inner1, 2) - 2;
+  return uint(2*inner0*inner1 + 2*inner0 + 2*inner1) + outer;
+}
+
+void main(void)
+{
+  if (gl_InvocationID == 0)
+  {
+    if (isPatchVisible())
+    {
+      vec4 positions[4] = { gl_in[0].gl_Position, gl_in[1].gl_Position, gl_in[2].gl_Position, gl_in[3].gl_Position };
+      vec2 uvs[4]       = { tcsi[0].HeightTextureUV, tcsi[1].HeightTextureUV, tcsi[2].HeightTextureUV, tcsi[3].HeightTextureUV };
+      computeTesselationLevels(positions, uvs);
+      atomicCounterAddARB(u_GeometryCounter1, getTriangleNumber());
+    }
+    else
+    {
+      // Null outer levels: the patch is discarded by the primitive generator
+      gl_TessLevelOuter[0] = gl_TessLevelOuter[1] = gl_TessLevelOuter[2] = gl_TessLevelOuter[3] = 0;
+      gl_TessLevelInner[0] = gl_TessLevelInner[1] = 0;
+      atomicCounterAddARB(u_GeometryCounter2, 2);
+    }
+  }
+
+  // Passes inchanged vertex's position
+  gl_out[gl_InvocationID].gl_Position   = gl_in[gl_InvocationID].gl_Position;
+
+  tcso[gl_InvocationID].HeightTextureUV = tcsi[gl_InvocationID].HeightTextureUV; 
+  tcso[gl_InvocationID].VertexColor     = tcsi[gl_InvocationID].VertexColor;
+  tcso[gl_InvocationID].HeightLod       = tcsi[gl_InvocationID].HeightLod;
+}
@@ -0,0 +1,61 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Tesselation Evaluation Shader of the pipeline without geometry
+//  shader: vertices are projected and lit (see tx_shading.glsl) here,
+//  back faces being culled by the fixed pipeline.
+//========================================================================
+
+// Same subdivisions as tx_tesselation_evaluation.glsl (counterclockwise ordering)
+layout(quads, equal_spacing) in;
+
+in VSO
+{
+  vec2 HeightTextureUV;
+  vec4 VertexColor;
+  float HeightLod;
+} tesi[];
+
+out GSO
+{
+  vec4  VertexColor;
+  float Height;
+  float ScreenHeightGradient;
+} teso;
+
+
+void main()
+{
+  // Interpolation of the 4 vertices from parameters given by tessaltion engine
+  float alpha = gl_TessCoord.x;
+  float beta  = gl_TessCoord.y;
+
+  vec4 iv1 = mix(gl_in[0].gl_Position, gl_in[1].gl_Position, alpha);
+  vec4 iv2 = mix(gl_in[3].gl_Position, gl_in[2].gl_Position, alpha);
+  vec4 interpolatedVertex = mix(iv1, iv2, beta);
+
+  vec2 iuv1 = mix(tesi[0].HeightTextureUV, tesi[1].HeightTextureUV, alpha);
+  vec2 iuv2 = mix(tesi[3].HeightTextureUV, tesi[2].HeightTextureUV, alpha);
+  vec2 heightTextureUV = mix(iuv1, iuv2, beta);
+
+  vec4 ic1 = mix(tesi[0].VertexColor, tesi[1].VertexColor, alpha);
+  vec4 ic2 = mix(tesi[3].VertexColor, tesi[2].VertexColor, alpha);
+  vec4 vertexColor = mix(ic1, ic2, beta);
+
+  // Mip level interpolated from the patch vertices (only depends on the edge ends along the patch borders)
+  float lod1 = mix(tesi[0].HeightLod, tesi[1].HeightLod, alpha);
+  float lod2 = mix(tesi[3].HeightLod, tesi[2].HeightLod, alpha);
+
+  float height = getHeight(heightTextureUV, mix(lod1, lod2, beta));
+  interpolatedVertex.z = height;
+
+  // Point set in clipping space (projection)
+  vec4 viewPoint = u_Viewing.view * interpolatedVertex;
+  gl_Position = u_Viewing.projection * viewPoint;
+
+  teso.VertexColor          = getShadedColor(interpolatedVertex, viewPoint, heightTextureUV, vertexColor);
+  teso.Height               = height;
+  teso.ScreenHeightGradient = getScreenHeightGradient(interpolatedVertex, heightTextureUV);
+}
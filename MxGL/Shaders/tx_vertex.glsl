@@ -1,29 +1,41 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-//  Vertex Shader for terrain surface representation.
-//========================================================================
-
-// 3D coord of the unitary patch vertex 
-in vec4 i_VertexPos;
-// Associated position (u,v) on the height map of the vertex 
-in vec2 i_HeightTextureUV;
-// Base color of the vertex (used mainly for debug)
-in vec4 i_VertexColor;
-
-out VSO
-{
-  vec2 HeightTextureUV;
-  vec4 VertexColor;
-} vso;
-
-
-void main(void)
-{
-  // Data passed to tesselation control shader (TCS)
-  gl_Position         = u_Positionning.model * i_VertexPos;
-  vso.HeightTextureUV = i_HeightTextureUV;
-  vso.VertexColor     = i_VertexColor;
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Vertex Shader for terrain surface representation.
+//    Attributeless: the index of the patch vertex is its rank in the
+//    grid of the terrain subdivision (i*(ny+1)+j), from which position
+//    and height map coordinates are derived, as well as the mip level of
+//    the height map used by the TES.
+//========================================================================
+
+out VSO
+{
+  vec2 HeightTextureUV;
+  vec4 VertexColor;
+  float HeightLod;
+} vso;
+
+
+void main(void)
+{
+  // Grid indices (i,j) of the vertex
+  int  rowSize = u_HeightMap.terrainSubdivision.y + 1;
+  vec2 gridPoint = vec2(gl_VertexID / rowSize, gl_VertexID % rowSize);
+
+  // Associated position (u,v) on the height map
+  vec2 uv = vec2(gridPoint.x / u_HeightMap.terrainSubdivision.x, 1 - gridPoint.y / u_HeightMap.terrainSubdivision.y);
+
+  // Data passed to tesselation control shader (TCS), base color white (used mainly for debug)
+  gl_Position         = u_Positionning.model * vec4(gridPoint, getHeight(uv), 1);
+  vso.HeightTextureUV = uv;
+  vso.VertexColor     = vec4(1, 1, 1, 1);
+
+  // Mip level of the height map such as a texel covers about a pixel at the vertex depth (same value for all the
+  // patches sharing the vertex, interpolated by the TES to keep the shared edges crack-free)
+  vec4  viewPoint = u_Viewing.view * gl_Position;
+  float texelSize = min(u_HeightMap.terrainDimension.x / (mapSize.x - 1), u_HeightMap.terrainDimension.y / (mapSize.y - 1));
+  float pixelSize = 2 * -viewPoint.z / (u_Viewing.projection[1][1] * u_Viewing.viewport.y);
+  vso.HeightLod   = clamp(log2(max(pixelSize / texelSize, 1)), 0, float(getMapLevelNb() - 1));
+}
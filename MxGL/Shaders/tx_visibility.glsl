@@ -0,0 +1,27 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Visibility test shared by the tesselation pipeline (patch culling)
+//  and the GPU subdivision (node culling).
+//========================================================================
+
+// Box standing on the quad of ground points (from zero to the max height)
+// intersecting the viewing frustum, transform mapping the points to clip space
+bool isBoxVisible(mat4 transform, vec2 points[4])
+{
+  float maxHeight = max(u_HeightMap.heightFactor, u_HeightMap.functional / 16);
+
+  // Out of the frustum if every corner of the box is outside the same clipping plane
+  uvec3 outsideLow  = uvec3(0);
+  uvec3 outsideHigh = uvec3(0);
+  for (uint corner = 0; corner < 8; corner++)
+  {
+    vec4 point = transform * vec4(points[corner & 3u], maxHeight * float(corner >> 2), 1);
+    outsideLow  += uvec3(lessThan(point.xyz, vec3(-point.w)));
+    outsideHigh += uvec3(greaterThan(point.xyz, vec3(point.w)));
+  }
+
+  return all(lessThan(outsideLow, uvec3(8))) && all(lessThan(outsideHigh, uvec3(8)));
+}
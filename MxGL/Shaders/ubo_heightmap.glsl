@@ -1,31 +1,61 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-//  Uniform Buffer Oject definition for Height Map.
-//========================================================================
-
-layout(std140) uniform u_HeightMapBlock
-{
-  sampler2D heightTexture;            // Bindless texture, RGB with same value on each component
-  vec2      terrainDimension;         // Dimension (WC) of the patch
-  ivec2     terrainSubdivision;       // Number of patches in each direction
-  float     heightFactor;             // Scale factor along altitude (z axis)
-  float     distortionFactor;         // Factor applied to patch height distortion to determine the subdivision level
-  float     maxSubdivison;            // Max number of subdivision of each side of patch (tesselation process)
-  float     maxPixelSubdivisionRatio; // Subdivision factor based on edge dimension on screen
-  sampler2D heightColorMap;           // Bindless texture, RGB with map along u and constant along v 
-  float     minHeightColorMap;        // Height corresponding to heightColorMap(u=0.0)
-  float     maxHeightColorMap;        // Height corresponding to heightColorMap(u=1.0)
-  uint      colorMode;                // Heigt color map
-  float     isolineStep;              // Isoline mode: for points with height (window 2D pixel thickness)
-  uint      wireframe;                // Display patch and triangle borders and normals
-  float     functional;               // Functional height (replace height map with calibration function f(u,v)=u(1-u)*v(1-v))
-  uint      smoothInterpolation;      // Level of interpolation (Linear/Constant,Linear,Bicubic) for height and normal
-  uint      shadow;                   // Shadow mode, alternate method to shadow mapping, unsatisfactory
-  float     minHeight;                // Minimal absolute value for height (for animation)
-  float     maxHeight;                // Maximal absolute value for height (for animation)
-} u_HeightMap;
-
-
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+//  Uniform Buffer Oject definition for Height Map.
+//========================================================================
+
+layout(std140) uniform u_HeightMapBlock
+{
+  sampler2D heightTexture;            // Bindless texture, single channel (R8, R16, R16F or R32F)
+  vec2      terrainDimension;         // Dimension (WC) of the patch
+  ivec2     terrainSubdivision;       // Number of patches in each direction
+  float     heightFactor;             // Scale factor along altitude (z axis)
+  float     distortionFactor;         // Factor applied to patch height distortion to determine the subdivision level
+  float     maxSubdivison;            // Max number of subdivision of each side of patch (tesselation process)
+  float     maxPixelSubdivisionRatio; // Subdivision factor based on edge dimension on screen
+  sampler2D heightColorMap;           // Bindless texture, RGB with map along u and constant along v 
+  float     minHeightColorMap;        // Height corresponding to heightColorMap(u=0.0)
+  float     maxHeightColorMap;        // Height corresponding to heightColorMap(u=1.0)
+  uint      colorMode;                // Heigt color map
+  float     isolineStep;              // Isoline mode: for points with height (window 2D pixel thickness)
+  uint      wireframe;                // Display patch and triangle borders and normals
+  float     functional;               // Functional height (replace height map with calibration function f(u,v)=u(1-u)*v(1-v))
+  uint      smoothInterpolation;      // Level of interpolation (Linear/Constant,Linear,Bicubic) for height and normal
+  uint      shadow;                   // Shadow mode, alternate method to shadow mapping, unsatisfactory
+  float     minHeight;                // Minimal absolute value for height (for animation)
+  float     maxHeight;                // Maximal absolute value for height (for animation)
+  float     heightScale;              // Remapping of the texture values to [0,1] (elevations of the float formats)
+  float     heightOffset;
+  sampler2DArray tileTexture;         // Streaming: resident tiles of the height map (see MxTileCache)
+  usampler2D tileTable;               // Streaming: indirection table, layer and level of the tile or of its resident ancestor
+  ivec2     mapSize;                  // Streaming: size of the whole height map (finest level)
+  uint      levelNb;                  // Streaming: number of mip levels
+  uint      tileSize;                 // Streaming: texels of a tile without its borders
+  uint      streaming;                // Height map streamed by tiles (heightTexture not used)
+  uvec2     heightLevels[16];         // Bindless views of the mip levels 1.. (base level only, gathered by level), see MxTerrain::_HeightLevelMaxNb
+} u_HeightMap;
+
+
+
+// Render modes: constants when defined by the program variant (specialized shaders, see MxTerrain::getVariantDefines),
+// read from the uniform block otherwise
+#ifndef HM_SMOOTH_INTERPOLATION
+#define HM_SMOOTH_INTERPOLATION u_HeightMap.smoothInterpolation
+#endif
+#ifndef HM_FUNCTIONAL
+#define HM_FUNCTIONAL (u_HeightMap.functional != 0)
+#endif
+#ifndef HM_COLOR_MODE
+#define HM_COLOR_MODE u_HeightMap.colorMode
+#endif
+#ifndef HM_ISOLINES
+#define HM_ISOLINES (u_HeightMap.isolineStep > 0)
+#endif
+#ifndef HM_STREAMING
+#define HM_STREAMING (u_HeightMap.streaming != 0)
+#endif
+#ifndef HM_SHADOW
+#define HM_SHADOW (u_HeightMap.shadow > 0)
+#endif
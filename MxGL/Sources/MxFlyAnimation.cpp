@@ -1,104 +1,132 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "MxFlyAnimation.h"
-#include "MxScene.h"
-#include "UxUtils.h"
-
-#include <iomanip>
-
-
-MxFlyAnimation::MxFlyAnimation(float iLength, float iSpeed): MxAnimation(3000,3000)
-{
-  _StartPosition = Vector3f(-50.0f, 400.0f, 80.0f);
-  _StartDir      = Vector3f(1.0f, 0.f, 0.0f);
-  _StartDir.normalize();
-
-  _Length = iLength;
-  _Speed  = iSpeed;
-}
-
-std::string MxFlyAnimation::getStage() const
-{
-  if (_StartTime == 0)
-    return "Not yet started";
-
-  uint32_t swidth = std::to_string((int)_Length).length();
-  std::stringstream ss;
-  ss << std::setw(swidth) << (int)(_Step*_Length+0.5) << "/" << std::setw(swidth) << (int)_Length;
-  return ss.str();
-}
-
-void MxFlyAnimation::init(int iTime)
-{
-  _Position  = _StartPosition;
-  _Dir       = _StartDir;
-
-  MxAnimation::init(iTime);
-}
-
-void MxFlyAnimation::upadeStage(int iTime)
-{
-  float k = 0.001f * _Speed / _Length;
-
-  MxAnimation::upadeStage(iTime, k * (iTime - _StartTime), k * (iTime - _LastTime));
-}
-
-void MxFlyAnimation::execute(MxScene* iScene, int iTime, uint64_t iFrame)
-{
-  if (!isFrozen(iTime))
-    upadeStage(iTime);
-
-  float step1 = 0.1f;
-  float step2 = 0.4f;
-  float step3 = 0.7f;
-
-  // Smooth function 3t2-2t3 inside [0,1]
-  float steps[] = { 0.0f, 0.1f, 0.35f, 0.6f, 0.7f, 1.0f };
-  float values[] = { 0.0f, 0.0f, 20.0f, -20.0f, 0.0f, 0.0f };
-  auto smoothTransition = [&steps, &values, this](float t) { uint32_t index = 0; while (steps[index+1] < _Step) index++; float u = (t - steps[index]) / (steps[index+1] - steps[index]); float u2 = u*u; return values[index] + (values[index+1] - values[index])*u2*(3 - 2 * u); };
-   
-  float pitch  = smoothTransition(_Step) *(float)M_PI / 180.0f;
-  float dPitch = pitch - smoothTransition(_Step - _DeltaStep) *(float)M_PI / 180.0f;
-  
-  _Dir = UxUtils::rotateVector(_Dir, _Dir.crossProduct(Vector3f(0.0f, 0.0f, 1.0f)), dPitch);
-
-  Vector3d up;
-  if (_Step <= step1)
-  {
-    _Position = _StartPosition + _Dir * _Step * _Length;
-    up = Vector3f(.0f, .0f, -1.f).crossProduct(_Dir).crossProduct(_Dir);
-  }
-  else if (_Step <= step3)
-  {
-    bool first = _Step < step2;
-
-    float subStep   = first ? (_Step - step1)/(step2-step1) :(step3 - _Step) / (step3 - step2);
-    float curvature = subStep * 0.0002f;
-    
-    float dPhi = _Length*_DeltaStep*curvature;
-    float s = sinf(dPhi);
-    float c = cosf(dPhi);
-
-    Vector3f centerDir = _Dir.crossProduct(Vector3f(0.0f, 0.0f, 1.0f));
-    _Position += _Dir * (s / curvature) + centerDir * ((1.0f-c) / curvature);
-    _Dir = Vector3f(c*_Dir[0] + s*centerDir[0], c*_Dir[1] + s*centerDir[1], _Dir[2]);
-    _Dir.normalize();
-
-    float roll = subStep*15.0f*(float)M_PI / 180.0f;
-    up = UxUtils::rotateVector(Vector3f(0.0f, 0.0f, 1.0f), _Dir, roll);
-  }
-  else if (_Step < 1.0f)
-  {
-    _Position += _Dir * _DeltaStep * _Length;
-    up = Vector3f(.0f, .0f, -1.f).crossProduct(_Dir).crossProduct(_Dir);
-  } 
-  
-  // Updating scene's view matrix according camera position (camera slightly bent)
-  Vector3f camDir = Vector3f(_Dir[0], _Dir[1], -0.15f);
-  camDir.normalize();
-  iScene->setViewMatrix(Matrix4f::createLookAt(_Position, _Position + camDir, up));
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "MxFlyAnimation.h"
+#include "MxScene.h"
+#include "UxUtils.h"
+#include "UxFrameArena.h"
+
+#include <cstdio>
+#include <algorithm>
+
+
+MxFlyAnimation::MxFlyAnimation(float iLength, float iSpeed): MxAnimation(3000,3000)
+{
+  _StartPosition = Vector3f(-50.0f, 400.0f, 80.0f);
+  _StartDir      = Vector3f(1.0f, 0.f, 0.0f);
+  _StartDir.normalize();
+
+  _Length = iLength;
+  _Speed  = iSpeed;
+}
+
+const char* MxFlyAnimation::getStage() const
+{
+  if (_StartTime == 0)
+    return "Not yet started";
+
+  int swidth = snprintf(nullptr, 0, "%d", (int)_Length);
+  return UxFrameArena::format("%*d/%*d", swidth, (int)(_Step*_Length+0.5), swidth, (int)_Length);
+}
+
+void MxFlyAnimation::init(int iTime)
+{
+  _Position  = _StartPosition;
+  _Dir       = _StartDir;
+
+  MxAnimation::init(iTime);
+}
+
+void MxFlyAnimation::upadeStage(int iTime)
+{
+  float k = 0.001f * _Speed / _Length;
+
+  MxAnimation::upadeStage(iTime, k * (iTime - _StartTime), k * (iTime - _LastTime));
+}
+
+void MxFlyAnimation::execute(MxScene* iScene, int iTime, uint64_t iFrame)
+{
+  if (!isFrozen(iTime))
+    upadeStage(iTime);
+
+  Vector3d up;
+  advance(_Step, _DeltaStep, _Position, _Dir, up);
+  
+  // Updating scene's view matrix according camera position (camera slightly bent)
+  Vector3f camDir = Vector3f(_Dir[0], _Dir[1], -0.15f);
+  camDir.normalize();
+  iScene->setViewMatrix(Matrix4f::createLookAt(_Position, _Position + camDir, up));
+}
+
+bool MxFlyAnimation::predictView(int iTime, Vector3f& oEyeView, Vector3f& oEyeDirection) const
+{
+  if (!_Enabled || _StartTime == 0 || _Completed)
+    return false;
+
+  // Step reached at iTime (pauses excluded), the path being integrated by sub-steps from the current state
+  const uint32_t subStepNb = 16;
+  float k    = 0.001f * _Speed / _Length;
+  float step = std::min(_Step + k * std::max(iTime - std::max(_LastTime, _FrozenUntil), 0), 1.0f);
+  float dt   = (step - _Step) / subStepNb;
+
+  Vector3f position = _Position;
+  Vector3f dir      = _Dir;
+  Vector3d up;
+  for (uint32_t subStep = 1; subStep <= subStepNb && dt > 0.0f; subStep++)
+    advance(_Step + subStep*dt, dt, position, dir, up);
+
+  oEyeView      = position;
+  oEyeDirection = Vector3f(dir[0], dir[1], -0.15f);
+  oEyeDirection.normalize();
+  return true;
+}
+
+void MxFlyAnimation::advance(float iStep, float iDeltaStep, Vector3f& ioPosition, Vector3f& ioDir, Vector3d& oUp) const
+{
+  float step1 = 0.1f;
+  float step2 = 0.4f;
+  float step3 = 0.7f;
+
+  // Smooth function 3t2-2t3 inside [0,1]
+  float steps[] = { 0.0f, 0.1f, 0.35f, 0.6f, 0.7f, 1.0f };
+  float values[] = { 0.0f, 0.0f, 20.0f, -20.0f, 0.0f, 0.0f };
+  auto smoothTransition = [&steps, &values, iStep](float t) { uint32_t index = 0; while (steps[index+1] < iStep) index++; float u = (t - steps[index]) / (steps[index+1] - steps[index]); float u2 = u*u; return values[index] + (values[index+1] - values[index])*u2*(3 - 2 * u); };
+   
+  float pitch  = smoothTransition(iStep) *(float)M_PI / 180.0f;
+  float dPitch = pitch - smoothTransition(iStep - iDeltaStep) *(float)M_PI / 180.0f;
+  
+  ioDir = UxUtils::rotateVector(ioDir, ioDir.crossProduct(Vector3f(0.0f, 0.0f, 1.0f)), dPitch);
+
+  if (iStep <= step1)
+  {
+    ioPosition = _StartPosition + ioDir * iStep * _Length;
+    oUp = Vector3f(.0f, .0f, -1.f).crossProduct(ioDir).crossProduct(ioDir);
+  }
+  else if (iStep <= step3)
+  {
+    bool first = iStep < step2;
+
+    float subStep   = first ? (iStep - step1)/(step2-step1) :(step3 - iStep) / (step3 - step2);
+    float curvature = subStep * 0.0002f;
+    
+    float dPhi = _Length*iDeltaStep*curvature;
+    float s = sinf(dPhi);
+    float c = cosf(dPhi);
+
+    Vector3f centerDir = ioDir.crossProduct(Vector3f(0.0f, 0.0f, 1.0f));
+    ioPosition += ioDir * (s / curvature) + centerDir * ((1.0f-c) / curvature);
+    ioDir = Vector3f(c*ioDir[0] + s*centerDir[0], c*ioDir[1] + s*centerDir[1], ioDir[2]);
+    ioDir.normalize();
+
+    float roll = subStep*15.0f*(float)M_PI / 180.0f;
+    oUp = UxUtils::rotateVector(Vector3f(0.0f, 0.0f, 1.0f), ioDir, roll);
+  }
+  else if (iStep < 1.0f)
+  {
+    ioPosition += ioDir * iDeltaStep * _Length;
+    oUp = Vector3f(.0f, .0f, -1.f).crossProduct(ioDir).crossProduct(ioDir);
+  } 
+}
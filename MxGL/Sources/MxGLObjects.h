@@ -1,16 +1,16 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include "UxGLObjects.h"
-
-class MxGLObjects: public UxGLObjects
-{
-public:
-  static void init();
-  static void createInputAttributes();
-};
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGLObjects.h"
+
+class MxGLObjects: public UxGLObjects
+{
+public:
+  static void init();
+  static void createInputAttributes();
+};
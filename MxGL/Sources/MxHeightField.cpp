@@ -0,0 +1,94 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "MxHeightField.h"
+
+#include <cassert>
+#include <cstring>
+
+MxHeightField::MxHeightField()
+{
+  _Type     = GL_UNSIGNED_BYTE;
+  _TypeSize = 1;
+  _Layout   = Morton;
+  _Width    = 0;
+  _Height   = 0;
+  _TileNbX  = 0;
+  _Scale    = 1.0f;
+  _Offset   = 0.0f;
+  _Data     = nullptr;
+  _DataSize = 0;
+}
+
+void MxHeightField::init(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout, float iScale, float iOffset)
+{
+  _Samples.assign(setFormat(iWidth, iHeight, iType, iLayout, iScale, iOffset), 0);
+  _Data     = _Samples.data();
+  _DataSize = _Samples.size();
+}
+
+void MxHeightField::init(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout, float iScale, float iOffset, const void* iExternalSamples)
+{
+  assert(iExternalSamples);
+
+  _Samples.clear();
+  _Samples.shrink_to_fit();
+  _DataSize = setFormat(iWidth, iHeight, iType, iLayout, iScale, iOffset);
+  _Data     = reinterpret_cast<const uint8_t*>(iExternalSamples);
+}
+
+size_t MxHeightField::setFormat(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout, float iScale, float iOffset)
+{
+  assert(iWidth > 0 && iHeight > 0);
+
+  _Type     = iType;
+  _TypeSize = UxUtils::getTypeSize(iType);
+  _Layout   = iLayout;
+  _Width    = iWidth;
+  _Height   = iHeight;
+  _TileNbX  = (iWidth + TileSize - 1) / TileSize;
+  _Scale    = iScale;
+  _Offset   = iOffset;
+
+  return computeDataSize(iWidth, iHeight, iType, iLayout);
+}
+
+size_t MxHeightField::computeDataSize(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout)
+{
+  // Tiled layouts padded to whole tiles (padding samples never read)
+  size_t tileNbX  = (iWidth + TileSize - 1) / TileSize;
+  size_t sampleNb = iLayout == Linear ? (size_t)iWidth*iHeight : tileNbX*((iHeight + TileSize - 1) / TileSize)*TileSize*TileSize;
+  return sampleNb*UxUtils::getTypeSize(iType);
+}
+
+void MxHeightField::setSamples(const void* iRowMajorSamples)
+{
+  assert(!_Samples.empty() && _Data == _Samples.data());
+
+  const uint8_t* source = reinterpret_cast<const uint8_t*>(iRowMajorSamples);
+  if (_Layout == Linear)
+  {
+    memcpy(_Samples.data(), source, (size_t)_Width*_Height*_TypeSize);
+    return;
+  }
+
+  for (uint32_t y = 0; y < _Height; y++)
+  {
+    for (uint32_t x = 0; x < _Width; x++)
+      memcpy(_Samples.data() + (size_t)getIndex(x, y)*_TypeSize, source + ((size_t)y*_Width + x)*_TypeSize, _TypeSize);
+  }
+}
+
+void MxHeightField::clear()
+{
+  _Samples.clear();
+  _Samples.shrink_to_fit();
+  _Data     = nullptr;
+  _DataSize = 0;
+  _Width    = 0;
+  _Height   = 0;
+  _TileNbX  = 0;
+}
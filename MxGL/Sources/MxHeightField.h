@@ -0,0 +1,114 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "UxUtils.h"
+
+#include <stdint.h>
+#include <vector>
+#include <gl/glew.h>
+
+//========================================================================
+//  Height Field:
+//    CPU copy of the height map (single channel on 8, 16 or 32 bits, as
+//    stored by the texture), heights decoded to [0,1] as the shaders read
+//    them (normalized value or elevation remapped by scale/offset).
+//    Samples are grouped by tiles of 8x8 (row-major or Z-order inside the
+//    tile) so that a 4x4 neighbourhood spans one or two cache lines
+//    instead of 4 rows of the map. The samples may also be read in place
+//    from memory kept by the caller (ie a mapped terrain asset).
+//========================================================================
+
+class MxHeightField
+{
+public:
+  enum Layout
+  {
+    Linear,   // Row after row (layout of the texture)
+    Tiled,    // Tiles of TileSize x TileSize row-major, row-major inside the tile
+    Morton    // Tiles row-major, Z-order inside the tile
+  };
+
+  static const uint32_t TileSize = 8;
+
+private:
+  std::vector<uint8_t>  _Samples;
+  const uint8_t*        _Data;          // Samples read: owned vector or external memory
+  size_t                _DataSize;
+  GLenum                _Type;          // GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_HALF_FLOAT or GL_FLOAT
+  uint32_t              _TypeSize;
+  Layout                _Layout;
+  uint32_t              _Width;
+  uint32_t              _Height;
+  uint32_t              _TileNbX;       // Tiles per row (width padded to a multiple of TileSize)
+  float                 _Scale;         // Elevation remapping of the float formats (1 and 0 for the normalized ones)
+  float                 _Offset;
+
+public:
+  MxHeightField();
+  __DeclareDeletedRefCtorsAndAssignments(MxHeightField)
+
+  // Storage of iWidth x iHeight samples of type iType (zeroed until setSamples)
+  void init(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout, float iScale, float iOffset);
+  // Samples already in the layout of the field (getData of a field of same format), read in place: the memory must
+  // stay valid until the field is cleared
+  void init(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout, float iScale, float iOffset, const void* iExternalSamples);
+  // Copies row-major samples of the field type (ie the texture content) into the layout of the field
+  void setSamples(const void* iRowMajorSamples);
+  void clear();
+
+  // Height of the sample (iX, iY) decoded to [0,1]
+  float getValue(uint32_t iX, uint32_t iY) const { return decode(getIndex(iX, iY)); }
+
+  bool     isEmpty() const { return _Data == nullptr; }
+  uint32_t getWidth() const { return _Width; }
+  uint32_t getHeight() const { return _Height; }
+  GLenum   getType() const { return _Type; }
+  Layout   getLayout() const { return _Layout; }
+  size_t   getMemorySize() const { return _Samples.size(); }   // Owned memory (0 for external samples)
+  float    getScale() const { return _Scale; }
+  float    getOffset() const { return _Offset; }
+
+  // Samples in the layout of the field (padded to whole tiles for the tiled layouts)
+  const uint8_t* getData() const { return _Data; }
+  size_t         getDataSize() const { return _DataSize; }
+  // Size of the samples of a field of this format
+  static size_t  computeDataSize(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout);
+
+private:
+  // Dimensions and format set, size of the samples returned
+  size_t   setFormat(uint32_t iWidth, uint32_t iHeight, GLenum iType, Layout iLayout, float iScale, float iOffset);
+  uint32_t getIndex(uint32_t iX, uint32_t iY) const;
+  float    decode(uint32_t iIndex) const;
+};
+
+inline uint32_t MxHeightField::getIndex(uint32_t iX, uint32_t iY) const
+{
+  if (_Layout == Linear)
+    return iY*_Width + iX;
+
+  uint32_t tile   = (iY / TileSize)*_TileNbX + iX / TileSize;
+  uint32_t inside = _Layout == Tiled ? (iY % TileSize)*TileSize + iX % TileSize : UxUtils::mortonCode(iX % TileSize, iY % TileSize);
+  return tile*TileSize*TileSize + inside;
+}
+
+inline float MxHeightField::decode(uint32_t iIndex) const
+{
+  const uint8_t* sample = _Data + iIndex*_TypeSize;
+
+  float value;
+  if (_Type == GL_UNSIGNED_BYTE)
+    value = *sample / 255.0f;
+  else if (_Type == GL_UNSIGNED_SHORT)
+    value = *reinterpret_cast<const uint16_t*>(sample) / 65535.0f;
+  else if (_Type == GL_HALF_FLOAT)
+    value = UxUtils::halfToFloat(*reinterpret_cast<const uint16_t*>(sample));
+  else
+    value = *reinterpret_cast<const float*>(sample);
+  return value*_Scale + _Offset;
+}
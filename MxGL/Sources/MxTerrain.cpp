@@ -1,367 +1,1031 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "MxTerrain.h"
-#include "MxHeightComputation.h"
-#include "MxScene.h"
-#include "MxGLObjects.h"
-#include "UxProgram.h"
-#include "UxUniformBlockBase.h"
-#include "UxUniformBlockDataAccessor.h"
-#include "UxUtils.h"
-#include "UxReport.h"
-
-// Declare the "vertex" report to dump GPU data in a CPU debugging session
-#define __UxReportPath ../MxGL
-#define __UxReportName vertex
-#define __UxReportSize 64
-#define __UxReportInstance reportVertex
-#include "UxIncludeReport.h"
-
-// Startup management
-
-UxProgram* MxTerrain::_TriangleDraw     = nullptr;
-UxProgram* MxTerrain::_WireframeDraw    = nullptr;
-UxProgram* MxTerrain::_PointMapDraw     = nullptr;
-UxProgram* MxTerrain::_WireframeMapDraw = nullptr;
-
-UxAtomicCounter* MxTerrain::_TriangleCounter  = nullptr;
-UxAtomicCounter* MxTerrain::_DiscardedTriangleCounter = nullptr;
-
-bool MxTerrain::_Startup = false;
-void MxTerrain::Startup()
-{
-  if (!_Startup)
-  {
-    std::vector<UxShader> shaders;
-    shaders.emplace_back(GL_GEOMETRY_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ubo_lighting.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_geometry.glsl" }));
-    shaders.emplace_back(GL_FRAGMENT_SHADER, std::vector<std::string>({ "Shaders/ubo_heightmap.glsl", "Shaders/tx_fragment.glsl" }));
-    shaders.emplace_back(GL_VERTEX_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_vertex.glsl" }));
-    shaders.emplace_back(GL_TESS_CONTROL_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_control.glsl" }));
-    shaders.emplace_back(GL_TESS_EVALUATION_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_evaluation.glsl" }));
-    shaders.emplace_back(GL_GEOMETRY_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ubo_lighting.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_geometry_wireframe.glsl" }));
-    shaders.emplace_back(GL_FRAGMENT_SHADER, std::vector<std::string>({ "Shaders/tx_fragment_wireframe.glsl" }));
-    shaders.emplace_back(GL_GEOMETRY_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/map_pointgeometry.glsl" }));
-    shaders.emplace_back(GL_VERTEX_SHADER, std::vector<std::string>({ "Shaders/ubo_heightmap.glsl", "Shaders/ubo_positionning.glsl", "Shaders/map_vertex.glsl" }));
-    shaders.emplace_back(GL_FRAGMENT_SHADER, std::vector<std::string>({ "Shaders/map_fragment.glsl" }));
-    shaders.emplace_back(GL_GEOMETRY_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/map_wiregeometry.glsl" }));
-    
-    const char* patchAttributeBindings[][2] = { { "PositionCoordinates4f", "i_VertexPos" },{ "HeightTextureCoordinates2f", "i_HeightTextureUV" },{ "ColorComponents4f", "i_VertexColor" } };
-
-    _TriangleDraw = new UxProgram("Fill Terrain");
-    _TriangleDraw->attachShaders(shaders, 0, 4);
-    _TriangleDraw->bindVertexAttributes(patchAttributeBindings, SizeOfTable(patchAttributeBindings));
-    
-    _WireframeDraw = new UxProgram("Wireframe Terrain");
-    _WireframeDraw->attachShaders(shaders, 2, 6);
-    _WireframeDraw->bindVertexAttributes(patchAttributeBindings, SizeOfTable(patchAttributeBindings));
-
-    const char* mapAttributeBindings[][2] = { { "PositionOnPlaneCoordinates2f", "i_VertexPos" },{ "PixelCoordinates2i", "i_Pixel" } };
-
-    _PointMapDraw = new UxProgram("Map Cloud of Points");
-    _PointMapDraw->attachShaders(shaders, 7, 9);
-    _PointMapDraw->bindVertexAttributes(mapAttributeBindings, SizeOfTable(mapAttributeBindings));
-
-    _WireframeMapDraw = new UxProgram("Map Wire");
-    _WireframeMapDraw->attachShaders(shaders, 8, 10);
-    _WireframeMapDraw->bindVertexAttributes(mapAttributeBindings, SizeOfTable(mapAttributeBindings));
-
-    for (auto it = shaders.begin(); it != shaders.end(); it++)
-      glDeleteShader(it->getGLName());
-
-    // Uniform blocks registration and bindings
-    UxGLObjects::addUniformBlock<u_HeightMap>("HeightMapTerrain");
-    UxGLObjects::addUniformBlock<u_Positionning>("TerrainPositionning");
-
-    UxGLObjects::getUniformBlock("SceneLighting")->bindToProgram(_TriangleDraw, "u_Lighting");
-    UxGLObjects::getUniformBlock("SceneLighting")->bindToProgram(_WireframeDraw, "u_Lighting");
-
-    for (auto program : { _TriangleDraw, _WireframeDraw, _PointMapDraw, _WireframeMapDraw })
-    {
-      UxGLObjects::getUniformBlock("HeightMapTerrain")->bindToProgram(program, "u_HeightMap");
-      UxGLObjects::getUniformBlock("TerrainPositionning")->bindToProgram(program, "u_Positionning");
-      UxGLObjects::getUniformBlock("SceneViewing")->bindToProgram(program, "u_Viewing");
-      program->bindReports();
-      program->introspect();
-    }
-  
-    // TO REVIEW: program link / attribute / uniform block /ssbo of report
-
-    _TriangleCounter = new UxAtomicCounter(0, 0);
-    _DiscardedTriangleCounter = new UxAtomicCounter(1, 0);
-
-    _Startup = true;
-  }
-}
-
-MxTerrain::MxTerrain()
-{
-  Startup();
-} 
-
-MxTerrain::~MxTerrain()
-{
-}
-
-void MxTerrain::init(const Vector2f& iTerrainDimension, const Vector2i& iTerrainSubdivision, float iHeightFactor, float iMaxSubdivison, float iMaxPixelSubdivisionRatio, const std::string& iHeightMapTexturePath, const std::string& iHeightColorMapTexturePath, const Vector2f& iHeightColorMapBounds)
-{
-  _TerrainDimension          = iTerrainDimension; __AssertIfNot(iTerrainDimension[0] > 0.0f && iTerrainDimension[1] > 0.0f, "Invalid Terrain Dimension");
-  _TerrainSubdivision        = iTerrainSubdivision; __AssertIfNot(iTerrainSubdivision[0] > 0 && iTerrainSubdivision[1] > 0, "Invalid Terrain Subdivision");
-  _HeightFactor              = iHeightFactor; __AssertIfNot(iHeightFactor > 0.0f, "Invalid HeightFactor");
-  _MaxSubdivison             = iMaxSubdivison; __AssertIfNot(iMaxSubdivison > 0, "Invalid Max Subdivison");
-  _MaxPixelSubdivisionRatio  = iMaxPixelSubdivisionRatio; __AssertIfNot(iMaxPixelSubdivisionRatio > 0, "Invalid Max Pixel Subdivision Ratio");
-  _HeightMapTexturePath      = iHeightMapTexturePath;
-  _HeightColorMapTexturePath = iHeightColorMapTexturePath;
-  _DistortionFactor          = 4.0f;
-  _FunctionalMode            = 0.0f;
-
-  setHeightColorMapBounds(iHeightColorMapBounds);
-
-  UxUtils::createBindlessTexture(_HeightMapTexturePath, _HeightMapTextureName, _HeightTextureHandle);
-  UxUtils::createBindlessTexture(_HeightColorMapTexturePath, _HeightColorMapTextureName, _HeightColorMapHandle);
-  glGetTextureLevelParameteriv(_HeightMapTextureName, 0, GL_TEXTURE_WIDTH, &_Width);
-  glGetTextureLevelParameteriv(_HeightMapTextureName, 0, GL_TEXTURE_HEIGHT, &_Height);
-
-  //UxUtils::createTangents(_HeightMapTextureName);
-
-  _ColorMode     = 0;
-  _IsolineStep   = 0.0f;
-  _SmoothMode    = 0;
-  _WireframeMode = 0;
-  _MapMode       = 0;
-  _ShadowMode    = 0;
-  _MinHeight     = -1.0f;
-  _MaxHeight     = -1.0f;
-
-  generateTerrainData();
-  generateMapData();
-}
-
-void MxTerrain::generateTerrainData()
-{
-  GLubyte* pPixels = new GLubyte[3*_Width*_Height];
-  glGetTextureImage(_HeightMapTextureName, 0, GL_RGB, GL_UNSIGNED_BYTE, 3*_Width*_Height, pPixels);
-
-  // Fills vertex buffer with patch coordinates
-  float du = 1.0f / _TerrainSubdivision[0];
-  float dv = 1.0f / _TerrainSubdivision[1];
-  for (uint16_t i = 0; i <= _TerrainSubdivision[0]; i++)
-  {
-    for (uint16_t j = 0; j <= _TerrainSubdivision[1]; j++)
-    {
-      float u = (float)i*du;
-      float v = 1.0f - (float)j*dv;
-      float z = MxHeightComputation::getHeight(pPixels, _Width, _Height, _FunctionalMode, _SmoothMode, u, v, _HeightFactor, _MinHeight, _MaxHeight);
-      _Vertices.push_back({ (float)i, (float)j, z, 1.0f, u, v, 1.0, 1.0, 1.0, 1.0 });
-    }
-  }
-
-  _Indices = new uint32_t[_Vertices.size()];
-
-  // Links input attributes to vertex array segments
-  _PatchVertexArray.linkAttribute(MxGLObjects::getInputAttribute("PositionCoordinates4f"), &TerrainVertexData::position, GL_FLOAT, GL_FALSE);
-  _PatchVertexArray.linkAttribute(MxGLObjects::getInputAttribute("HeightTextureCoordinates2f"), &TerrainVertexData::uv, GL_FLOAT, GL_FALSE);
-  _PatchVertexArray.linkAttribute(MxGLObjects::getInputAttribute("ColorComponents4f"), &TerrainVertexData::color, GL_FLOAT, GL_FALSE);
-}
-
-void MxTerrain::generateMapData()
-{
-  // Generates position for each pixel
-  float dx = (float)_TerrainSubdivision[0] / (float)(_Width - 1);
-  float dy = (float)_TerrainSubdivision[1] / (float)(_Height - 1);
-  for (uint32_t iX = 0; iX < (uint32_t)_Width; iX++)
-  {
-    for (uint32_t iY = 0; iY < (uint32_t)_Height; iY++)
-      _MapVertexArray.addVertex({ { iX*dx, iY*dy },{ (int32_t)iX, (int32_t)_Height - (int32_t)iY - 1 } });
-  }
-
-  _MapVertexArray.store(GL_STATIC_DRAW);
-  
-  // Fills index buffer (matrix for points and line strips for wireframe)
-  _PointMapIndexBuffer.addLinearMatrix(0, _Width, _Height);
-  _PointMapIndexBuffer.store(GL_STATIC_DRAW);
-  _WireframeMapIndexBuffer.addColumnLineStripsFromMatrix(0, true, _Width, _Height, 0xFFFFFFFF);
-  _WireframeMapIndexBuffer.addRowLineStripsFromMatrix(0, true, _Width, _Height, 0xFFFFFFFF);
-  _WireframeMapIndexBuffer.store(GL_STATIC_DRAW);
-
-  // Links input attributes to vertex array segments
-  _MapVertexArray.linkAttribute(MxGLObjects::getInputAttribute("PositionOnPlaneCoordinates2f"), &MapVertexData::position, GL_FLOAT, GL_FALSE);
-  // If type for glVertexAttribPointer set to GL_UNSIGNED_INT, the data in the shader is coded as a float!
-  _MapVertexArray.linkAttribute(MxGLObjects::getInputAttribute("PixelCoordinates2i"), &MapVertexData::uv, GL_FLOAT, GL_FALSE);
-}
-
-void MxTerrain::sendData(const Matrix4f& iModelMatrix, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle)
-{
-  // Alternative to static grid sent once to GPU: send a relimited part of the grid according to visibility criterion
-  // To be evaluated (ie: performance/resource consuption advantages to use CPU or GPU
-  memset(_Indices, 0xFF, (_TerrainSubdivision[0]+1)*(_TerrainSubdivision[1]+1)*sizeof(uint32_t));
- 
-  // Browses the grid of vertices and checks visibility criterium for every one (property stored in _Indices,
-  // 0xFF: not visible and 0xFE: visible)
-  uint32_t vIndex = 0;
-  for (uint16_t i = 0; i <= _TerrainSubdivision[0]; i++)
-  {
-    for (uint16_t j = 0; j <= _TerrainSubdivision[1]; j++)
-    {
-      // Needs to transform every vertex from model to wc coordinates (is this a good trade-off CPU/GPU model matrix transformation?)
-      float*   position = _Vertices[vIndex++].position;
-      Vector4f vertex   = iModelMatrix*Vector4f(position[0], position[1], position[2], position[3]);
-
-      // Potential need of height recomputation in case of dynamic min/max height constraints
-      if (_MinHeight != -1 || _MaxHeight != -1)
-      {
-        if (_MinHeight != -1 && (vertex[2] < _MinHeight * _HeightFactor))
-          vertex[2] = _MinHeight * _HeightFactor;
-        if (_MaxHeight != -1 && (vertex[2] > _MaxHeight * _HeightFactor))
-          vertex[2] = _MaxHeight * _HeightFactor;
-      }
-
-      // Vector from the eye point (wc) to the vertex (wc)
-      Vector3f ev = Vector3f(vertex[0] - iEyeView[0], vertex[1] - iEyeView[1], vertex[2] - iEyeView[2]);
-
-      // 1. Position of the vertex with respect to the screen plane
-      float side = ev.dotProduct(iEyeDirection);
-
-      // 2. Angle eye/vertex to eye direction: inaccurate (all the 4 vertices might be outside the solid angle and the "center"
-      // part of the patch still visible)
-      //ev.normalize();
-      //float angle = acosf(ev.dotProduct(iEyeDirection));
-      //if (angle < iAngle)
-      
-      if (side > 0)
-        _Indices[i*(_TerrainSubdivision[1]+1)+j] = 0xFFFFFFFE;
-    }
-  }
-
-  // Clears the VAO and the Index Buffer prior new feeding
-  _PatchVertexArray.clearVector();
-  _PatchIndexBuffer.clearVector();
-  
-  // Browses the grid of patches and fills the vertex and index buffers from every patch to be draw
-  uint32_t indIndex = 0;
-  for (uint16_t i = 0; i < _TerrainSubdivision[0]; i++)
-  {
-    for (uint16_t j = 0; j < _TerrainSubdivision[1]; j++)
-    {
-      uint32_t ind       = i*(_TerrainSubdivision[1]+1)+j;
-      uint32_t shifts[4] = { ind, ind+_TerrainSubdivision[1]+1, ind+_TerrainSubdivision[1]+2, ind+1 };
-
-      if (_Indices[shifts[0]] != 0xFFFFFFFF || _Indices[shifts[1]] != 0xFFFFFFFF || _Indices[shifts[2]] != 0xFFFFFFFF || _Indices[shifts[3]] != 0xFFFFFFFF)
-      {
-        for (auto vi : shifts)
-        {
-          if (_Indices[vi] >= 0xFFFFFFFE)
-          {
-            auto vertex = _Vertices[vi];
-            if (_MinHeight != -1 || _MaxHeight != -1)
-            {
-              if (_MinHeight != -1 && (vertex.position[2] < _MinHeight * _HeightFactor))
-                vertex.position[2] = _MinHeight * _HeightFactor;
-              if (_MaxHeight != -1 && (vertex.position[2] > _MaxHeight * _HeightFactor))
-                vertex.position[2] = _MaxHeight * _HeightFactor;
-            }
-
-            _PatchVertexArray.addVertex(vertex);
-            _Indices[vi] = indIndex;
-            _PatchIndexBuffer.addElement(0, indIndex);
-            indIndex++;
-          }
-          else
-            _PatchIndexBuffer.addElement(0, _Indices[vi]);
-        }
-      }
-    }
-  }
-
-  _PatchIndexBuffer.store(GL_STREAM_DRAW);
-  _PatchVertexArray.store(GL_STREAM_DRAW);
-}
-
-void MxTerrain::render(int iTime, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle, uint32_t& oPatchNb, uint32_t& oDrawnPatchNb, uint32_t& oTriangleNb, uint32_t& oDiscardedTriangleNb)
-{
-  // Initializes report
-  reportVertex.init();
-
-  // Initializes atomic counters
-  _TriangleCounter->set(0);
-  _DiscardedTriangleCounter->set(0);
-
-  // Update uniform blocks (positionning and height map parameters)
-  Matrix4f modelMatrix = Matrix4f::createScale(_TerrainDimension[0] / _TerrainSubdivision[0], _TerrainDimension[1] / _TerrainSubdivision[1], 1.f);
-  {
-    std::shared_ptr<UxUniformBlock<u_Positionning>> uniformP = UxGLObjects::getUniformBlock<u_Positionning>("TerrainPositionning");
-    UxUniformBlockDataAccessor<u_Positionning> accessorP(uniformP);
-    accessorP->model = modelMatrix;
-
-    std::shared_ptr<UxUniformBlock<u_HeightMap>> uniformM = UxGLObjects::getUniformBlock<u_HeightMap>("HeightMapTerrain");
-    UxUniformBlockDataAccessor<u_HeightMap> accessorM(uniformM);
-    accessorM->heightTextureHandle      = _HeightTextureHandle;
-    accessorM->terrainDimension         = _TerrainDimension;
-    accessorM->terrainSubdivision       = _TerrainSubdivision;
-    accessorM->heightFactor             = _HeightFactor;
-    accessorM->distortionFactor         = _DistortionFactor;
-    accessorM->maxSubdivison            = _MaxSubdivison;
-    accessorM->maxPixelSubdivisionRatio = _MaxPixelSubdivisionRatio;
-    accessorM->colorMode                = _ColorMode;
-    accessorM->heightColorMapHandle     = _HeightColorMapHandle;
-    accessorM->heightColorMapBounds     = _HeightColorMapBounds;
-    accessorM->isolineStep              = _IsolineStep;
-    accessorM->wireframeMode            = _WireframeMode;
-    accessorM->functionalMode           = _FunctionalMode;
-    accessorM->smoothMode               = _SmoothMode;
-    accessorM->shadowMode               = _ShadowMode;
-    accessorM->minHeight                = _MinHeight;
-    accessorM->maxHeight                = _MaxHeight;
-  }
-
-  // Back-face culling managed (almost completely) by tesselation control and geometry shaders
-  //glEnable(GL_CULL_FACE);
-  
-  glEnable(GL_DEPTH_TEST);
-  glPatchParameteri(GL_PATCH_VERTICES, 4);
-
-  // Builds vertex/index data to send to the pipeline
-  sendData(modelMatrix, Vector3f(iEyeView[0], iEyeView[1], iEyeView[2]), iEyeDirection, iAngle);
-
-  // Stores the patch numbers (total and sent to draw) 
-  oPatchNb      = _TerrainSubdivision[0] * _TerrainSubdivision[1];
-  oDrawnPatchNb = _PatchIndexBuffer.getBufferSize() / 4;
-
-  // Draw terrain patches
-  _TriangleDraw->draw(GL_PATCHES, _PatchVertexArray, _PatchIndexBuffer);
-
-  if (_WireframeMode > 0)
-  {
-    // Draws wireframe patch borders and/or normals
-    glLineWidth(1.0f);
-    _WireframeDraw->draw(GL_PATCHES, _PatchVertexArray, _PatchIndexBuffer);
-  }
-
-  if (_MapMode == 1)
-  {
-    // Draws grid of points of the height map
-    glEnable(GL_PROGRAM_POINT_SIZE);
-    _PointMapDraw->draw(GL_POINTS, _MapVertexArray, _PointMapIndexBuffer);
-  }
-  else if (_MapMode == 2)
-  {
-    // Draws wireframe grid of the height map
-    glLineWidth(1.0f);
-    _WireframeMapDraw->draw(GL_LINE_STRIP, _MapVertexArray, _WireframeMapIndexBuffer);
-  }
-
-  //glMemoryBarrier(GL_ALL_BARRIER_BITS);
-    
-  // Stores triangle numbers (displayed and discared by the pipeline)
-  oTriangleNb          = _TriangleCounter->get();
-  oDiscardedTriangleNb = _DiscardedTriangleCounter->get();
-
-  // Map the report to be able to dump the content during debug session
-  reportVertex.map();
-  uint32_t vertexCounter = reportVertex.getRecordNumber();
-  auto table = reportVertex.getRecords();
-  reportVertex.unmap();
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "MxTerrain.h"
+#include "MxHeightComputation.h"
+#include "MxScene.h"
+#include "MxGLObjects.h"
+#include "UxProgram.h"
+#include "UxProgramVariants.h"
+#include "UxUniformBlockBase.h"
+#include "UxUniformBlockDataAccessor.h"
+#include "UxShaderStorageDataAccessor.h"
+#include "UxUtils.h"
+#include "UxGLState.h"
+#include "UxReport.h"
+#include "UxAllocationCounter.h"
+#include "UxThreadPool.h"
+#include "UxUploadThread.h"
+#include "UxResidencyManager.h"
+#include "UxGPUMemoryRegistry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <chrono>
+
+// Declare the "vertex" report to dump GPU data in a CPU debugging session
+#define __UxReportPath ../MxGL
+#define __UxReportName vertex
+#define __UxReportSize 64
+#define __UxReportInstance reportVertex
+#include "UxIncludeReport.h"
+
+// Startup management
+
+UxProgramVariants* MxTerrain::_TriangleDraw       = nullptr;
+UxProgram*         MxTerrain::_CachedTriangleDraw = nullptr;
+UxProgramVariants* MxTerrain::_ShadedPatchDraw    = nullptr;
+UxProgramVariants* MxTerrain::_EdgeTriangleDraw   = nullptr;
+UxProgram*         MxTerrain::_WireframeDraw      = nullptr;
+UxProgram*         MxTerrain::_PointMapDraw       = nullptr;
+UxProgram*         MxTerrain::_WireframeMapDraw   = nullptr;
+
+UxProgram* MxTerrain::_SubdivisionDraw     = nullptr;
+UxProgram* MxTerrain::_SubdivisionClassify = nullptr;
+UxProgram* MxTerrain::_SubdivisionScan     = nullptr;
+UxProgram* MxTerrain::_SubdivisionRefine   = nullptr;
+UxProgram* MxTerrain::_SubdivisionFinalize = nullptr;
+UxProgram* MxTerrain::_SubdivisionCull     = nullptr;
+
+GLuint     MxTerrain::_SubdivisionBinding   = GL_INVALID_INDEX;
+uint32_t   MxTerrain::_SubdivisionStorageNb = 0;
+
+UxAtomicCounter* MxTerrain::_TriangleCounter  = nullptr;
+UxAtomicCounter* MxTerrain::_DiscardedTriangleCounter = nullptr;
+UxThreadPool*    MxTerrain::_LoadingPool = nullptr;
+
+UxHandle<UxUniformBlock<MxTerrain::u_HeightMap>>     MxTerrain::_HeightMapBlock;
+UxHandle<UxUniformBlock<MxTerrain::u_Positionning>>  MxTerrain::_PositionningBlock;
+UxHandle<UxUniformBlockBase>                         MxTerrain::_ViewingBlock;
+UxHandle<UxUniformBlockBase>                         MxTerrain::_LightingBlock;
+
+bool MxTerrain::_Startup = false;
+void MxTerrain::Startup()
+{
+  if (!_Startup)
+  {
+    std::vector<UxShader> shaders;
+    shaders.emplace_back(GL_VERTEX_SHADER, std::vector<std::string>({ "Shaders/tx_cache_vertex.glsl" }));
+    shaders.emplace_back(GL_FRAGMENT_SHADER, std::vector<std::string>({ "Shaders/ubo_heightmap.glsl", "Shaders/tx_fragment_color.glsl", "Shaders/tx_fragment.glsl" }));
+    shaders.emplace_back(GL_VERTEX_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_vertex.glsl" }));
+    shaders.emplace_back(GL_TESS_CONTROL_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_levels.glsl", "Shaders/tx_tesselation_control.glsl" }));
+    shaders.emplace_back(GL_TESS_EVALUATION_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_evaluation.glsl" }));
+    shaders.emplace_back(GL_GEOMETRY_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ubo_lighting.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_geometry_wireframe.glsl" }));
+    shaders.emplace_back(GL_FRAGMENT_SHADER, std::vector<std::string>({ "Shaders/tx_fragment_wireframe.glsl" }));
+    shaders.emplace_back(GL_GEOMETRY_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/map_pointgeometry.glsl" }));
+    shaders.emplace_back(GL_VERTEX_SHADER, std::vector<std::string>({ "Shaders/ubo_heightmap.glsl", "Shaders/ubo_positionning.glsl", "Shaders/map_vertex.glsl" }));
+    shaders.emplace_back(GL_FRAGMENT_SHADER, std::vector<std::string>({ "Shaders/map_fragment.glsl" }));
+    shaders.emplace_back(GL_GEOMETRY_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/map_wiregeometry.glsl" }));
+    shaders.emplace_back(GL_VERTEX_SHADER, std::vector<std::string>({ "Shaders/ubo_heightmap.glsl", "Shaders/ubo_positionning.glsl", "Shaders/map_vertex.glsl" }), std::vector<std::string>({ "MAP_LINES" }));
+    
+    // Fill programs specialized by the render modes, every variant being linked at its first use: uniform block bindings
+    // (lighting used by the shading of every fill program)
+    auto fillSetup = [](UxProgram* iProgram) {
+      UxGLObjects::getUniformBlock(_LightingBlock)->bindToProgram(iProgram, "u_Lighting");
+      UxGLObjects::getUniformBlock(_HeightMapBlock)->bindToProgram(iProgram, "u_HeightMap");
+      UxGLObjects::getUniformBlock(_PositionningBlock)->bindToProgram(iProgram, "u_Positionning");
+      UxGLObjects::getUniformBlock(_ViewingBlock)->bindToProgram(iProgram, "u_Viewing");
+      iProgram->bindReports();
+    };
+
+    _TriangleDraw = new UxProgramVariants("Fill Terrain", {
+      { GL_VERTEX_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_vertex.glsl" } },
+      { GL_TESS_CONTROL_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_levels.glsl", "Shaders/tx_tesselation_control.glsl" } },
+      { GL_TESS_EVALUATION_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_evaluation.glsl" } },
+      { GL_GEOMETRY_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ubo_lighting.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_shading.glsl", "Shaders/tx_geometry_culling.glsl", "Shaders/tx_geometry.glsl" } },
+      { GL_FRAGMENT_SHADER, { "Shaders/ubo_heightmap.glsl", "Shaders/tx_fragment_color.glsl", "Shaders/tx_fragment.glsl" } } },
+      [fillSetup](UxProgram* iProgram) {
+        // Geometry shader outputs captured (same order as CachedVertexData) when the terrain cache is active
+        const char* cacheVaryings[] = { "gl_Position", "GSO.VertexColor", "GSO.Height", "GSO.ScreenHeightGradient" };
+        iProgram->setFeedbackVaryings(cacheVaryings, SizeOfTable(cacheVaryings));
+        fillSetup(iProgram);
+      });
+
+    const char* cacheAttributeBindings[][2] = { { "PositionCoordinates4f", "i_VertexPos" },{ "ColorComponents4f", "i_VertexColor" },{ "HeightValue1f", "i_Height" },{ "ScreenHeightGradient1f", "i_ScreenHeightGradient" } };
+
+    _CachedTriangleDraw = new UxProgram("Fill Terrain from Cache");
+    _CachedTriangleDraw->attachShaders(shaders, 0, 1);
+    _CachedTriangleDraw->bindVertexAttributes(cacheAttributeBindings, SizeOfTable(cacheAttributeBindings));
+
+    _WireframeDraw = new UxProgram("Wireframe Terrain");
+    _WireframeDraw->attachShaders(shaders, 2, 6);
+
+    // Map grid derived from the vertex rank (no vertex nor index buffer): one vertex per texel, or two per segment
+    _PointMapDraw = new UxProgram("Map Cloud of Points");
+    _PointMapDraw->attachShaders(shaders, 7, 9);
+
+    _WireframeMapDraw = new UxProgram("Map Wire");
+    _WireframeMapDraw->attachShaders(shaders, 9, 11);
+
+    // Fill with patch and triangle borders drawn in the same pass (distances to the edges computed by the geometry shader)
+    _EdgeTriangleDraw = new UxProgramVariants("Fill Terrain with Borders", {
+      { GL_VERTEX_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_vertex.glsl" } },
+      { GL_TESS_CONTROL_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_levels.glsl", "Shaders/tx_tesselation_control.glsl" } },
+      { GL_TESS_EVALUATION_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_evaluation.glsl" } },
+      { GL_GEOMETRY_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ubo_lighting.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_shading.glsl", "Shaders/tx_geometry_culling.glsl", "Shaders/tx_geometry_edges.glsl" } },
+      { GL_FRAGMENT_SHADER, { "Shaders/ubo_heightmap.glsl", "Shaders/tx_fragment_color.glsl", "Shaders/tx_fragment_edges.glsl" } } },
+      fillSetup);
+
+    // Tesselation without geometry shader (culling by the TCS and the fixed pipeline, shading by the TES)
+    _ShadedPatchDraw = new UxProgramVariants("Fill Terrain without Geometry Shader", {
+      { GL_VERTEX_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_vertex.glsl" } },
+      { GL_TESS_CONTROL_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_tesselation_levels.glsl", "Shaders/tx_visibility.glsl", "Shaders/tx_tesselation_control_culling.glsl" } },
+      { GL_TESS_EVALUATION_SHADER, { "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ubo_lighting.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_shading.glsl", "Shaders/tx_tesselation_evaluation_shading.glsl" } },
+      { GL_FRAGMENT_SHADER, { "Shaders/ubo_heightmap.glsl", "Shaders/tx_fragment_color.glsl", "Shaders/tx_fragment.glsl" } } },
+      fillSetup);
+
+    // Adaptive subdivision computed on GPU (node lists updated by compute shaders, leaf grids drawn by instances)
+    std::vector<UxShader> subdivisionShaders;
+    subdivisionShaders.emplace_back(GL_VERTEX_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ubo_lighting.glsl", "Shaders/ssbo_subdivision.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_shading.glsl", "Shaders/tx_visibility.glsl", "Shaders/tx_subdivision.glsl", "Shaders/tx_subdivision_vertex.glsl" }));
+    subdivisionShaders.emplace_back(GL_FRAGMENT_SHADER, std::vector<std::string>({ "Shaders/ubo_heightmap.glsl", "Shaders/tx_fragment_color.glsl", "Shaders/tx_fragment.glsl" }));
+    subdivisionShaders.emplace_back(GL_COMPUTE_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ssbo_subdivision.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_visibility.glsl", "Shaders/tx_subdivision.glsl", "Shaders/tx_subdivision_classify.glsl" }));
+    subdivisionShaders.emplace_back(GL_COMPUTE_SHADER, std::vector<std::string>({ "Shaders/ssbo_subdivision.glsl", "Shaders/tx_subdivision_scan.glsl" }));
+    subdivisionShaders.emplace_back(GL_COMPUTE_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ssbo_subdivision.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_visibility.glsl", "Shaders/tx_subdivision.glsl", "Shaders/tx_subdivision_refine.glsl" }));
+    subdivisionShaders.emplace_back(GL_COMPUTE_SHADER, std::vector<std::string>({ "Shaders/ssbo_subdivision.glsl", "Shaders/tx_subdivision_finalize.glsl" }));
+    subdivisionShaders.emplace_back(GL_COMPUTE_SHADER, std::vector<std::string>({ "Shaders/ubo_viewing.glsl", "Shaders/ubo_positionning.glsl", "Shaders/ubo_heightmap.glsl", "Shaders/ssbo_subdivision.glsl", "Shaders/tx_mapcomputing.glsl", "Shaders/tx_visibility.glsl", "Shaders/tx_subdivision.glsl", "Shaders/tx_subdivision_cull.glsl" }));
+
+    const char* gridAttributeBindings[][2] = { { "PositionCoordinates4f", "i_VertexPos" } };
+
+    _SubdivisionDraw = new UxProgram("Fill Terrain from GPU Subdivision");
+    _SubdivisionDraw->attachShaders(subdivisionShaders, 0, 1);
+    _SubdivisionDraw->bindVertexAttributes(gridAttributeBindings, SizeOfTable(gridAttributeBindings));
+
+    _SubdivisionClassify = new UxProgram("Subdivision Classification");
+    _SubdivisionClassify->attachShaders(subdivisionShaders, 2, 2);
+    _SubdivisionScan = new UxProgram("Subdivision Scan");
+    _SubdivisionScan->attachShaders(subdivisionShaders, 3, 3);
+    _SubdivisionRefine = new UxProgram("Subdivision Refinement");
+    _SubdivisionRefine->attachShaders(subdivisionShaders, 4, 4);
+    _SubdivisionFinalize = new UxProgram("Subdivision Finalization");
+    _SubdivisionFinalize->attachShaders(subdivisionShaders, 5, 5);
+    _SubdivisionCull = new UxProgram("Subdivision Culling");
+    _SubdivisionCull->attachShaders(subdivisionShaders, 6, 6);
+
+    for (auto it = shaders.begin(); it != shaders.end(); it++)
+      glDeleteShader(it->getGLName());
+    for (auto it = subdivisionShaders.begin(); it != subdivisionShaders.end(); it++)
+      glDeleteShader(it->getGLName());
+
+    // Uniform blocks registration and bindings
+    _HeightMapBlock    = UxGLObjects::addUniformBlock<u_HeightMap>("HeightMapTerrain");
+    _PositionningBlock = UxGLObjects::addUniformBlock<u_Positionning>("TerrainPositionning");
+    _ViewingBlock      = UxGLObjects::getUniformBlock("SceneViewing")->getHandle();
+    _LightingBlock     = UxGLObjects::getUniformBlock("SceneLighting")->getHandle();
+
+    UxGLObjects::getUniformBlock("SceneLighting")->bindToProgram(_WireframeDraw, "u_Lighting");
+
+    for (auto program : { _WireframeDraw, _PointMapDraw, _WireframeMapDraw })
+    {
+      UxGLObjects::getUniformBlock("HeightMapTerrain")->bindToProgram(program, "u_HeightMap");
+      UxGLObjects::getUniformBlock("TerrainPositionning")->bindToProgram(program, "u_Positionning");
+      UxGLObjects::getUniformBlock("SceneViewing")->bindToProgram(program, "u_Viewing");
+      program->bindReports();
+      program->introspect();
+    }
+
+    UxGLObjects::getUniformBlock("HeightMapTerrain")->bindToProgram(_CachedTriangleDraw, "u_HeightMap");
+    _CachedTriangleDraw->bindReports();
+    _CachedTriangleDraw->introspect();
+
+    // Subdivision storage of each instance bound to the compute passes and the draw before its use (see bindSubdivision)
+    UxGLObjects::getUniformBlock("SceneLighting")->bindToProgram(_SubdivisionDraw, "u_Lighting");
+
+    for (auto program : { _SubdivisionDraw, _SubdivisionClassify, _SubdivisionCull })
+    {
+      UxGLObjects::getUniformBlock("HeightMapTerrain")->bindToProgram(program, "u_HeightMap");
+      UxGLObjects::getUniformBlock("TerrainPositionning")->bindToProgram(program, "u_Positionning");
+      UxGLObjects::getUniformBlock("SceneViewing")->bindToProgram(program, "u_Viewing");
+    }
+
+    for (auto program : { _SubdivisionDraw, _SubdivisionClassify, _SubdivisionScan, _SubdivisionRefine, _SubdivisionFinalize, _SubdivisionCull })
+    {
+      program->bindReports();
+      program->introspect();
+    }
+  
+    // TO REVIEW: program link / attribute / uniform block /ssbo of report
+
+    _TriangleCounter = new UxAtomicCounter(0, 0);
+    _DiscardedTriangleCounter = new UxAtomicCounter(1, 0);
+
+    _LoadingPool = &UxThreadPool::getShared();
+
+    _Startup = true;
+  }
+}
+
+MxTerrain::MxTerrain()
+: _PatchStream("Terrain Patches", 1 << 18)
+{
+  Startup();
+
+  _CacheMode                 = 0;
+  _PatchOrderMode            = 1;
+  _PipelineMode              = 0;
+  _CacheCapacity             = 0;
+  _IsCacheValid              = false;
+  _CachedViewingRevision     = 0;
+  _CachedLightingRevision    = 0;
+  _CachedDrawnPatchNb        = 0;
+  _CachedTriangleNb          = 0;
+  _CachedDiscardedTriangleNb = 0;
+
+  _HeightMapTextureName      = 0;
+  _HeightTextureHandle       = 0;
+  _HeightColorMapTextureName = 0;
+  _HeightColorMapHandle      = 0;
+  memset(_HeightLevelTextureNames, 0, sizeof(_HeightLevelTextureNames));
+  memset(_HeightLevelHandles, 0, sizeof(_HeightLevelHandles));
+  _Indices                   = nullptr;
+  _LoadingState              = Unloaded;
+  _IsUploadedByStrips        = false;
+  _LoadedTextureNames[0]     = _LoadedTextureNames[1] = 0;
+  _LoadedTextureHandles[0]   = _LoadedTextureHandles[1] = 0;
+  _TileGPUBudget             = 0;
+  _TileCPUBudget             = 0;
+  _RawSize                   = Vector2i(0, 0);
+  _IsStreamed                = false;
+  _IsSubdivisionValid        = false;
+
+  // Leaf grid independent of the height map
+  generateSubdivisionData();
+} 
+
+MxTerrain::~MxTerrain()
+{
+  // Loading jobs referencing the instance completed: the strips posted while decoding have no ticket, the jobs being
+  // run in order an empty job waited for completes them
+  if (_DecodingTask.valid())
+    _DecodingTask.wait();
+  if (_LoadingState == Decoding && _IsUploadedByStrips)
+    _UploadTicket = UxUploadThread::submit([]() {});
+  if (_UploadTicket)
+    _UploadTicket->wait();
+
+  // Textures of an interrupted loading (not handed to the instance) and textures in use
+  if (_LoadingState != Ready)
+  {
+    releaseTexture(_LoadedTextureNames[0], _LoadedTextureHandles[0]);
+    releaseTexture(_LoadedTextureNames[1], _LoadedTextureHandles[1]);
+  }
+  releaseHeightLevelViews();
+  releaseTexture(_HeightMapTextureName, _HeightTextureHandle);
+  releaseTexture(_HeightColorMapTextureName, _HeightColorMapHandle);
+
+  if (_SubdivisionStorage && _SubdivisionStorage->getLocation() == _SubdivisionBinding)
+    _SubdivisionBinding = GL_INVALID_INDEX;
+  delete[] _Indices;
+}
+
+void MxTerrain::init(const Vector2f& iTerrainDimension, const Vector2i& iTerrainSubdivision, float iHeightFactor, float iMaxSubdivison, float iMaxPixelSubdivisionRatio, const std::string& iHeightMapTexturePath, const std::string& iHeightColorMapTexturePath, const Vector2f& iHeightColorMapBounds, GLenum iHeightFormat)
+{
+  initAsync(iTerrainDimension, iTerrainSubdivision, iHeightFactor, iMaxSubdivison, iMaxPixelSubdivisionRatio, iHeightMapTexturePath, iHeightColorMapTexturePath, iHeightColorMapBounds, iHeightFormat);
+  updateLoading(true);
+}
+
+void MxTerrain::initAsync(const Vector2f& iTerrainDimension, const Vector2i& iTerrainSubdivision, float iHeightFactor, float iMaxSubdivison, float iMaxPixelSubdivisionRatio, const std::string& iHeightMapTexturePath, const std::string& iHeightColorMapTexturePath, const Vector2f& iHeightColorMapBounds, GLenum iHeightFormat)
+{
+  // Loading in progress completed first (its jobs use the parameters below)
+  if (_LoadingState == Decoding || _LoadingState == Uploading)
+    updateLoading(true);
+  // Tiles read from the asset about to be mapped again
+  _TileCache.destroy();
+
+  _TerrainDimension          = iTerrainDimension; __AssertIfNot(iTerrainDimension[0] > 0.0f && iTerrainDimension[1] > 0.0f, "Invalid Terrain Dimension");
+  _TerrainSubdivision        = iTerrainSubdivision; __AssertIfNot(iTerrainSubdivision[0] > 0 && iTerrainSubdivision[1] > 0, "Invalid Terrain Subdivision");
+  _HeightFactor              = iHeightFactor; __AssertIfNot(iHeightFactor > 0.0f, "Invalid HeightFactor");
+  _MaxSubdivison             = iMaxSubdivison; __AssertIfNot(iMaxSubdivison > 0, "Invalid Max Subdivison");
+  _MaxPixelSubdivisionRatio  = iMaxPixelSubdivisionRatio; __AssertIfNot(iMaxPixelSubdivisionRatio > 0, "Invalid Max Pixel Subdivision Ratio");
+  _HeightMapTexturePath      = iHeightMapTexturePath;
+  _HeightColorMapTexturePath = iHeightColorMapTexturePath;
+  _DistortionFactor          = 4.0f;
+  _FunctionalMode            = 0.0f;
+
+  setHeightColorMapBounds(iHeightColorMapBounds);
+
+  _ColorMode     = 0;
+  _IsolineStep   = 0.0f;
+  _SmoothMode    = 0;
+  _WireframeMode = 0;
+  _MapMode       = 0;
+  _ShadowMode    = 0;
+  _MinHeight     = -1.0f;
+  _MaxHeight     = -1.0f;
+
+  // Maps decoded once and kept on CPU until uploaded: the CPU data (heights, patches, map grid) are derived from
+  // the decoded samples by the loading pool (no read back of the texture), the render loop going on meanwhile
+  _LoadingState       = Decoding;
+  _IsUploadedByStrips = UxUploadThread::isStarted() && !MxTerrainAsset::isAssetPath(iHeightMapTexturePath);
+  _IsStreamed         = _TileGPUBudget > 0 && MxTerrainAsset::isAssetPath(iHeightMapTexturePath);
+  _DecodingTask       = _LoadingPool->submit([this, iHeightFormat]()
+  {
+    loadHeightField(iHeightFormat);
+    UxUtils::decodeImage(_HeightColorMapTexturePath, _DecodedColorMap);
+
+    generateHeightData();
+    generateTerrainData();
+  });
+}
+
+bool MxTerrain::updateLoading(bool iWait)
+{
+  if (_LoadingState == Decoding)
+  {
+    if (!iWait && _DecodingTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return false;
+    _DecodingTask.get();
+
+    // Textures (mip chain included) created and filled by the upload thread, made resident by the rendering
+    // context once complete (residency is per context)
+    _UploadTicket = UxUploadThread::submit([this]()
+    {
+      if (_IsStreamed)
+      {
+        _LoadedTextureNames[0]   = 0;
+        _LoadedTextureHandles[0] = 0;
+      }
+      else if (_Asset.isOpen())
+        _Asset.createHeightTexture(_LoadedTextureNames[0], _LoadedTextureHandles[0], false);
+      else if (_IsUploadedByStrips)
+        UxUtils::completeHeightTexture(_DecodedHeightMap, _LoadedTextureNames[0], _LoadedTextureHandles[0], false, true);
+      else
+        UxUtils::createHeightTexture(_DecodedHeightMap, _LoadedTextureNames[0], _LoadedTextureHandles[0], false, true);
+      UxUtils::createTexture(_DecodedColorMap, _LoadedTextureNames[1], _LoadedTextureHandles[1], false);
+    });
+    _LoadingState = Uploading;
+  }
+
+  if (_LoadingState == Uploading)
+  {
+    if (iWait)
+      _UploadTicket->wait();
+    else if (!_UploadTicket->isComplete())
+      return false;
+    _UploadTicket.reset();
+
+    completeLoading();
+    _LoadingState = Ready;
+  }
+
+  return _LoadingState == Ready;
+}
+
+void MxTerrain::completeLoading()
+{
+  // Textures of the previous loading released (no height texture when streamed)
+  releaseHeightLevelViews();
+  releaseTexture(_HeightMapTextureName, _HeightTextureHandle);
+  releaseTexture(_HeightColorMapTextureName, _HeightColorMapHandle);
+
+  // Handles made resident by render while the terrain is visible
+  _HeightMapTextureName      = _LoadedTextureNames[0];
+  _HeightTextureHandle       = _LoadedTextureHandles[0];
+  _HeightColorMapTextureName = _LoadedTextureNames[1];
+  _HeightColorMapHandle      = _LoadedTextureHandles[1];
+  _LoadedTextureNames[0]     = _LoadedTextureNames[1] = 0;
+  _LoadedTextureHandles[0]   = _LoadedTextureHandles[1] = 0;
+  if (_HeightTextureHandle)
+  {
+    UxResidencyManager::registerHandle(_HeightTextureHandle, _HeightMapTextureName);
+    createHeightLevelViews();
+  }
+  UxResidencyManager::registerHandle(_HeightColorMapHandle, _HeightColorMapTextureName);
+
+  // Streaming: coarse tiles resident at once, the other ones streamed by render
+  if (_IsStreamed)
+    _TileCache.create(_Asset, _LoadingPool, _TileGPUBudget, _TileCPUBudget);
+
+  //UxUtils::createTangents(_HeightMapTextureName);
+
+  // Decoded maps no longer needed (the CPU heights are kept by the height field)
+  _DecodedHeightMap.samples.clear();
+  _DecodedHeightMap.samples.shrink_to_fit();
+  _DecodedColorMap.data.clear();
+  _DecodedColorMap.data.shrink_to_fit();
+
+  storeGeneratedData();
+
+  // Root nodes (re)loaded at the next render in GPU subdivision mode, cache captured again
+  _IsSubdivisionValid = false;
+  _IsCacheValid       = false;
+}
+
+void MxTerrain::releaseTexture(GLuint& ioTextureName, GLuint64& ioTextureHandle)
+{
+  if (!ioTextureName)
+    return;
+
+  if (ioTextureHandle)
+    UxResidencyManager::unregisterHandle(ioTextureHandle);
+  UxGPUMemoryRegistry::release(UxGPUMemoryRegistry::Texture, ioTextureName);
+  glDeleteTextures(1, &ioTextureName);
+  __CheckGLErrors;
+
+  ioTextureName   = 0;
+  ioTextureHandle = 0;
+}
+
+void MxTerrain::createHeightLevelViews()
+{
+  GLint levelNb = 0, internalFormat = 0;
+  glGetTextureParameteriv(_HeightMapTextureName, GL_TEXTURE_IMMUTABLE_LEVELS, &levelNb);
+  glGetTextureLevelParameteriv(_HeightMapTextureName, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+  __CheckGLErrors;
+
+  // Views share the storage of the height map (not recorded by the memory registry)
+  for (GLuint level = 1; level < std::min((GLuint)levelNb, _HeightLevelMaxNb); level++)
+  {
+    glGenTextures(1, &_HeightLevelTextureNames[level]);
+    glTextureView(_HeightLevelTextureNames[level], GL_TEXTURE_2D, _HeightMapTextureName, internalFormat, level, 1, 0, 1);
+    __CheckGLErrors;
+    glTextureParameteri(_HeightLevelTextureNames[level], GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureParameteri(_HeightLevelTextureNames[level], GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(_HeightLevelTextureNames[level], GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(_HeightLevelTextureNames[level], GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    __CheckGLErrors;
+
+    _HeightLevelHandles[level] = glGetTextureHandleARB(_HeightLevelTextureNames[level]);
+    __CheckGLErrors;
+    UxResidencyManager::registerHandle(_HeightLevelHandles[level], _HeightLevelTextureNames[level]);
+  }
+}
+
+void MxTerrain::releaseHeightLevelViews()
+{
+  for (uint32_t level = 0; level < _HeightLevelMaxNb; level++)
+    releaseTexture(_HeightLevelTextureNames[level], _HeightLevelHandles[level]);
+}
+
+const char* MxTerrain::getLoadingStage() const
+{
+  switch (_LoadingState)
+  {
+    case Unloaded:  return "unloaded";
+    case Decoding:  return "decoding";
+    case Uploading: return "uploading";
+    default:        return "ready";
+  }
+}
+
+void MxTerrain::loadHeightField(GLenum iHeightFormat)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::TerrainData);
+
+  // Baked asset: mip chain uploaded and height field read in place from the mapping (nothing decoded nor derived)
+  if (MxTerrainAsset::isAssetPath(_HeightMapTexturePath))
+  {
+    if (!_Asset.open(_HeightMapTexturePath))
+    {
+      UxError::error(__FILE__, __LINE__) << " Can't map the terrain asset " << _HeightMapTexturePath << " (missing, truncated or baked by another version).\n";
+      UxError::exit(-1);
+    }
+
+    const MxTerrainAsset::Header& header = _Asset.getHeader();
+    _Width        = header.width;
+    _Height       = header.height;
+    _HeightFormat = header.internalFormat;
+    _HeightRange  = { header.range[0], header.range[1] };
+    _HeightField.init(header.width, header.height, header.type, (MxHeightField::Layout)header.fieldLayout, header.range[0], header.range[1], _Asset.getSection(header.field));
+    return;
+  }
+
+  // With an upload thread, the height map is uploaded by strips as they are decoded (jobs run in order: storage,
+  // strips, then the mip chain submitted once decoded)
+  UxUtils::HeightDecodingListener listener;
+  listener.onStart = [this](const UxUtils::HeightImage& iImage) {
+    UxUploadThread::post([this]() { UxUtils::createHeightStorage(_DecodedHeightMap, _LoadedTextureNames[0], true); });
+  };
+  listener.onStrip = [this](uint32_t iFirstRow, uint32_t iRowNb) {
+    UxUploadThread::post([this, iFirstRow, iRowNb]() { UxUtils::uploadHeightRows(_LoadedTextureNames[0], _DecodedHeightMap, iFirstRow, iRowNb); });
+  };
+
+  _Asset.close();
+  UxUtils::decodeHeightMap(_HeightMapTexturePath, iHeightFormat, _DecodedHeightMap, _IsUploadedByStrips ? &listener : nullptr, _RawSize);
+  _Width        = _DecodedHeightMap.width;
+  _Height       = _DecodedHeightMap.height;
+  _HeightFormat = _DecodedHeightMap.internalFormat;
+  _HeightRange  = _DecodedHeightMap.range;
+
+  // Decoded samples (format of the texture) stored in the layout of the height field
+  _HeightField.init(_DecodedHeightMap.width, _DecodedHeightMap.height, _DecodedHeightMap.type, MxHeightField::Morton, _DecodedHeightMap.range[0], _DecodedHeightMap.range[1]);
+  _HeightField.setSamples(_DecodedHeightMap.samples.data());
+}
+
+void MxTerrain::generateHeightData()
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::TerrainData);
+
+  // Computes the height of the patch vertices (visibility test)
+  float du = 1.0f / _TerrainSubdivision[0];
+  float dv = 1.0f / _TerrainSubdivision[1];
+  _VertexHeights.clear();
+  for (uint16_t i = 0; i <= _TerrainSubdivision[0]; i++)
+  {
+    for (uint16_t j = 0; j <= _TerrainSubdivision[1]; j++)
+    {
+      float u = (float)i*du;
+      float v = 1.0f - (float)j*dv;
+      _VertexHeights.push_back(MxHeightComputation::getHeight(_HeightField, _FunctionalMode, _SmoothMode, u, v, _HeightFactor, _MinHeight, _MaxHeight));
+    }
+  }
+}
+
+void MxTerrain::generateTerrainData()
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::TerrainData);
+
+  delete[] _Indices;
+  _Indices = new uint32_t[_VertexHeights.size()];
+
+  // Offsets of the patches from the one containing the eye, sorted once in Z-order: browsed from the eye patch
+  // towards the 4 directions, every square of the quadtree is visited before the farther ones
+  _PatchOffsets.clear();
+  for (uint32_t dx = 0; dx < (uint32_t)_TerrainSubdivision[0]; dx++)
+  {
+    for (uint32_t dy = 0; dy < (uint32_t)_TerrainSubdivision[1]; dy++)
+      _PatchOffsets.push_back(dx | (dy << 16));
+  }
+  std::sort(_PatchOffsets.begin(), _PatchOffsets.end(), [](uint32_t iOffset1, uint32_t iOffset2) {
+    return UxUtils::mortonCode(iOffset1 & 0xFFFF, iOffset1 >> 16) < UxUtils::mortonCode(iOffset2 & 0xFFFF, iOffset2 >> 16); });
+}
+
+void MxTerrain::storeGeneratedData()
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::TerrainData);
+
+  // Links input attributes to vertex array segments of the captured vertices of the terrain cache
+  _CacheVertexArray.linkAttribute(MxGLObjects::getInputAttribute("PositionCoordinates4f"), &CachedVertexData::position, GL_FLOAT, GL_FALSE);
+  _CacheVertexArray.linkAttribute(MxGLObjects::getInputAttribute("ColorComponents4f"), &CachedVertexData::color, GL_FLOAT, GL_FALSE);
+  _CacheVertexArray.linkAttribute(MxGLObjects::getInputAttribute("HeightValue1f"), &CachedVertexData::height, GL_FLOAT, GL_FALSE);
+  _CacheVertexArray.linkAttribute(MxGLObjects::getInputAttribute("ScreenHeightGradient1f"), &CachedVertexData::screenHeightGradient, GL_FLOAT, GL_FALSE);
+}
+
+void MxTerrain::generateSubdivisionData()
+{
+  // Vertices and indices staged before the buffers (scope opened once, not per element)
+  UxAllocationScope allocationScope(UxAllocationCounter::BufferStaging);
+
+  // Grid of (G+1)x(G+1) vertices, 2 counterclockwise triangles per cell (front faces oriented towards z>0)
+  const uint32_t G = _SubdivisionGridSize;
+  for (uint32_t j = 0; j <= G; j++)
+  {
+    for (uint32_t i = 0; i <= G; i++)
+      _SubdivisionGridArray.addVertex({ (float)i, (float)j, 0.0f, 1.0f });
+  }
+
+  for (uint32_t j = 0; j < G; j++)
+  {
+    for (uint32_t i = 0; i < G; i++)
+    {
+      uint32_t index = j*(G+1)+i;
+      for (uint32_t vertex : { index, index+1, index+G+2, index, index+G+2, index+G+1 })
+        _SubdivisionGridIndexBuffer.addElement(0, vertex);
+    }
+  }
+
+  _SubdivisionGridArray.store(GL_STATIC_DRAW);
+  _SubdivisionGridIndexBuffer.store(GL_STATIC_DRAW);
+
+  _SubdivisionGridArray.linkAttribute(MxGLObjects::getInputAttribute("PositionCoordinates4f"), &GridVertexData::position, GL_FLOAT, GL_FALSE);
+}
+
+void MxTerrain::initSubdivision()
+{
+  // One root node per patch, in the order of the patch indices (i*subdivision.y+j)
+  uint32_t patchNb = _TerrainSubdivision[0] * _TerrainSubdivision[1];
+  __AssertIfNot(patchNb <= _SubdivisionNodeCapacity, "Too many patches for the GPU subdivision");
+
+  // Max level such as the key (patch index and morton code of the node) holds in 32 bits
+  uint32_t maxLevel = 0;
+  while (maxLevel < 12 && ((uint64_t)patchNb << (2*(maxLevel+1))) <= (1ull << 32))
+    maxLevel++;
+
+  // Storage of the instance: the node lists of several terrains persist side by side from frame to frame
+  if (!_SubdivisionStorage)
+    _SubdivisionStorage.reset(new UxShaderStorage<u_Subdivision>("TerrainSubdivision" + std::to_string(_SubdivisionStorageNb++), GL_DYNAMIC_COPY));
+
+  UxShaderStorageDataAccessor<u_Subdivision> accessor(_SubdivisionStorage.get());
+  accessor->dispatch[0]    = (patchNb + 63) / 64;
+  accessor->dispatch[1]    = 1;
+  accessor->dispatch[2]    = 1;
+  accessor->nodeNumber     = patchNb;
+  memset(accessor->draw, 0, sizeof(accessor->draw));
+  accessor->current        = 0;
+  accessor->nextNodeNumber = 0;
+  accessor->splitNumber    = 0;
+  accessor->maxLevel       = maxLevel;
+  for (uint32_t patch = 0; patch < patchNb; patch++)
+  {
+    accessor->nodes[patch][0] = patch << (2*maxLevel);
+    accessor->nodes[patch][1] = 0;
+  }
+
+  _IsSubdivisionValid = true;
+}
+
+void MxTerrain::bindSubdivision()
+{
+  // Programs already reading the storage of the instance (single terrain: bound once)
+  if (_SubdivisionStorage->getLocation() == _SubdivisionBinding)
+    return;
+
+  for (auto program : { _SubdivisionDraw, _SubdivisionClassify, _SubdivisionScan, _SubdivisionRefine, _SubdivisionFinalize, _SubdivisionCull })
+    _SubdivisionStorage->bindToProgram(program, "u_SubdivisionBlock");
+  _SubdivisionBinding = _SubdivisionStorage->getLocation();
+}
+
+void MxTerrain::computeSubdivision()
+{
+  const UxShaderStorageBase& storage = *_SubdivisionStorage;
+
+  // Nodes kept, split or merged according to the subdivision criteria (the node list persists from frame to frame)
+  _SubdivisionClassify->dispatchIndirect(storage, offsetof(u_Subdivision, dispatch));
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+  _SubdivisionScan->dispatch(1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+  _SubdivisionRefine->dispatchIndirect(storage, offsetof(u_Subdivision, dispatch));
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+  _SubdivisionFinalize->dispatch(1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+  // Visible leaves appended to the draw list (instance count of the indirect draw)
+  _SubdivisionCull->dispatchIndirect(storage, offsetof(u_Subdivision, dispatch));
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_ATOMIC_COUNTER_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+void MxTerrain::addPatch(uint32_t iI, uint32_t iJ)
+{
+  // Grid rank of the 4 patch vertices (counterclockwise), added if one of them is visible
+  uint32_t ind       = iI*(_TerrainSubdivision[1]+1)+iJ;
+  uint32_t shifts[4] = { ind, ind+_TerrainSubdivision[1]+1, ind+_TerrainSubdivision[1]+2, ind+1 };
+
+  if (_Indices[shifts[0]] != 0xFFFFFFFF || _Indices[shifts[1]] != 0xFFFFFFFF || _Indices[shifts[2]] != 0xFFFFFFFF || _Indices[shifts[3]] != 0xFFFFFFFF)
+  {
+    for (auto vi : shifts)
+      _PatchIndexBuffer.addElement(0, vi);
+  }
+}
+
+void MxTerrain::sendData(const Matrix4f& iModelMatrix, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::TerrainData);
+
+  // Alternative to static grid sent once to GPU: send a relimited part of the grid according to visibility criterion
+  // To be evaluated (ie: performance/resource consuption advantages to use CPU or GPU
+  memset(_Indices, 0xFF, (_TerrainSubdivision[0]+1)*(_TerrainSubdivision[1]+1)*sizeof(uint32_t));
+ 
+  // Browses the grid of vertices and checks visibility criterium for every one (property stored in _Indices,
+  // 0xFF: not visible and 0xFE: visible)
+  uint32_t vIndex = 0;
+  for (uint16_t i = 0; i <= _TerrainSubdivision[0]; i++)
+  {
+    for (uint16_t j = 0; j <= _TerrainSubdivision[1]; j++)
+    {
+      // Needs to transform every vertex from model to wc coordinates (is this a good trade-off CPU/GPU model matrix transformation?)
+      Vector4f vertex = iModelMatrix*Vector4f((float)i, (float)j, _VertexHeights[vIndex++], 1.0f);
+
+      // Potential need of height recomputation in case of dynamic min/max height constraints
+      if (_MinHeight != -1 || _MaxHeight != -1)
+      {
+        if (_MinHeight != -1 && (vertex[2] < _MinHeight * _HeightFactor))
+          vertex[2] = _MinHeight * _HeightFactor;
+        if (_MaxHeight != -1 && (vertex[2] > _MaxHeight * _HeightFactor))
+          vertex[2] = _MaxHeight * _HeightFactor;
+      }
+
+      // Vector from the eye point (wc) to the vertex (wc)
+      Vector3f ev = Vector3f(vertex[0] - iEyeView[0], vertex[1] - iEyeView[1], vertex[2] - iEyeView[2]);
+
+      // 1. Position of the vertex with respect to the screen plane
+      float side = ev.dotProduct(iEyeDirection);
+
+      // 2. Angle eye/vertex to eye direction: inaccurate (all the 4 vertices might be outside the solid angle and the "center"
+      // part of the patch still visible)
+      //ev.normalize();
+      //float angle = acosf(ev.dotProduct(iEyeDirection));
+      //if (angle < iAngle)
+      
+      if (side > 0)
+        _Indices[i*(_TerrainSubdivision[1]+1)+j] = 0xFFFFFFFE;
+    }
+  }
+
+  // Clears the Index Buffer prior new feeding, the indices of the visible patches being written in a region of the stream
+  // (at most 4 per patch)
+  _PatchIndexBuffer.clearVector();
+  _PatchIndexBuffer.beginStream(_PatchStream, 4 * _TerrainSubdivision[0] * _TerrainSubdivision[1], (_TerrainSubdivision[0]+1)*(_TerrainSubdivision[1]+1) - 1);
+  
+  if (_PatchOrderMode == 0)
+  {
+    // Browses the grid of patches row by row
+    for (uint16_t i = 0; i < _TerrainSubdivision[0]; i++)
+    {
+      for (uint16_t j = 0; j < _TerrainSubdivision[1]; j++)
+        addPatch(i, j);
+    }
+  }
+  else
+  {
+    // Browses the grid of patches front-to-back (better early depth test and coherent height map fetches): the 4 quadrants
+    // around the patch containing the eye (clamped to the terrain) are browsed together in Z-order of the offsets
+    int32_t nx = _TerrainSubdivision[0];
+    int32_t ny = _TerrainSubdivision[1];
+    int32_t eyeI = std::min(std::max((int32_t)floorf(iEyeView[0] * nx / _TerrainDimension[0]), 0), nx);
+    int32_t eyeJ = std::min(std::max((int32_t)floorf(iEyeView[1] * ny / _TerrainDimension[1]), 0), ny);
+
+    for (uint32_t offset : _PatchOffsets)
+    {
+      int32_t dx = offset & 0xFFFF;
+      int32_t dy = offset >> 16;
+      for (int32_t i : { eyeI + dx, eyeI - 1 - dx })
+      {
+        if (i < 0 || i >= nx)
+          continue;
+        for (int32_t j : { eyeJ + dy, eyeJ - 1 - dy })
+        {
+          if (j >= 0 && j < ny)
+            addPatch(i, j);
+        }
+      }
+    }
+  }
+
+  _PatchIndexBuffer.endStream();
+}
+
+UxProgram* MxTerrain::getVariant(UxProgramVariants* iVariants) const
+{
+  return iVariants->get(getVariantKey(), [this](std::vector<std::string>& oDefines) { getVariantDefines(oDefines); });
+}
+
+uint32_t MxTerrain::getVariantKey() const
+{
+  // Modes tested by the fill shaders (see ubo_heightmap.glsl), the wireframe being drawn by distinct programs
+  return 1 | (_SmoothMode << 1) | (_ColorMode << 4) | ((_FunctionalMode != 0.0f) << 7) | ((_IsolineStep > 0.0f) << 8) | ((_ShadowMode > 0) << 9) | (isStreamed() << 10);
+}
+
+void MxTerrain::getVariantDefines(std::vector<std::string>& oDefines) const
+{
+  oDefines = { "HM_SMOOTH_INTERPOLATION " + std::to_string(_SmoothMode),
+               std::string("HM_FUNCTIONAL ") + (_FunctionalMode != 0.0f ? "true" : "false"),
+               "HM_COLOR_MODE " + std::to_string(_ColorMode),
+               std::string("HM_ISOLINES ") + (_IsolineStep > 0.0f ? "true" : "false"),
+               std::string("HM_SHADOW ") + (_ShadowMode > 0 ? "true" : "false"),
+               std::string("HM_STREAMING ") + (isStreamed() ? "true" : "false") };
+}
+
+bool MxTerrain::isVisible(const Vector3f& iEyeView, const Vector3f& iEyeDirection) const
+{
+  // Corners of the box of the terrain (heights within [0, heightFactor])
+  for (uint32_t corner = 0; corner < 8; corner++)
+  {
+    Vector3f vertex((corner & 1) ? _TerrainDimension[0] : 0.0f, (corner & 2) ? _TerrainDimension[1] : 0.0f, (corner & 4) ? _HeightFactor : 0.0f);
+    if ((vertex - iEyeView).dotProduct(iEyeDirection) > 0)
+      return true;
+  }
+  return false;
+}
+
+uint32_t MxTerrain::getWireframePassMode() const
+{
+  if (_WireframeMode < 4)
+    return _WireframeMode;
+
+  // Borders drawn by the fill pass, otherwise by the wireframe pass as modes 1 and 3
+  if (isSinglePassWireframe())
+    return _WireframeMode == 5 ? 2 : 0;
+  else
+    return _WireframeMode == 5 ? 3 : 1;
+}
+
+void MxTerrain::render(int iTime, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle, float iPixelAngle, uint32_t& oPatchNb, uint32_t& oDrawnPatchNb, uint32_t& oTriangleNb, uint32_t& oDiscardedTriangleNb)
+{
+  // Nothing drawn until the terrain data are loaded
+  if (!updateLoading())
+  {
+    oPatchNb             = 0;
+    oDrawnPatchNb        = 0;
+    oTriangleNb          = 0;
+    oDiscardedTriangleNb = 0;
+    return;
+  }
+
+  // Terrain out of the view: nothing drawn, its textures left to the eviction of the residency manager
+  if (!isVisible(iEyeView, iEyeDirection))
+  {
+    oPatchNb             = 0;
+    oDrawnPatchNb        = 0;
+    oTriangleNb          = 0;
+    oDiscardedTriangleNb = 0;
+    return;
+  }
+
+  // Streaming: tiles of the view made resident, the ones of the predicted views prefetched (the captured terrain is
+  // stale once the indirection table changed)
+  if (isStreamed())
+  {
+    MxViewPredictor::View predictedViews[MxViewPredictor::HorizonNb];
+    _ViewPredictor.update(iTime, iEyeView, iEyeDirection);
+    uint32_t predictedViewNb = _ViewPredictor.predict(predictedViews);
+
+    if (_TileCache.update(iEyeView, iEyeDirection, predictedViews, predictedViewNb, iAngle, iPixelAngle, _TerrainDimension, _HeightFactor))
+      _IsCacheValid = false;
+  }
+
+  // Initializes report
+  reportVertex.init();
+
+  // Height map parameters of the instance
+  u_HeightMap heightMap = {};
+  heightMap.heightTextureHandle      = _HeightTextureHandle;
+  for (uint32_t level = 0; level < _HeightLevelMaxNb; level++)
+    heightMap.heightLevelHandles[2*level] = _HeightLevelHandles[level];
+  heightMap.terrainDimension         = _TerrainDimension;
+  heightMap.terrainSubdivision       = _TerrainSubdivision;
+  heightMap.heightFactor             = _HeightFactor;
+  heightMap.distortionFactor         = _DistortionFactor;
+  heightMap.maxSubdivison            = _MaxSubdivison;
+  heightMap.maxPixelSubdivisionRatio = _MaxPixelSubdivisionRatio;
+  heightMap.colorMode                = _ColorMode;
+  heightMap.heightColorMapHandle     = _HeightColorMapHandle;
+  heightMap.heightColorMapBounds     = _HeightColorMapBounds;
+  heightMap.isolineStep              = _IsolineStep;
+  heightMap.wireframeMode            = getWireframePassMode();
+  heightMap.functionalMode           = _FunctionalMode;
+  heightMap.smoothMode               = _SmoothMode;
+  heightMap.shadowMode               = _ShadowMode;
+  heightMap.minHeight                = _MinHeight;
+  heightMap.maxHeight                = _MaxHeight;
+  heightMap.heightScale              = _HeightRange[0];
+  heightMap.heightOffset             = _HeightRange[1];
+  if (isStreamed())
+  {
+    heightMap.tileTextureHandle      = _TileCache.getTextureHandle();
+    heightMap.tileTableHandle        = _TileCache.getTableHandle();
+    heightMap.mapSize                = Vector2i(_Width, _Height);
+    heightMap.levelNb                = _TileCache.getLevelNb();
+    heightMap.tileSize               = MxTileCache::TileSize;
+    heightMap.streaming              = 1;
+  }
+
+  // Textures sampled by the draws made resident
+  if (_HeightTextureHandle)
+    UxResidencyManager::use(_HeightTextureHandle);
+  for (uint32_t level = 0; level < _HeightLevelMaxNb; level++)
+  {
+    if (_HeightLevelHandles[level])
+      UxResidencyManager::use(_HeightLevelHandles[level]);
+  }
+  UxResidencyManager::use(_HeightColorMapHandle);
+  if (isStreamed())
+  {
+    UxResidencyManager::use(_TileCache.getTextureHandle());
+    UxResidencyManager::use(_TileCache.getTableHandle());
+  }
+
+  // Update uniform blocks (positionning and height map parameters)
+  Matrix4f modelMatrix = Matrix4f::createScale(_TerrainDimension[0] / _TerrainSubdivision[0], _TerrainDimension[1] / _TerrainSubdivision[1], 1.f);
+  {
+    UxUniformBlockDataAccessor<u_Positionning> accessorP(UxGLObjects::getUniformBlock(_PositionningBlock));
+    accessorP->model = modelMatrix;
+
+    UxUniformBlockDataAccessor<u_HeightMap> accessorM(UxGLObjects::getUniformBlock(_HeightMapBlock));
+    *accessorM = heightMap;
+  }
+
+  // The cached terrain is valid while the camera, the light and the height map parameters are unchanged
+  // (the model matrix only depends on the height map parameters)
+  uint64_t viewingRevision  = UxGLObjects::getUniformBlock(_ViewingBlock)->getRevision();
+  uint64_t lightingRevision = UxGLObjects::getUniformBlock(_LightingBlock)->getRevision();
+  bool useCache = _PipelineMode == 0 && _CacheMode == 1 && !isSinglePassWireframe() && _IsCacheValid && _CacheFeedback.isCaptured()
+               && viewingRevision == _CachedViewingRevision && lightingRevision == _CachedLightingRevision
+               && memcmp(&heightMap, &_CachedHeightMap, sizeof(u_HeightMap)) == 0;
+
+  // Back-face culling managed (almost completely) by tesselation control and geometry shaders
+  //glEnable(GL_CULL_FACE);
+  
+  UxGLState::enable(GL_DEPTH_TEST);
+  glPatchParameteri(GL_PATCH_VERTICES, 4);
+
+  oPatchNb = _TerrainSubdivision[0] * _TerrainSubdivision[1];
+
+  if (useCache)
+  {
+    // Draws the triangles captured during the last full pipeline execution
+    _CachedTriangleDraw->drawCapture(GL_TRIANGLES, _CacheVertexArray, _CacheFeedback);
+  }
+  else if (_PipelineMode == 1)
+  {
+    // Initializes atomic counters (leaf triangles drawn and culled)
+    _TriangleCounter->set(0);
+    _DiscardedTriangleCounter->set(0);
+
+    if (!_IsSubdivisionValid)
+      initSubdivision();
+    bindSubdivision();
+
+    // Updates the subdivision and draws the leaf grid of every visible node, back faces culled by the fixed pipeline
+    computeSubdivision();
+    oDrawnPatchNb = oPatchNb;
+
+    UxGLState::enable(GL_CULL_FACE);
+    glFrontFace(GL_CCW);
+    _SubdivisionDraw->drawIndirect(GL_TRIANGLES, _SubdivisionGridArray, _SubdivisionGridIndexBuffer, *_SubdivisionStorage, offsetof(u_Subdivision, draw));
+    UxGLState::disable(GL_CULL_FACE);
+  }
+  else
+  {
+    // Initializes atomic counters
+    _TriangleCounter->set(0);
+    _DiscardedTriangleCounter->set(0);
+
+    // Builds vertex/index data to send to the pipeline
+    sendData(modelMatrix, Vector3f(iEyeView[0], iEyeView[1], iEyeView[2]), iEyeDirection, iAngle);
+
+    // Stores the patch number sent to draw
+    oDrawnPatchNb = _PatchIndexBuffer.getBufferSize() / 4;
+
+    // Draw terrain patches, capturing the resulting triangles if the cache is active
+    if (_PipelineMode == 2)
+    {
+      // Back faces culled by the fixed pipeline, the patches out of the frustum by the TCS
+      UxGLState::enable(GL_CULL_FACE);
+      glFrontFace(GL_CCW);
+      getVariant(_ShadedPatchDraw)->draw(GL_PATCHES, _PatchIndexBuffer);
+      UxGLState::disable(GL_CULL_FACE);
+    }
+    else if (isSinglePassWireframe())
+    {
+      // Patch and triangle borders drawn by the fragment shader of the fill pass
+      getVariant(_EdgeTriangleDraw)->draw(GL_PATCHES, _PatchIndexBuffer);
+    }
+    else if (_CacheMode == 1)
+    {
+      // Capture buffer sized from the last triangle number (the capture is discarded in case of overflow)
+      uint32_t neededCapacity = 3 * _CachedTriangleNb;
+      if (_CacheCapacity == 0 || _CacheCapacity < neededCapacity)
+      {
+        _CacheCapacity = std::max(neededCapacity + neededCapacity / 4, 3u * 65536u);
+        _CacheVertexArray.reserve(_CacheCapacity, GL_DYNAMIC_COPY);
+        _CacheFeedback.attach(_CacheVertexArray);
+      }
+
+      getVariant(_TriangleDraw)->drawAndCapture(GL_PATCHES, _PatchIndexBuffer, _CacheFeedback, GL_TRIANGLES);
+    }
+    else
+      getVariant(_TriangleDraw)->draw(GL_PATCHES, _PatchIndexBuffer);
+  }
+
+  if (heightMap.wireframeMode > 0 && _PipelineMode != 1)
+  {
+    // Draws wireframe patch borders and/or normals
+    glLineWidth(1.0f);
+    _WireframeDraw->draw(GL_PATCHES, _PatchIndexBuffer);
+  }
+
+  // Patch indices of the frame protected until the draws are executed
+  _PatchStream.fence();
+
+  if (_MapMode == 1 && !isStreamed())
+  {
+    // Draws grid of points of the height map
+    UxGLState::enable(GL_PROGRAM_POINT_SIZE);
+    _PointMapDraw->draw(GL_POINTS, _Width*_Height);
+  }
+  else if (_MapMode == 2 && !isStreamed())
+  {
+    // Draws wireframe grid of the height map
+    glLineWidth(1.0f);
+    _WireframeMapDraw->draw(GL_LINES, 2*((_Width - 1)*_Height + _Width*(_Height - 1)));
+  }
+
+  //glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    
+  if (!useCache)
+  {
+    // Stores triangle numbers (displayed and discared by the pipeline)
+    _CachedDrawnPatchNb        = oDrawnPatchNb;
+    _CachedTriangleNb          = _TriangleCounter->get();
+    _CachedDiscardedTriangleNb = _DiscardedTriangleCounter->get();
+
+    // Validates the capture (complete if the buffer was large enough)
+    _IsCacheValid = _PipelineMode == 0 && _CacheMode == 1 && !isSinglePassWireframe() && 3 * _CachedTriangleNb <= _CacheCapacity;
+    _CachedViewingRevision  = viewingRevision;
+    _CachedLightingRevision = lightingRevision;
+    _CachedHeightMap        = heightMap;
+  }
+
+  oDrawnPatchNb        = _CachedDrawnPatchNb;
+  oTriangleNb          = _CachedTriangleNb;
+  oDiscardedTriangleNb = _CachedDiscardedTriangleNb;
+
+  // Map the report to be able to dump the content during debug session
+  reportVertex.map();
+  uint32_t vertexCounter = reportVertex.getRecordNumber();
+  auto table = reportVertex.getRecords();
+  reportVertex.unmap();
+}
@@ -1,163 +1,331 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include <gl/glew.h>
-#include <vmath.h>
-
-#include "MxSceneObject.h"
-#include "UxVertexArray.h"
-#include "UxAtomicCounter.h"
-
-class UxProgram;
-
-
-//========================================================================
-//  Height Map Terrain Model:
-//    Manages an instance representation throug a set of subidvided
-//    patches. Tunning/debugging capabilities. Animations capabilities.
-//========================================================================
-
-class MxTerrain: public MxSceneObject
-{
-public:
-  
-  // Height map uniform block structure
-  struct u_HeightMap
-  {
-    GLuint64  heightTextureHandle;      // Bindless texture (assumption: only first component, r, considered for height valuation). Rem: height could be also coded with rb or rbga combination 
-    Vector2f  terrainDimension;         // Size (WC) of the terrain
-    Vector2i  terrainSubdivision;       // Number of unitary patches in x and y directions
-    float     heightFactor;             // Factor applied to heigth texture
-    float     distortionFactor;         // Factor applied to patch height distortion to determine the subdivision level
-    float     maxSubdivison;            // Max number of subdivision of each side of patch (tesselation process)
-    float     maxPixelSubdivisionRatio; // Subdivision factor based on edge dimension on screen
-    GLuint64  heightColorMapHandle;     // Bindless texture for color map (color=fct(height))
-    Vector2f  heightColorMapBounds;     // Parameters to apply color map
-    uint32_t  colorMode;                // Color mode (luminance, color map)
-    float     isolineStep;              // Height between isolines
-    uint32_t  wireframeMode;            // Optional wireframe border and normals display (0: none, 1: patch borders, 2: patch and tesselated triangles borders, 3: triangle and normals computed from map, 4: 2+3)
-    float     functionalMode;           // Polynomial function to replace the map height texture to allow neutralize bugs in height and associated normalcomputation
-    uint32_t  smoothMode;               // Mode of interpolation (Linear+Constant, Linear+Linear or Bicubic)
-    uint32_t  shadowMode;               // Shadow mode, alternate method to shadow mapping, unsatisfactory 
-    float     minHeight;                // Trim height trough minimum value
-    float     maxHeight;                // Trim height trough maximum value
-    Vector2f  _alignment;
-  };
-
-private:
-
-  // Model positionning uniform block structure
-  struct u_Positionning
-  {
-    Matrix4f  model;
-  };
-
-  // Vertex data structure for terrain draw
-  struct TerrainVertexData
-  {
-    float position[4];
-    float uv[2];
-    float color[4];
-  };
-
-  // Vertex data structure for map draw
-  struct MapVertexData
-  {
-    float   position[2];
-    int32_t uv[2];
-  };
-
-private:
-
-  // Static initialisations (programs, shaders, counters...)
-  static void Startup();
-  static bool               _Startup;
-  static UxProgram*         _TriangleDraw;
-  static UxProgram*         _WireframeDraw;
-  static UxProgram*         _PointMapDraw;
-  static UxProgram*         _WireframeMapDraw;
-  static UxAtomicCounter*   _TriangleCounter;
-  static UxAtomicCounter*   _DiscardedTriangleCounter;
-
-protected:
-
-  // Parameters defining the instance geometry
-  Vector2f     _TerrainDimension;         // Size (WC) of the terrain
-  Vector2i     _TerrainSubdivision;       // Number of unitary patches in x and y directions
-  float        _HeightFactor;             // Factor applied to heigth texture
-  float        _DistortionFactor;         // Factor of subdivions based upon height distortion within patch
-  float        _MaxSubdivison;            // Max number of subdivision of each side of a patch (tesselation process)
-  float        _MaxPixelSubdivisionRatio; // Ratio to determine tesselation factor according number of pixel on the viewport
-  float        _FunctionalMode;
-
-  // Parameters defining the instance representation (corresponding to u_HeightMap uniform structure)
-  std::string  _HeightMapTexturePath;
-  std::string  _HeightColorMapTexturePath;
-  uint32_t     _ColorMode;
-  Vector2f     _HeightColorMapBounds;
-  float        _IsolineStep;
-  uint32_t     _SmoothMode;
-  uint32_t     _ShadowMode;
-  float        _MinHeight;
-  float        _MaxHeight;
-
-  // Parameters for additionnal representations
-  uint32_t     _WireframeMode;             // Display patch and triangle borders and normals
-  uint32_t     _MapMode;                   // Optional map display (0: none, 1: points for each pixel with corresponding height, 2: wireframe grid)
-
-  // Textures data
-  GLuint       _HeightMapTextureName;
-  GLuint64     _HeightTextureHandle;
-  GLuint       _HeightColorMapTextureName;
-  GLuint64     _HeightColorMapHandle;
-  
-  // Terrain data
-  int32_t                           _Width;
-  int32_t                           _Height;
-  std::vector<TerrainVertexData>    _Vertices;
-  uint32_t*                         _Indices;
-
-  // Data sent to Vertex shader for patch draw (triangles and wireframe)
-  UxVertexArray<TerrainVertexData>  _PatchVertexArray;
-  UxIndexBuffer                     _PatchIndexBuffer;
-
-  // Data sent to Vertex Shader for map draw (points and wireframe)
-  UxVertexArray<MapVertexData>      _MapVertexArray; 
-  UxIndexBuffer                     _PointMapIndexBuffer;
-  UxIndexBuffer                     _WireframeMapIndexBuffer;
-
-public:
-
-  MxTerrain();
-  ~MxTerrain();
-  __DeclareDeletedCtorsAndAssignments(MxTerrain)
-
-  float getHeightFactor() const { return _HeightFactor; }
-
-  void init(const Vector2f& iTerrainDimension, const Vector2i& iTerrainSubdivision, float iHeightFactor, float iMaxSubdivison, float iMaxPixelSubdivisionRatio, const std::string& iHeightMapTexturePath, const std::string& iHeightColorMapTexturePath, const Vector2f& iHeightColorMapBounds);
-
-  void setFunctionalMode(float iFunctionalMode) { _FunctionalMode = iFunctionalMode;  }
-  void setColorMode(uint32_t iColorMode) { __AssertIfNot(iColorMode >=0 && iColorMode <= 2, "Invalid Color Mode");  _ColorMode = iColorMode; }
-  void setHeightColorMapBounds(Vector2f iHeightColorMapBounds) { __AssertIfNot(iHeightColorMapBounds[0] >= 0 && iHeightColorMapBounds[0] < iHeightColorMapBounds[1], "Invalid Color Map Bounds");  _HeightColorMapBounds = iHeightColorMapBounds; }
-  void setIsolineStep(float iIsolineStep) { __AssertIfNot(iIsolineStep >= 0.0f, "Invalid Isoline step");  _IsolineStep = iIsolineStep; }
-  void setSmoothMode(uint32_t iSmoothMode) { __AssertIfNot(iSmoothMode >= 0 && iSmoothMode <=3, "Invalid Smooth Mode"); _SmoothMode = iSmoothMode; }
-  void setWireframeMode(uint32_t iWireframeMode) { __AssertIfNot(iWireframeMode >= 0 && iWireframeMode <= 3, "Invalid Wireframe Mode"); _WireframeMode = iWireframeMode; }
-  void setMapMode(uint32_t iMapMode) { __AssertIfNot(iMapMode >= 0 && iMapMode <= 2, "Invalid Map Mode"); _MapMode = iMapMode; }
-  void setShadowMode(uint32_t iShadowMode) { __AssertIfNot(iShadowMode >= 0 && iShadowMode <= 4, "Invalid Shadow Mode"); _ShadowMode = iShadowMode; }
-  void setMinHeight(float iMinHeight) { _MinHeight = iMinHeight; }
-  void setMaxHeight(float iMaxHeight) { _MaxHeight = iMaxHeight; }
-  void setDistortionFactor(float iDistortionFactor) { _DistortionFactor = iDistortionFactor; }
-
-protected:
-
-  void sendData(const Matrix4f& iModelMatrix, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle);
-  void render(int iTime, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle, uint32_t& oPatchNb, uint32_t& oDrawnPatchNb, uint32_t& oTriangleNb, uint32_t& oDiscardedTriangleNb);
-
-  void generateTerrainData();
-  void generateMapData();
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include <gl/glew.h>
+#include <vmath.h>
+
+#include "MxSceneObject.h"
+#include "UxVertexArray.h"
+#include "UxAtomicCounter.h"
+#include "UxTransformFeedback.h"
+#include "UxStreamBuffer.h"
+#include "UxUniformBlock.h"
+#include "UxShaderStorage.h"
+#include "UxHandle.h"
+#include "UxUtils.h"
+#include "MxHeightField.h"
+#include "MxTerrainAsset.h"
+#include "MxTileCache.h"
+#include "MxViewPredictor.h"
+
+#include <future>
+#include <memory>
+
+class UxProgram;
+class UxProgramVariants;
+class UxThreadPool;
+class UxUploadTicket;
+
+
+//========================================================================
+//  Height Map Terrain Model:
+//    Manages an instance representation throug a set of subidvided
+//    patches. Tunning/debugging capabilities. Animations capabilities.
+//========================================================================
+
+class MxTerrain: public MxSceneObject
+{
+public:
+  
+  // Height map uniform block structure (see ubo_heightmap.glsl)
+  static const uint32_t _HeightLevelMaxNb = 16;
+  struct u_HeightMap
+  {
+    GLuint64  heightTextureHandle;      // Bindless texture, single channel (R8, R16, R16F or R32F)
+    Vector2f  terrainDimension;         // Size (WC) of the terrain
+    Vector2i  terrainSubdivision;       // Number of unitary patches in x and y directions
+    float     heightFactor;             // Factor applied to heigth texture
+    float     distortionFactor;         // Factor applied to patch height distortion to determine the subdivision level
+    float     maxSubdivison;            // Max number of subdivision of each side of patch (tesselation process)
+    float     maxPixelSubdivisionRatio; // Subdivision factor based on edge dimension on screen
+    GLuint64  heightColorMapHandle;     // Bindless texture for color map (color=fct(height))
+    Vector2f  heightColorMapBounds;     // Parameters to apply color map
+    uint32_t  colorMode;                // Color mode (luminance, color map)
+    float     isolineStep;              // Height between isolines
+    uint32_t  wireframeMode;            // Optional wireframe border and normals display (0: none, 1: patch borders, 2: patch and tesselated triangles borders, 3: triangle and normals computed from map, 4: 2+3)
+    float     functionalMode;           // Polynomial function to replace the map height texture to allow neutralize bugs in height and associated normalcomputation
+    uint32_t  smoothMode;               // Mode of interpolation (Linear+Constant, Linear+Linear or Bicubic)
+    uint32_t  shadowMode;               // Shadow mode, alternate method to shadow mapping, unsatisfactory 
+    float     minHeight;                // Trim height trough minimum value
+    float     maxHeight;                // Trim height trough maximum value
+    float     heightScale;              // Remapping of the texture values to [0,1] (elevations of the float formats)
+    float     heightOffset;
+    GLuint64  tileTextureHandle;        // Streaming: texture array of the resident tiles
+    GLuint64  tileTableHandle;          // Streaming: indirection table
+    Vector2i  mapSize;                  // Streaming: size of the height map
+    uint32_t  levelNb;                  // Streaming: number of mip levels
+    uint32_t  tileSize;                 // Streaming: texels of a tile without its borders
+    uint32_t  streaming;                // Height map streamed by tiles
+    uint32_t  _alignment[3];
+    GLuint64  heightLevelHandles[2*_HeightLevelMaxNb]; // Views of the mip levels gathered one by one (std140 array: a handle every 16 bytes)
+  };
+
+  // Steps of the asynchronous loading (initAsync), advanced by the rendering thread
+  enum LoadingState
+  {
+    Unloaded,
+    Decoding,     // Maps decoded and CPU data derived by the loading pool
+    Uploading,    // Textures created and filled by the upload thread
+    Ready         // Data handed over to the terrain, drawn from now on
+  };
+
+private:
+
+  // Model positionning uniform block structure
+  struct u_Positionning
+  {
+    Matrix4f  model;
+  };
+
+  // Vertex data structure captured at the output of the geometry shader (cache of the tesselated terrain)
+  struct CachedVertexData
+  {
+    float position[4];
+    float color[4];
+    float height;
+    float screenHeightGradient;
+  };
+
+  // Vertex data structure of the leaf grid (GPU subdivision), indices (i,j) of the grid vertex
+  struct GridVertexData
+  {
+    float position[4];
+  };
+
+  // Storage of the adaptive subdivision computed on GPU (see ssbo_subdivision.glsl)
+  static const uint32_t _SubdivisionNodeCapacity = 65536;
+  static const uint32_t _SubdivisionGridSize     = 8;
+  struct u_Subdivision
+  {
+    uint32_t  dispatch[3];                                 // DispatchIndirectCommand of the passes over the current list
+    uint32_t  nodeNumber;                                  // Number of nodes of the current list
+    uint32_t  draw[5];                                     // DrawElementsIndirectCommand of the leaf grid
+    uint32_t  current;                                     // Current node list (0 or 1)
+    uint32_t  nextNodeNumber;                              // Number of nodes of the list under construction
+    uint32_t  splitNumber;                                 // Nodes added by the splits of the frame
+    uint32_t  maxLevel;                                    // Max subdivision level of a patch
+    uint32_t  _alignment[3];
+    uint32_t  nodes[2*_SubdivisionNodeCapacity][2];        // Both node lists of (key, level)
+    uint32_t  actions[_SubdivisionNodeCapacity];
+    uint32_t  offsets[_SubdivisionNodeCapacity];
+    uint32_t  drawList[_SubdivisionNodeCapacity][4];       // Visible nodes (key, level, neighbour levels, 0)
+  };
+
+private:
+
+  // Static initialisations (programs, shaders, counters...)
+  static void Startup();
+  static bool               _Startup;
+  static UxProgramVariants* _TriangleDraw;              // Fill programs specialized by the render modes (see getVariantDefines)
+  static UxProgram*         _CachedTriangleDraw;
+  static UxProgramVariants* _ShadedPatchDraw;
+  static UxProgramVariants* _EdgeTriangleDraw;
+  static UxProgram*         _WireframeDraw;
+  static UxProgram*         _PointMapDraw;
+  static UxProgram*         _WireframeMapDraw;
+  static UxProgram*         _SubdivisionDraw;
+  static UxProgram*         _SubdivisionClassify;
+  static UxProgram*         _SubdivisionScan;
+  static UxProgram*         _SubdivisionRefine;
+  static UxProgram*         _SubdivisionFinalize;
+  static UxProgram*         _SubdivisionCull;
+  static GLuint             _SubdivisionBinding;        // Binding point of the subdivision storage read by the programs
+  static uint32_t           _SubdivisionStorageNb;      // Storages created (unique names)
+  static UxAtomicCounter*   _TriangleCounter;
+  static UxAtomicCounter*   _DiscardedTriangleCounter;
+  static UxThreadPool*      _LoadingPool;               // Decoding and CPU derivations of the terrain data
+
+  // Uniform blocks and storage used every frame (registered or looked up by name at startup)
+  static UxHandle<UxUniformBlock<u_HeightMap>>     _HeightMapBlock;
+  static UxHandle<UxUniformBlock<u_Positionning>>  _PositionningBlock;
+  static UxHandle<UxUniformBlockBase>              _ViewingBlock;
+  static UxHandle<UxUniformBlockBase>              _LightingBlock;
+
+protected:
+
+  // Parameters defining the instance geometry
+  Vector2f     _TerrainDimension;         // Size (WC) of the terrain
+  Vector2i     _TerrainSubdivision;       // Number of unitary patches in x and y directions
+  float        _HeightFactor;             // Factor applied to heigth texture
+  float        _DistortionFactor;         // Factor of subdivions based upon height distortion within patch
+  float        _MaxSubdivison;            // Max number of subdivision of each side of a patch (tesselation process)
+  float        _MaxPixelSubdivisionRatio; // Ratio to determine tesselation factor according number of pixel on the viewport
+  float        _FunctionalMode;
+
+  // Parameters defining the instance representation (corresponding to u_HeightMap uniform structure)
+  std::string  _HeightMapTexturePath;
+  std::string  _HeightColorMapTexturePath;
+  uint32_t     _ColorMode;
+  Vector2f     _HeightColorMapBounds;
+  float        _IsolineStep;
+  uint32_t     _SmoothMode;
+  uint32_t     _ShadowMode;
+  float        _MinHeight;
+  float        _MaxHeight;
+
+  // Parameters for additionnal representations
+  uint32_t     _WireframeMode;             // Display patch and triangle borders and normals (4, 5: borders drawn by the fill pass, as 1, 3 otherwise)
+  uint32_t     _MapMode;                   // Optional map display (0: none, 1: points for each pixel with corresponding height, 2: wireframe grid)
+  uint32_t     _CacheMode;                 // Tesselated terrain cache (0: pipeline run every frame, 1: captured triangles redrawn while nothing changes)
+  uint32_t     _PatchOrderMode;            // Order of the patches sent to draw (0: row-major, 1: front-to-back from the eye)
+  uint32_t     _PipelineMode;              // Subdivision of the patches (0: hardware tesselation, 1: adaptive subdivision computed on GPU, 2: hardware tesselation without geometry shader)
+
+  // Textures data
+  GLuint       _HeightMapTextureName;
+  GLuint64     _HeightTextureHandle;
+  GLenum       _HeightFormat;               // Internal format of the height map (R8, R16, R16F or R32F)
+  Vector2f     _HeightRange;                // Scale and offset remapping the height map values to [0,1]
+  GLuint       _HeightColorMapTextureName;
+  GLuint64     _HeightColorMapHandle;
+  GLuint       _HeightLevelTextureNames[_HeightLevelMaxNb]; // Views of the mip levels of the height map (none for level 0)
+  GLuint64     _HeightLevelHandles[_HeightLevelMaxNb];
+  
+  // Terrain data
+  int32_t                           _Width;
+  int32_t                           _Height;
+  MxHeightField                     _HeightField;     // CPU heights of the map (tiled for the neighbourhood reads)
+  std::vector<float>                _VertexHeights;   // Height of the patch vertices (grid of the terrain subdivision)
+  uint32_t*                         _Indices;
+  std::vector<uint32_t>             _PatchOffsets;    // Patch offsets (dx | dy<<16) from the eye patch, in Z-order (front-to-back browse)
+
+  // Data sent to Vertex shader for patch draw (triangles and wireframe): grid rank of the patch vertices,
+  // position and height map coordinates being derived by the vertex shader (no vertex buffer). The visible
+  // patches being rebuilt every frame, the indices are written directly into a stream buffer.
+  UxIndexBuffer                     _PatchIndexBuffer;
+  UxStreamBuffer                    _PatchStream;
+
+  // Cache of the tesselated terrain, invalidated by any change of camera, light or height map parameters
+  UxVertexArray<CachedVertexData>   _CacheVertexArray;
+  UxTransformFeedback               _CacheFeedback;
+  uint32_t                          _CacheCapacity;             // Number of vertices the capture buffer can hold
+  bool                              _IsCacheValid;
+  uint64_t                          _CachedViewingRevision;     // Revisions of the scene uniform blocks at capture time
+  uint64_t                          _CachedLightingRevision;
+  u_HeightMap                       _CachedHeightMap;           // Height map parameters at capture time
+  uint32_t                          _CachedDrawnPatchNb;        // Statistics of the captured frame
+  uint32_t                          _CachedTriangleNb;
+  uint32_t                          _CachedDiscardedTriangleNb;
+
+  // Asynchronous loading: decoded maps and textures under construction, handed over once the upload is complete
+  LoadingState                      _LoadingState;
+  std::future<void>                 _DecodingTask;
+  std::shared_ptr<UxUploadTicket>   _UploadTicket;
+  UxUtils::HeightImage              _DecodedHeightMap;
+  UxUtils::Image                    _DecodedColorMap;
+  bool                              _IsUploadedByStrips;        // Height map uploaded while decoded (upload thread started)
+  MxTerrainAsset                    _Asset;                     // Baked asset mapped instead of the decoded map (".hmt" path)
+  MxTileCache                       _TileCache;                 // Tiles of the asset streamed under budgets (released before the asset)
+  uint64_t                          _TileGPUBudget;             // Streaming budgets (bytes), 0: whole height map uploaded
+  uint64_t                          _TileCPUBudget;
+  Vector2i                          _RawSize;                   // Dimensions of a raw height map (0: square)
+  bool                              _IsStreamed;
+  MxViewPredictor                   _ViewPredictor;             // Views ahead whose tiles are prefetched
+  GLuint                            _LoadedTextureNames[2];     // Height map and color map
+  GLuint64                          _LoadedTextureHandles[2];
+
+  // Leaf grid drawn for every visible node of the GPU subdivision
+  UxVertexArray<GridVertexData>     _SubdivisionGridArray;
+  UxIndexBuffer                     _SubdivisionGridIndexBuffer;
+
+  // Node lists of the GPU subdivision of the instance (created at its first use), root nodes loaded again if not valid
+  std::unique_ptr<UxShaderStorage<u_Subdivision>>  _SubdivisionStorage;
+  bool                                             _IsSubdivisionValid;
+
+public:
+
+  MxTerrain();
+  ~MxTerrain();
+  __DeclareDeletedCtorsAndAssignments(MxTerrain)
+
+  float getHeightFactor() const { return _HeightFactor; }
+
+  // Height map decoded (image file) or mapped (asset baked by MxTerrainAsset::bake). Returns once the terrain is loaded.
+  void init(const Vector2f& iTerrainDimension, const Vector2i& iTerrainSubdivision, float iHeightFactor, float iMaxSubdivison, float iMaxPixelSubdivisionRatio, const std::string& iHeightMapTexturePath, const std::string& iHeightColorMapTexturePath, const Vector2f& iHeightColorMapBounds, GLenum iHeightFormat = 0);
+  // Returns immediately, the terrain being drawn once loaded (nothing drawn meanwhile)
+  void initAsync(const Vector2f& iTerrainDimension, const Vector2i& iTerrainSubdivision, float iHeightFactor, float iMaxSubdivison, float iMaxPixelSubdivisionRatio, const std::string& iHeightMapTexturePath, const std::string& iHeightColorMapTexturePath, const Vector2f& iHeightColorMapBounds, GLenum iHeightFormat = 0);
+
+  // Height map of a baked asset streamed by tiles under GPU and CPU budgets (bytes), taken into account by the next init.
+  // The map modes are not drawn while streaming (one vertex per texel).
+  void setStreamingBudgets(uint64_t iGPUBudget, uint64_t iCPUBudget) { _TileGPUBudget = iGPUBudget; _TileCPUBudget = iCPUBudget; }
+  bool isStreamed() const { return _TileCache.isCreated(); }
+  // Dimensions of a headerless raw height map, taken into account by the next init (0: square map)
+  void setRawSize(const Vector2i& iRawSize) { _RawSize = iRawSize; }
+  // Camera path of the animations (prefetch along the path, extrapolated from the camera moves otherwise)
+  void setViewPathPredictor(const MxViewPredictor::PathPredictor& iPathPredictor) { _ViewPredictor.setPathPredictor(iPathPredictor); }
+  const MxTileCache::Statistics& getTileStatistics() const { return _TileCache.getStatistics(); }
+
+  LoadingState getLoadingState() const { return _LoadingState; }
+  bool         isReady() const { return _LoadingState == Ready; }
+  const char*  getLoadingStage() const;
+  // Advances the loading (rendering thread, called by render), iWait blocking until it is complete. Returns true once ready.
+  bool         updateLoading(bool iWait = false);
+
+  void setFunctionalMode(float iFunctionalMode) { _FunctionalMode = iFunctionalMode;  }
+  void setColorMode(uint32_t iColorMode) { __AssertIfNot(iColorMode >=0 && iColorMode <= 2, "Invalid Color Mode");  _ColorMode = iColorMode; }
+  void setHeightColorMapBounds(Vector2f iHeightColorMapBounds) { __AssertIfNot(iHeightColorMapBounds[0] >= 0 && iHeightColorMapBounds[0] < iHeightColorMapBounds[1], "Invalid Color Map Bounds");  _HeightColorMapBounds = iHeightColorMapBounds; }
+  void setIsolineStep(float iIsolineStep) { __AssertIfNot(iIsolineStep >= 0.0f, "Invalid Isoline step");  _IsolineStep = iIsolineStep; }
+  void setSmoothMode(uint32_t iSmoothMode) { __AssertIfNot(iSmoothMode >= 0 && iSmoothMode <=3, "Invalid Smooth Mode"); _SmoothMode = iSmoothMode; }
+  void setWireframeMode(uint32_t iWireframeMode) { __AssertIfNot(iWireframeMode >= 0 && iWireframeMode <= 5, "Invalid Wireframe Mode"); _WireframeMode = iWireframeMode; }
+  void setMapMode(uint32_t iMapMode) { __AssertIfNot(iMapMode >= 0 && iMapMode <= 2, "Invalid Map Mode"); _MapMode = iMapMode; }
+  void setShadowMode(uint32_t iShadowMode) { __AssertIfNot(iShadowMode >= 0 && iShadowMode <= 4, "Invalid Shadow Mode"); _ShadowMode = iShadowMode; }
+  void setMinHeight(float iMinHeight) { _MinHeight = iMinHeight; }
+  void setMaxHeight(float iMaxHeight) { _MaxHeight = iMaxHeight; }
+  void setDistortionFactor(float iDistortionFactor) { _DistortionFactor = iDistortionFactor; }
+  void setCacheMode(uint32_t iCacheMode) { __AssertIfNot(iCacheMode >= 0 && iCacheMode <= 1, "Invalid Cache Mode"); _CacheMode = iCacheMode; }
+  void setPatchOrderMode(uint32_t iPatchOrderMode) { __AssertIfNot(iPatchOrderMode >= 0 && iPatchOrderMode <= 1, "Invalid Patch Order Mode"); _PatchOrderMode = iPatchOrderMode; }
+  void setPipelineMode(uint32_t iPipelineMode) { __AssertIfNot(iPipelineMode >= 0 && iPipelineMode <= 2, "Invalid Pipeline Mode"); _PipelineMode = iPipelineMode; }
+
+protected:
+
+  void sendData(const Matrix4f& iModelMatrix, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle);
+  void render(int iTime, const Vector3f& iEyeView, const Vector3f& iEyeDirection, float iAngle, float iPixelAngle, uint32_t& oPatchNb, uint32_t& oDrawnPatchNb, uint32_t& oTriangleNb, uint32_t& oDiscardedTriangleNb);
+
+  void completeLoading();
+  // Texture and its handle forgotten by the residency manager and the memory registry, then deleted (none: no effect)
+  static void releaseTexture(GLuint& ioTextureName, GLuint64& ioTextureHandle);
+  // Single level views of the height map mip chain (textureGather reading the base level only)
+  void createHeightLevelViews();
+  void releaseHeightLevelViews();
+  // Terrain box in front of the screen plane (criterion of the patches sent, see sendData)
+  bool isVisible(const Vector3f& iEyeView, const Vector3f& iEyeDirection) const;
+
+  // CPU side only (run by the loading pool)
+  void loadHeightField(GLenum iHeightFormat);
+  void generateHeightData();
+  void generateTerrainData();
+  // GL side of the generated data (rendering thread): attributes of the cache linked
+  void storeGeneratedData();
+
+  void addPatch(uint32_t iI, uint32_t iJ);
+  void generateSubdivisionData();
+
+  void initSubdivision();
+  // Binds the subdivision storage of the instance to the subdivision programs
+  void bindSubdivision();
+  void computeSubdivision();
+
+  // Borders drawn by the fill pass (requires the geometry shader of the hardware tesselation pipeline)
+  bool isSinglePassWireframe() const { return _PipelineMode == 0 && _WireframeMode >= 4; }
+  // Mode of the wireframe pass (0: none, 1: borders, 2: normals, 3: both)
+  uint32_t getWireframePassMode() const;
+  // Variant of the fill programs for the current render modes (branches resolved at compile time), identified by the
+  // key of the modes, the defines being only built when the key changes
+  UxProgram* getVariant(UxProgramVariants* iVariants) const;
+  uint32_t   getVariantKey() const;
+  void       getVariantDefines(std::vector<std::string>& oDefines) const;
 };
\ No newline at end of file
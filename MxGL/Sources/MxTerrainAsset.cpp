@@ -0,0 +1,294 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "MxTerrainAsset.h"
+#include "MxHeightField.h"
+
+#include "UxError.h"
+#include "UxResidencyManager.h"
+#include "UxGPUMemoryRegistry.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <cfloat>
+#include <vector>
+
+MxTerrainAsset::MxTerrainAsset()
+{
+  _Header = nullptr;
+}
+
+bool MxTerrainAsset::isAssetPath(const std::string& iPath)
+{
+  size_t dot = iPath.find_last_of('.');
+  if (dot == std::string::npos)
+    return false;
+
+  std::string extension = iPath.substr(dot);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  return extension == ".hmt";
+}
+
+bool MxTerrainAsset::bake(const UxUtils::HeightImage& iImage, const std::string& iPath)
+{
+  assert(iImage.width > 0 && iImage.height > 0);
+
+  Header header = {};
+  memcpy(header.magic, "HMTA", 4);
+  header.version        = Version;
+  header.width          = iImage.width;
+  header.height         = iImage.height;
+  header.internalFormat = iImage.internalFormat;
+  header.type           = iImage.type;
+  header.range[0]       = iImage.range[0];
+  header.range[1]       = iImage.range[1];
+  header.fieldLayout    = MxHeightField::Morton;
+
+  // Mip chain of the texture: every sample averages the 2x2 samples of the previous level (rows in parallel)
+  uint32_t sampleSize = UxUtils::getTypeSize(iImage.type);
+  std::vector<std::vector<uint8_t>> levels(1, iImage.samples);
+  while ((std::max(iImage.width, iImage.height) >> levels.size()) > 0)
+  {
+    uint32_t width       = std::max(iImage.width >> (levels.size() - 1), 1u);
+    uint32_t height      = std::max(iImage.height >> (levels.size() - 1), 1u);
+    uint32_t levelWidth  = std::max(width / 2, 1u);
+    uint32_t levelHeight = std::max(height / 2, 1u);
+    const std::vector<uint8_t>& source = levels.back();
+    std::vector<uint8_t> target((size_t)levelWidth*levelHeight*sampleSize);
+
+    UxUtils::parallelFor(0, levelHeight, [&](uint32_t iRow)
+    {
+      uint32_t rows[2] = { std::min(2*iRow, height-1), std::min(2*iRow+1, height-1) };
+      for (uint32_t column = 0; column < levelWidth; column++)
+      {
+        uint32_t columns[2] = { std::min(2*column, width-1), std::min(2*column+1, width-1) };
+        float sum = 0.0f;
+        for (uint32_t row : rows)
+        {
+          for (uint32_t sourceColumn : columns)
+            sum += UxUtils::loadSample(source.data() + ((size_t)row*width + sourceColumn)*sampleSize, iImage.type);
+        }
+        UxUtils::storeSample(target.data() + ((size_t)iRow*levelWidth + column)*sampleSize, iImage.type, sum / 4.0f);
+      }
+    });
+
+    levels.push_back(std::move(target));
+  }
+  header.levelNb = (uint32_t)levels.size();
+  __AssertIfNot(header.levelNb <= MaxLevelNb, "Too many levels for a terrain asset");
+
+  // CPU heights in the layout read at runtime
+  MxHeightField field;
+  field.init(iImage.width, iImage.height, iImage.type, MxHeightField::Morton, iImage.range[0], iImage.range[1]);
+  field.setSamples(iImage.samples.data());
+
+  // Min/max pyramid: blocks of TileSize x TileSize samples, then 2x2 blocks of the previous level
+  std::vector<std::vector<float>> pyramid;
+  uint32_t blockNbX = (iImage.width + MxHeightField::TileSize - 1) / MxHeightField::TileSize;
+  uint32_t blockNbY = (iImage.height + MxHeightField::TileSize - 1) / MxHeightField::TileSize;
+  pyramid.emplace_back((size_t)blockNbX*blockNbY*2);
+  UxUtils::parallelFor(0, blockNbY, [&](uint32_t iBlockY)
+  {
+    for (uint32_t blockX = 0; blockX < blockNbX; blockX++)
+    {
+      float* bounds = pyramid[0].data() + ((size_t)iBlockY*blockNbX + blockX)*2;
+      bounds[0] = bounds[1] = field.getValue(blockX*MxHeightField::TileSize, iBlockY*MxHeightField::TileSize);
+      for (uint32_t y = iBlockY*MxHeightField::TileSize; y < std::min((iBlockY+1)*MxHeightField::TileSize, iImage.height); y++)
+      {
+        for (uint32_t x = blockX*MxHeightField::TileSize; x < std::min((blockX+1)*MxHeightField::TileSize, iImage.width); x++)
+        {
+          float value = field.getValue(x, y);
+          bounds[0] = std::min(bounds[0], value);
+          bounds[1] = std::max(bounds[1], value);
+        }
+      }
+    }
+  });
+
+  std::vector<uint32_t> pyramidWidths(1, blockNbX), pyramidHeights(1, blockNbY);
+  while (pyramidWidths.back() > 1 || pyramidHeights.back() > 1)
+  {
+    uint32_t width       = pyramidWidths.back();
+    uint32_t height      = pyramidHeights.back();
+    uint32_t levelWidth  = (width + 1) / 2;
+    uint32_t levelHeight = (height + 1) / 2;
+    std::vector<float> level((size_t)levelWidth*levelHeight*2);
+    for (uint32_t y = 0; y < levelHeight; y++)
+    {
+      for (uint32_t x = 0; x < levelWidth; x++)
+      {
+        float* bounds = level.data() + ((size_t)y*levelWidth + x)*2;
+        bounds[0] = FLT_MAX;
+        bounds[1] = -FLT_MAX;
+        for (uint32_t sourceY = 2*y; sourceY < std::min(2*y+2, height); sourceY++)
+        {
+          for (uint32_t sourceX = 2*x; sourceX < std::min(2*x+2, width); sourceX++)
+          {
+            const float* source = pyramid.back().data() + ((size_t)sourceY*width + sourceX)*2;
+            bounds[0] = std::min(bounds[0], source[0]);
+            bounds[1] = std::max(bounds[1], source[1]);
+          }
+        }
+      }
+    }
+    pyramid.push_back(std::move(level));
+    pyramidWidths.push_back(levelWidth);
+    pyramidHeights.push_back(levelHeight);
+  }
+  header.minMaxLevelNb = (uint32_t)pyramid.size();
+  __AssertIfNot(header.minMaxLevelNb <= MaxLevelNb, "Too many min/max levels for a terrain asset");
+
+  // Sections placed at page boundaries after the header
+  uint64_t offset = (sizeof(Header) + PageSize - 1) / PageSize * PageSize;
+  auto place = [&offset](Section& oSection, uint64_t iSize)
+  {
+    oSection.offset = offset;
+    oSection.size   = iSize;
+    offset = (offset + iSize + PageSize - 1) / PageSize * PageSize;
+  };
+  for (uint32_t level = 0; level < header.levelNb; level++)
+    place(header.levels[level], levels[level].size());
+  place(header.field, field.getDataSize());
+  for (uint32_t level = 0; level < header.minMaxLevelNb; level++)
+    place(header.minMax[level], pyramid[level].size()*sizeof(float));
+
+  FILE* fp = nullptr;
+  if (fopen_s(&fp, iPath.c_str(), "wb"))
+    return false;
+
+  uint64_t position = 0;
+  std::vector<uint8_t> padding(PageSize, 0);
+  auto write = [fp, &position, &padding](uint64_t iOffset, const void* iData, uint64_t iSize) -> bool
+  {
+    // Zeros up to the section
+    while (position < iOffset)
+    {
+      size_t size = (size_t)std::min<uint64_t>(iOffset - position, PageSize);
+      if (fwrite(padding.data(), 1, size, fp) != size)
+        return false;
+      position += size;
+    }
+    position += iSize;
+    return fwrite(iData, 1, (size_t)iSize, fp) == iSize;
+  };
+
+  bool isWritten = write(0, &header, sizeof(Header));
+  for (uint32_t level = 0; isWritten && level < header.levelNb; level++)
+    isWritten = write(header.levels[level].offset, levels[level].data(), header.levels[level].size);
+  isWritten = isWritten && write(header.field.offset, field.getData(), header.field.size);
+  for (uint32_t level = 0; isWritten && level < header.minMaxLevelNb; level++)
+    isWritten = write(header.minMax[level].offset, pyramid[level].data(), header.minMax[level].size);
+
+  isWritten = (fclose(fp) == 0) && isWritten;
+  return isWritten;
+}
+
+bool MxTerrainAsset::open(const std::string& iPath)
+{
+  close();
+
+  if (!_File.open(iPath) || _File.getSize() < sizeof(Header))
+  {
+    _File.close();
+    return false;
+  }
+
+  const Header* header = reinterpret_cast<const Header*>(_File.getData());
+  bool isValid = memcmp(header->magic, "HMTA", 4) == 0 && header->version == Version && header->width > 0 && header->height > 0;
+
+  // Formats known (checked before getHeightType, which exits on unknown formats)
+  isValid = isValid && (header->internalFormat == GL_R8 || header->internalFormat == GL_R16 || header->internalFormat == GL_R16F || header->internalFormat == GL_R32F);
+  isValid = isValid && header->type == UxUtils::getHeightType(header->internalFormat);
+  isValid = isValid && (header->fieldLayout == MxHeightField::Linear || header->fieldLayout == MxHeightField::Tiled || header->fieldLayout == MxHeightField::Morton);
+
+  // Mip chain of 1 level up to the full chain
+  uint32_t fullLevelNb = 1;
+  while (isValid && (std::max(header->width, header->height) >> fullLevelNb) > 0)
+    fullLevelNb++;
+  isValid = isValid && header->levelNb >= 1 && header->levelNb <= fullLevelNb;
+
+  // Sections inside the file (truncated file) and of the size of their content (read without bound checks)
+  auto isSection = [this](const Section& iSection, uint64_t iSize)
+  {
+    return iSection.size == iSize && iSection.size <= _File.getSize() && iSection.offset <= _File.getSize() - iSection.size;
+  };
+  uint32_t sampleSize = isValid ? UxUtils::getTypeSize(header->type) : 0;
+  for (uint32_t level = 0; isValid && level < header->levelNb; level++)
+    isValid = isSection(header->levels[level], (uint64_t)std::max(header->width >> level, 1u)*std::max(header->height >> level, 1u)*sampleSize);
+  isValid = isValid && isSection(header->field, MxHeightField::computeDataSize(header->width, header->height, header->type, (MxHeightField::Layout)header->fieldLayout));
+
+  // Min/max pyramid from the blocks of TileSize x TileSize samples down to a single block (layout read by getMinMax)
+  uint32_t blockNbX = (header->width + MxHeightField::TileSize - 1) / MxHeightField::TileSize;
+  uint32_t blockNbY = (header->height + MxHeightField::TileSize - 1) / MxHeightField::TileSize;
+  isValid = isValid && header->minMaxLevelNb >= 1 && header->minMaxLevelNb <= MaxLevelNb;
+  for (uint32_t level = 0; isValid && level < header->minMaxLevelNb; level++)
+  {
+    isValid = isSection(header->minMax[level], (uint64_t)blockNbX*blockNbY*2*sizeof(float));
+    isValid = isValid && ((blockNbX == 1 && blockNbY == 1) == (level + 1 == header->minMaxLevelNb));
+    blockNbX = (blockNbX + 1) / 2;
+    blockNbY = (blockNbY + 1) / 2;
+  }
+
+  if (!isValid)
+  {
+    _File.close();
+    return false;
+  }
+
+  _Header = header;
+  return true;
+}
+
+void MxTerrainAsset::close()
+{
+  _Header = nullptr;
+  _File.close();
+}
+
+const float* MxTerrainAsset::getMinMax(uint32_t iLevel, uint32_t iX, uint32_t iY) const
+{
+  assert(_Header && iLevel < _Header->minMaxLevelNb);
+
+  // Level 0 of blocks of TileSize x TileSize samples, the next ones halved (rounded up)
+  uint32_t width = (_Header->width + MxHeightField::TileSize - 1) / MxHeightField::TileSize;
+  for (uint32_t level = 0; level < iLevel; level++)
+    width = (width + 1) / 2;
+
+  return reinterpret_cast<const float*>(getSection(_Header->minMax[iLevel])) + ((size_t)iY*width + iX)*2;
+}
+
+void MxTerrainAsset::createHeightTexture(GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident) const
+{
+  assert(_Header);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  __CheckGLErrors;
+
+  glCreateTextures(GL_TEXTURE_2D, 1, &oTextureName);
+  __CheckGLErrors;
+  glTextureStorage2D(oTextureName, _Header->levelNb, _Header->internalFormat, _Header->width, _Header->height);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Texture, oTextureName, "MxTerrainAsset height map", UxUtils::getTextureSize(oTextureName), _Header->internalFormat);
+
+  // Levels uploaded from the mapping (pages read from the disk by the copy into the staging buffer)
+  for (uint32_t level = 0; level < _Header->levelNb; level++)
+    UxUtils::uploadTextureRows(oTextureName, level, 0, getLevelWidth(level), getLevelHeight(level), GL_RED, _Header->type, getSection(_Header->levels[level]), _Header->levels[level].size);
+
+  glTextureParameteri(oTextureName, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTextureParameteri(oTextureName, GL_TEXTURE_MIN_FILTER, _Header->levelNb > 1 ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR);
+  glTextureParameteri(oTextureName, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTextureParameteri(oTextureName, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  __CheckGLErrors;
+
+  oTextureHandle = glGetTextureHandleARB(oTextureName);
+  __CheckGLErrors;
+  if (iMakeResident)
+  {
+    UxResidencyManager::registerHandle(oTextureHandle, oTextureName);
+    UxResidencyManager::use(oTextureHandle);
+  }
+}
@@ -0,0 +1,91 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "UxUtils.h"
+#include "UxMappedFile.h"
+
+#include <stdint.h>
+#include <string>
+#include <algorithm>
+#include <gl/glew.h>
+
+//========================================================================
+//  Terrain Asset:
+//    Versioned binary container of the data derived from a height map,
+//    written once by the bake step and mapped at load. The sections are
+//    page-aligned and stored in their runtime format, so they are
+//    uploaded or consulted in place (no decoding, parsing nor copy):
+//      - mip chain of the height map (format of the texture storage),
+//      - height field (CPU heights in the tiled layout of MxHeightField),
+//      - min/max pyramid: bounds of the heights of the blocks of
+//        TileSize x TileSize samples, then of 2x2 blocks up to the
+//        whole map (bounds of any patch whatever the subdivision).
+//========================================================================
+
+class MxTerrainAsset
+{
+public:
+  static const uint32_t Version    = 1;
+  static const uint32_t PageSize   = 4096;
+  static const uint32_t MaxLevelNb = 32;
+
+  // Bytes from the beginning of the file
+  struct Section
+  {
+    uint64_t  offset;
+    uint64_t  size;
+  };
+
+  struct Header
+  {
+    char      magic[4];                 // "HMTA"
+    uint32_t  version;
+    uint32_t  width;
+    uint32_t  height;
+    uint32_t  internalFormat;           // R8, R16, R16F or R32F
+    uint32_t  type;                     // Type of the samples
+    float     range[2];                 // Scale and offset remapping the samples to [0,1]
+    uint32_t  levelNb;                  // Mip chain
+    uint32_t  fieldLayout;              // MxHeightField::Layout
+    uint32_t  minMaxLevelNb;
+    uint32_t  _alignment;
+    Section   levels[MaxLevelNb];
+    Section   field;
+    Section   minMax[MaxLevelNb];       // Pairs of floats (min, max) per block, row-major
+  };
+
+private:
+  UxMappedFile   _File;
+  const Header*  _Header;
+
+public:
+  MxTerrainAsset();
+  __DeclareDeletedCtorsAndAssignments(MxTerrainAsset)
+
+  // Asset of a decoded height map (false if the file can't be written)
+  static bool bake(const UxUtils::HeightImage& iImage, const std::string& iPath);
+  // Files of the ".hmt" extension
+  static bool isAssetPath(const std::string& iPath);
+
+  // False if the file can't be mapped or isn't an asset of this version
+  bool open(const std::string& iPath);
+  void close();
+
+  bool           isOpen() const { return _Header != nullptr; }
+  const Header&  getHeader() const { return *_Header; }
+  const uint8_t* getSection(const Section& iSection) const { return _File.getData() + iSection.offset; }
+
+  uint32_t     getLevelWidth(uint32_t iLevel) const { return std::max(_Header->width >> iLevel, 1u); }
+  uint32_t     getLevelHeight(uint32_t iLevel) const { return std::max(_Header->height >> iLevel, 1u); }
+  // Bounds (min, max) of the heights of the block (iX, iY) of a level of the pyramid, decoded to [0,1]
+  const float* getMinMax(uint32_t iLevel, uint32_t iX, uint32_t iY) const;
+
+  // Height texture filled from the mapped mip chain (thread of a GL context)
+  void createHeightTexture(GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident = true) const;
+};
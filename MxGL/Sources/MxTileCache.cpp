@@ -0,0 +1,510 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "MxTileCache.h"
+#include "MxHeightField.h"
+
+#include "UxThreadPool.h"
+#include "UxUtils.h"
+#include "UxAllocationCounter.h"
+#include "UxResidencyManager.h"
+#include "UxGPUMemoryRegistry.h"
+#include "UxError.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+MxTileCache::MxTileCache()
+{
+  _Asset           = nullptr;
+  _LoadingPool     = nullptr;
+  _GPUBudget       = 0;
+  _CPUBudget       = 0;
+  _RootLevel       = 0;
+  _SampleSize      = 0;
+  _TextureName     = 0;
+  _TextureHandle   = 0;
+  _TableName       = 0;
+  _TableHandle     = 0;
+  _IsTableModified = false;
+  _Frame           = 0;
+  _Statistics      = {};
+}
+
+MxTileCache::~MxTileCache()
+{
+  destroy();
+}
+
+void MxTileCache::create(const MxTerrainAsset& iAsset, UxThreadPool* iLoadingPool, uint64_t iGPUBudget, uint64_t iCPUBudget)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::TerrainData);
+
+  destroy();
+
+  _Asset       = &iAsset;
+  _LoadingPool = iLoadingPool;
+  _GPUBudget   = iGPUBudget;
+  _CPUBudget   = iCPUBudget;
+
+  // Tiles of every level, the levels being stacked by rows in the indirection table (as wide as the finest level)
+  const MxTerrainAsset::Header& header = iAsset.getHeader();
+  uint32_t tileNb = 0, rowNb = 0;
+  _RootLevel = header.levelNb - 1;
+  for (uint32_t level = 0; level < header.levelNb; level++)
+  {
+    _LevelOffsets.push_back(tileNb);
+    _LevelRows.push_back(rowNb);
+    _LevelTileNbX.push_back((iAsset.getLevelWidth(level) + TileSize - 1) / TileSize);
+    _LevelTileNbY.push_back((iAsset.getLevelHeight(level) + TileSize - 1) / TileSize);
+    tileNb += _LevelTileNbX[level] * _LevelTileNbY[level];
+    rowNb  += _LevelTileNbY[level];
+
+    if (_LevelTileNbX[level] == 1 && _LevelTileNbY[level] == 1)
+      _RootLevel = std::min(_RootLevel, level);
+  }
+
+  _Tiles.resize(tileNb);
+  for (uint32_t level = 0; level < header.levelNb; level++)
+  {
+    for (uint32_t y = 0; y < _LevelTileNbY[level]; y++)
+    {
+      for (uint32_t x = 0; x < _LevelTileNbX[level]; x++)
+      {
+        Tile& tile         = _Tiles[getTileRank(level, x, y)];
+        tile.level         = level;
+        tile.x             = x;
+        tile.y             = y;
+        tile.state         = Absent;
+        tile.layer         = -1;
+        tile.lastUsedFrame = 0;
+        tile.lastPredictedFrame = 0;
+        tile.predictedTime = 0.0f;
+        tile.isPrefetched  = false;
+      }
+    }
+  }
+
+  // Layers held by the GPU budget (the levels having a single tile are always resident)
+  const uint32_t storedSize = TileSize + 2*TileBorder;
+  _SampleSize = UxUtils::getTypeSize(header.type);
+  GLint maxLayerNb = 0;
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayerNb);
+  uint32_t layerNb = (uint32_t)std::min<uint64_t>(iGPUBudget / ((uint64_t)storedSize*storedSize*_SampleSize), (uint64_t)std::min(maxLayerNb, 0xFFFF));
+  __AssertIfNot(layerNb > header.levelNb - _RootLevel, "GPU budget too small for the tile cache");
+  _LayerTiles.assign(layerNb, -1);
+
+  glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &_TextureName);
+  glTextureStorage3D(_TextureName, 1, header.internalFormat, storedSize, storedSize, layerNb);
+  glTextureParameteri(_TextureName, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTextureParameteri(_TextureName, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTextureParameteri(_TextureName, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTextureParameteri(_TextureName, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  __CheckGLErrors;
+
+  // Entries: layer (bits 0-15) and level (bits 16-23) of the tile or of its nearest resident ancestor
+  glCreateTextures(GL_TEXTURE_2D, 1, &_TableName);
+  glTextureStorage2D(_TableName, 1, GL_R32UI, _LevelTileNbX[0], rowNb);
+  glTextureParameteri(_TableName, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTextureParameteri(_TableName, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  __CheckGLErrors;
+  _Table.assign((size_t)_LevelTileNbX[0] * rowNb, 0);
+
+  // Coarse levels read and uploaded at once (fallback of every missing tile)
+  for (uint32_t level = _RootLevel; level < header.levelNb; level++)
+  {
+    Tile& tile = _Tiles[getTileRank(level, 0, 0)];
+    tile.samples.resize((size_t)storedSize*storedSize*_SampleSize);
+    readTile(iAsset, level, 0, 0, tile.samples.data());
+    tile.state = Loaded;
+    upload(getTileRank(level, 0, 0), false);
+
+    tile.samples.clear();
+    tile.samples.shrink_to_fit();
+    tile.state = Absent;
+  }
+  updateTable();
+
+  // Made resident by the draws sampling them (see MxTerrain::render)
+  _TextureHandle = glGetTextureHandleARB(_TextureName);
+  _TableHandle   = glGetTextureHandleARB(_TableName);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Texture, _TextureName, "MxTileCache tiles", UxUtils::getTextureSize(_TextureName), header.internalFormat);
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Texture, _TableName, "MxTileCache table", UxUtils::getTextureSize(_TableName), GL_R32UI);
+  UxResidencyManager::registerHandle(_TextureHandle, _TextureName);
+  UxResidencyManager::registerHandle(_TableHandle, _TableName);
+
+  _Frame      = 0;
+  _Statistics = {};
+  _Statistics.layerNb = layerNb;
+}
+
+void MxTileCache::destroy()
+{
+  // Tiles being read by the loading pool completed first (their samples are written by the jobs)
+  for (auto& load : _Loads)
+    load.second.wait();
+  _Loads.clear();
+
+  if (_TextureName)
+  {
+    UxResidencyManager::unregisterHandle(_TextureHandle);
+    UxResidencyManager::unregisterHandle(_TableHandle);
+    UxGPUMemoryRegistry::release(UxGPUMemoryRegistry::Texture, _TextureName);
+    UxGPUMemoryRegistry::release(UxGPUMemoryRegistry::Texture, _TableName);
+    glDeleteTextures(1, &_TextureName);
+    glDeleteTextures(1, &_TableName);
+    __CheckGLErrors;
+  }
+
+  _TextureName   = 0;
+  _TextureHandle = 0;
+  _TableName     = 0;
+  _TableHandle   = 0;
+  _Asset         = nullptr;
+
+  _Tiles.clear();
+  _LevelOffsets.clear();
+  _LevelTileNbX.clear();
+  _LevelTileNbY.clear();
+  _LevelRows.clear();
+  _CachedTiles.clear();
+  _LayerTiles.clear();
+  _Table.clear();
+}
+
+bool MxTileCache::update(const Vector3f& iEyeView, const Vector3f& iEyeDirection, const MxViewPredictor::View* iPredictedViews, uint32_t iPredictedViewNb, float iAngle, float iPixelAngle, const Vector2f& iTerrainDimension, float iHeightFactor)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::TerrainData);
+
+  assert(isCreated());
+  _Frame++;
+
+  // Tiles read by the loading pool moved to the CPU cache
+  for (auto load = _Loads.begin(); load != _Loads.end();)
+  {
+    if (load->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      load++;
+      continue;
+    }
+
+    Tile& tile = _Tiles[load->first];
+    tile.state      = Loaded;
+    tile.cachedRank = _CachedTiles.insert(_CachedTiles.end(), load->first);
+    _Statistics.cachedSize += tile.samples.size();
+    load = _Loads.erase(load);
+  }
+
+  // Tiles of the view, from the root down to the levels where a texel is about a pixel, then the ones of the
+  // predicted views not in the view
+  _NeededTiles.clear();
+  _NeededPriorities.clear();
+  _PredictedTiles.clear();
+  _PredictedPriorities.clear();
+  uint32_t topLevel = getLevelNb() - 1;
+  select(topLevel, 0, 0, { iEyeView, iEyeDirection, 0.0f }, iAngle, iPixelAngle, iTerrainDimension, iHeightFactor);
+  for (uint32_t view = 0; view < iPredictedViewNb; view++)
+    select(topLevel, 0, 0, iPredictedViews[view], iAngle, iPixelAngle, iTerrainDimension, iHeightFactor);
+
+  // Coarse tiles first (fallback of the finer ones), then the nearest ones
+  _NeededOrder.resize(_NeededTiles.size());
+  for (uint32_t rank = 0; rank < (uint32_t)_NeededOrder.size(); rank++)
+    _NeededOrder[rank] = rank;
+  std::sort(_NeededOrder.begin(), _NeededOrder.end(), [this](uint32_t iRank1, uint32_t iRank2) {
+    const Tile& tile1 = _Tiles[_NeededTiles[iRank1]];
+    const Tile& tile2 = _Tiles[_NeededTiles[iRank2]];
+    if (tile1.level != tile2.level)
+      return tile1.level > tile2.level;
+    return _NeededPriorities[iRank1] < _NeededPriorities[iRank2]; });
+
+  // Missing tiles uploaded if loaded, read otherwise (limited numbers per frame)
+  uint32_t uploadNb = 0, missingTileNb = 0;
+  for (uint32_t rank : _NeededOrder)
+  {
+    uint32_t tileRank = _NeededTiles[rank];
+    Tile&    tile     = _Tiles[tileRank];
+    if (tile.layer >= 0)
+      continue;
+
+    missingTileNb++;
+    if (tile.state == Loaded && uploadNb < MaxUploadNbPerFrame)
+    {
+      if (upload(tileRank, false))
+        uploadNb++;
+    }
+    else if (tile.state == Absent && _Loads.size() < MaxLoadNb)
+      load(tileRank);
+  }
+
+  // Predicted tiles prefetched with the capacity left, the soonest visible first (then coarse and near ones first)
+  _PredictedOrder.resize(_PredictedTiles.size());
+  for (uint32_t rank = 0; rank < (uint32_t)_PredictedOrder.size(); rank++)
+    _PredictedOrder[rank] = rank;
+  std::sort(_PredictedOrder.begin(), _PredictedOrder.end(), [this](uint32_t iRank1, uint32_t iRank2) {
+    const Tile& tile1 = _Tiles[_PredictedTiles[iRank1]];
+    const Tile& tile2 = _Tiles[_PredictedTiles[iRank2]];
+    if (tile1.predictedTime != tile2.predictedTime)
+      return tile1.predictedTime < tile2.predictedTime;
+    if (tile1.level != tile2.level)
+      return tile1.level > tile2.level;
+    return _PredictedPriorities[iRank1] < _PredictedPriorities[iRank2]; });
+
+  for (uint32_t rank : _PredictedOrder)
+  {
+    uint32_t tileRank = _PredictedTiles[rank];
+    Tile&    tile     = _Tiles[tileRank];
+    if (tile.layer >= 0)
+      continue;
+
+    if (tile.state == Loaded && uploadNb < MaxUploadNbPerFrame)
+    {
+      if (upload(tileRank, true))
+        uploadNb++;
+    }
+    else if (tile.state == Absent && _Loads.size() < MaxLoadNb)
+    {
+      load(tileRank);
+      tile.isPrefetched = true;
+      _Statistics.prefetchNb++;
+    }
+  }
+
+  // CPU budget: least recently used tiles released, the ones still needed or predicted being kept until uploaded
+  for (auto cached = _CachedTiles.begin(); cached != _CachedTiles.end() && _Statistics.cachedSize > _CPUBudget;)
+  {
+    uint32_t tileRank = *cached++;
+    const Tile& tile = _Tiles[tileRank];
+    if (tile.layer >= 0 || (tile.lastUsedFrame != _Frame && tile.lastPredictedFrame != _Frame))
+      evictCPU(tileRank);
+  }
+
+  _Statistics.neededTileNb    = (uint32_t)_NeededTiles.size();
+  _Statistics.predictedTileNb = (uint32_t)_PredictedTiles.size();
+  _Statistics.missingTileNb = missingTileNb;
+  _Statistics.residentTileNb = (uint32_t)std::count_if(_LayerTiles.begin(), _LayerTiles.end(), [](int32_t iTile) { return iTile >= 0; });
+
+  bool isModified = _IsTableModified;
+  if (_IsTableModified)
+    updateTable();
+  return isModified;
+}
+
+void MxTileCache::select(uint32_t iLevel, uint32_t iX, uint32_t iY, const MxViewPredictor::View& iView, float iAngle, float iPixelAngle, const Vector2f& iTerrainDimension, float iHeightFactor)
+{
+  const MxTerrainAsset::Header& header = _Asset->getHeader();
+  uint32_t tileRank = getTileRank(iLevel, iX, iY);
+  Tile&    tile     = _Tiles[tileRank];
+
+  // Bounds of the tile in the terrain frame (map rows along -y), heights bounded by the min/max pyramid whose
+  // blocks match the tiles (TileSize << level samples of the finest level)
+  float texelU = iTerrainDimension[0] / (header.width - 1);
+  float texelV = iTerrainDimension[1] / (header.height - 1);
+  float span   = (float)(TileSize << iLevel);
+  float x0 = std::min(iX * span * texelU, iTerrainDimension[0]);
+  float x1 = std::min((iX + 1) * span * texelU, iTerrainDimension[0]);
+  float y0 = iTerrainDimension[1] - std::min((iY + 1) * span * texelV, iTerrainDimension[1]);
+  float y1 = iTerrainDimension[1] - std::min(iY * span * texelV, iTerrainDimension[1]);
+
+  uint32_t minMaxLevel = 0;
+  while ((MxHeightField::TileSize << minMaxLevel) < (TileSize << iLevel))
+    minMaxLevel++;
+  const float* bounds = minMaxLevel < header.minMaxLevelNb ? _Asset->getMinMax(minMaxLevel, iX, iY) : _Asset->getMinMax(header.minMaxLevelNb - 1, 0, 0);
+  float z0 = bounds[0] * iHeightFactor;
+  float z1 = bounds[1] * iHeightFactor;
+
+  // Distance from the eye to the box and visibility of its bounding sphere in the view cone
+  Vector3f nearest(std::min(std::max(iView.eyeView[0], x0), x1), std::min(std::max(iView.eyeView[1], y0), y1), std::min(std::max(iView.eyeView[2], z0), z1));
+  float distance = (nearest - iView.eyeView).length();
+
+  Vector3f center((x0 + x1) / 2, (y0 + y1) / 2, (z0 + z1) / 2);
+  Vector3f toCenter = center - iView.eyeView;
+  float radius         = Vector3f(x1 - x0, y1 - y0, z1 - z0).length() / 2;
+  float centerDistance = toCenter.length();
+  bool  isVisible      = centerDistance <= radius || toCenter.dotProduct(iView.eyeDirection) >= centerDistance * cosf(std::min(iAngle + asinf(radius / centerDistance), 3.14159265f));
+
+  if (iView.time == 0.0f)
+  {
+    // Tile entering the view: available (prefetch hit if read for a predicted view) or read late
+    if (tile.lastUsedFrame + 1 < _Frame && _Frame > 1)
+    {
+      if (tile.layer < 0 && tile.state != Loaded)
+        _Statistics.lateLoadNb++;
+      else if (tile.isPrefetched)
+        _Statistics.prefetchHitNb++;
+    }
+    tile.isPrefetched  = false;
+    tile.lastUsedFrame = _Frame;
+    _NeededTiles.push_back(tileRank);
+    _NeededPriorities.push_back(distance);
+  }
+  else if (tile.lastUsedFrame != _Frame)
+  {
+    // Tile predicted only, at the soonest horizon of the frame
+    if (tile.lastPredictedFrame != _Frame)
+    {
+      tile.lastPredictedFrame = _Frame;
+      tile.predictedTime      = iView.time;
+      _PredictedTiles.push_back(tileRank);
+      _PredictedPriorities.push_back(distance);
+    }
+    tile.predictedTime = std::min(tile.predictedTime, iView.time);
+  }
+  if (tile.state == Loaded)
+    _CachedTiles.splice(_CachedTiles.end(), _CachedTiles, tile.cachedRank);
+
+  // Refined while a texel of the level is larger than a pixel at the tile distance (visible tiles only)
+  float texelSize = std::max(texelU, texelV) * (float)(1u << iLevel);
+  if (iLevel == 0 || !isVisible || texelSize <= distance * iPixelAngle)
+    return;
+
+  // Children (odd level sizes: the last tile of a row or column also covers the tiles beyond)
+  uint32_t level = iLevel - 1;
+  uint32_t lastX = (iX + 1 == _LevelTileNbX[iLevel]) ? _LevelTileNbX[level] : std::min(2*iX + 2, _LevelTileNbX[level]);
+  uint32_t lastY = (iY + 1 == _LevelTileNbY[iLevel]) ? _LevelTileNbY[level] : std::min(2*iY + 2, _LevelTileNbY[level]);
+  for (uint32_t y = 2*iY; y < lastY; y++)
+  {
+    for (uint32_t x = 2*iX; x < lastX; x++)
+      select(level, x, y, iView, iAngle, iPixelAngle, iTerrainDimension, iHeightFactor);
+  }
+}
+
+void MxTileCache::readTile(const MxTerrainAsset& iAsset, uint32_t iLevel, uint32_t iX, uint32_t iY, uint8_t* oSamples)
+{
+  const MxTerrainAsset::Header& header = iAsset.getHeader();
+  const uint8_t* levelSamples = iAsset.getSection(header.levels[iLevel]);
+  int32_t  width      = (int32_t)iAsset.getLevelWidth(iLevel);
+  int32_t  height     = (int32_t)iAsset.getLevelHeight(iLevel);
+  uint32_t sampleSize = UxUtils::getTypeSize(header.type);
+  uint32_t storedSize = TileSize + 2*TileBorder;
+
+  // Rows and columns of the borders beyond the level clamped (pages of the mapping read from the disk here)
+  int32_t firstColumn = (int32_t)(iX*TileSize) - (int32_t)TileBorder;
+  for (uint32_t j = 0; j < storedSize; j++)
+  {
+    int32_t        row    = std::min(std::max((int32_t)(iY*TileSize + j) - (int32_t)TileBorder, 0), height - 1);
+    const uint8_t* source = levelSamples + (size_t)row*width*sampleSize;
+    uint8_t*       target = oSamples + (size_t)j*storedSize*sampleSize;
+    for (uint32_t i = 0; i < storedSize;)
+    {
+      int32_t column = firstColumn + (int32_t)i;
+      if (column < 0 || column >= width)
+      {
+        memcpy(target + i*sampleSize, source + std::min(std::max(column, 0), width - 1)*sampleSize, sampleSize);
+        i++;
+      }
+      else
+      {
+        uint32_t runNb = std::min(storedSize - i, (uint32_t)(width - column));
+        memcpy(target + i*sampleSize, source + (size_t)column*sampleSize, (size_t)runNb*sampleSize);
+        i += runNb;
+      }
+    }
+  }
+}
+
+void MxTileCache::load(uint32_t iTile)
+{
+  Tile& tile = _Tiles[iTile];
+  uint32_t storedSize = TileSize + 2*TileBorder;
+  tile.samples.resize((size_t)storedSize*storedSize*_SampleSize);
+  tile.state = Loading;
+
+  // Samples only written by the job until its completion is observed by update
+  const MxTerrainAsset* asset = _Asset;
+  uint8_t* samples = tile.samples.data();
+  uint32_t level = tile.level, x = tile.x, y = tile.y;
+  _Loads.emplace_back(iTile, _LoadingPool->submit([asset, level, x, y, samples]() { readTile(*asset, level, x, y, samples); }));
+  _Statistics.loadNb++;
+}
+
+bool MxTileCache::upload(uint32_t iTile, bool iIsPrefetched)
+{
+  Tile& tile = _Tiles[iTile];
+
+  // Free layer, otherwise the one of the least recently used tile not needed by the frame (coarse levels kept), nor
+  // predicted for a prefetched tile
+  int32_t layer = -1;
+  for (uint32_t rank = 0; rank < (uint32_t)_LayerTiles.size() && layer < 0; rank++)
+  {
+    if (_LayerTiles[rank] < 0)
+      layer = (int32_t)rank;
+  }
+  if (layer < 0)
+  {
+    uint64_t oldestFrame = _Frame;
+    for (uint32_t rank = 0; rank < (uint32_t)_LayerTiles.size(); rank++)
+    {
+      const Tile& resident = _Tiles[_LayerTiles[rank]];
+      if (resident.level < _RootLevel && resident.lastUsedFrame < oldestFrame && (!iIsPrefetched || resident.lastPredictedFrame != _Frame))
+      {
+        oldestFrame = resident.lastUsedFrame;
+        layer       = (int32_t)rank;
+      }
+    }
+    if (layer < 0)
+      return false;
+
+    _Tiles[_LayerTiles[layer]].layer = -1;
+    _Statistics.gpuEvictionNb++;
+  }
+
+  uint32_t storedSize = TileSize + 2*TileBorder;
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTextureSubImage3D(_TextureName, 0, 0, 0, layer, storedSize, storedSize, 1, GL_RED, _Asset->getHeader().type, tile.samples.data());
+  __CheckGLErrors;
+
+  tile.layer          = layer;
+  _LayerTiles[layer]  = (int32_t)iTile;
+  _IsTableModified    = true;
+  _Statistics.uploadNb++;
+  return true;
+}
+
+void MxTileCache::evictCPU(uint32_t iTile)
+{
+  Tile& tile = _Tiles[iTile];
+  _Statistics.cachedSize -= tile.samples.size();
+  _CachedTiles.erase(tile.cachedRank);
+
+  tile.samples.clear();
+  tile.samples.shrink_to_fit();
+  tile.state = Absent;
+  _Statistics.cpuEvictionNb++;
+}
+
+void MxTileCache::updateTable()
+{
+  // Missing tiles replaced by the nearest resident ancestor (tile containing the texels halved, clamped to the
+  // last tile of the level as the shader does for the odd level sizes)
+  uint32_t tableWidth = _LevelTileNbX[0];
+  for (uint32_t level = 0; level < getLevelNb(); level++)
+  {
+    for (uint32_t y = 0; y < _LevelTileNbY[level]; y++)
+    {
+      for (uint32_t x = 0; x < _LevelTileNbX[level]; x++)
+      {
+        uint32_t ancestorLevel = level;
+        const Tile* ancestor = &_Tiles[getTileRank(level, x, y)];
+        while (ancestor->layer < 0)
+        {
+          ancestorLevel++;
+          uint32_t shift = ancestorLevel - level;
+          ancestor = &_Tiles[getTileRank(ancestorLevel, std::min(x >> shift, _LevelTileNbX[ancestorLevel] - 1), std::min(y >> shift, _LevelTileNbY[ancestorLevel] - 1))];
+        }
+        _Table[(size_t)(_LevelRows[level] + y)*tableWidth + x] = (uint32_t)ancestor->layer | (ancestorLevel << 16);
+      }
+    }
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glTextureSubImage2D(_TableName, 0, 0, 0, tableWidth, (GLsizei)(_Table.size() / tableWidth), GL_RED_INTEGER, GL_UNSIGNED_INT, _Table.data());
+  __CheckGLErrors;
+  _IsTableModified = false;
+}
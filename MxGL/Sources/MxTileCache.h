@@ -0,0 +1,157 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "MxTerrainAsset.h"
+#include "MxViewPredictor.h"
+
+#include <vmath.h>
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <list>
+#include <future>
+#include <gl/glew.h>
+
+class UxThreadPool;
+
+//========================================================================
+//  Tile Cache:
+//    Out-of-core streaming of the height map of a baked asset. Every mip
+//    level is split into tiles of TileSize x TileSize texels stored with
+//    a border of one texel (the 2x2 footprints of the shaders read in a
+//    single tile). The tiles needed by the view (refined while a texel is
+//    larger than a pixel, coarse out of the view cone) are read from the
+//    mapping by the loading pool into a CPU cache, then uploaded into the
+//    layers of a texture array, both under a memory budget and evicted
+//    in least recently used order. The indirection table (one entry per
+//    tile of every level, levels stacked by rows) gives the layer of the
+//    tile or of its nearest resident ancestor, the levels having a single
+//    tile being always resident (see tx_mapcomputing.glsl). The tiles of
+//    the predicted views are prefetched with the capacity left, the ones
+//    visible the soonest first, without evicting the tiles of the view.
+//========================================================================
+
+class MxTileCache
+{
+public:
+  static const uint32_t TileSize            = 256;   // Texels of a tile without its borders (power of 2)
+  static const uint32_t TileBorder          = 1;
+  static const uint32_t MaxLoadNb           = 16;    // Tiles read at the same time by the loading pool
+  static const uint32_t MaxUploadNbPerFrame = 8;
+
+  // Frame statistics, the counters being cumulated since the creation
+  struct Statistics
+  {
+    uint32_t  neededTileNb;       // Tiles selected by the view
+    uint32_t  residentTileNb;     // Layers in use
+    uint32_t  layerNb;
+    uint32_t  missingTileNb;      // Selected tiles replaced by an ancestor
+    uint64_t  cachedSize;         // CPU bytes of the loaded tiles
+    uint64_t  loadNb;
+    uint64_t  uploadNb;
+    uint64_t  gpuEvictionNb;
+    uint64_t  cpuEvictionNb;
+    uint32_t  predictedTileNb;    // Tiles selected by the predicted views only
+    uint64_t  prefetchNb;         // Tiles read for the predicted views
+    uint64_t  prefetchHitNb;      // Prefetched tiles available when entering the view
+    uint64_t  lateLoadNb;         // Tiles entering the view before being read
+  };
+
+private:
+  enum TileState
+  {
+    Absent,
+    Loading,      // Read by the loading pool
+    Loaded,       // Samples in the CPU cache
+  };
+
+  struct Tile
+  {
+    uint32_t                         level;
+    uint32_t                         x, y;
+    TileState                        state;
+    int32_t                          layer;          // Layer of the texture array (-1: not resident)
+    uint64_t                         lastUsedFrame;
+    uint64_t                         lastPredictedFrame;
+    float                            predictedTime;  // Soonest horizon of the frame predicting the tile
+    bool                             isPrefetched;   // Read for a predicted view, not yet in the view
+    std::vector<uint8_t>             samples;        // (TileSize+2*TileBorder)^2 samples while loaded
+    std::list<uint32_t>::iterator    cachedRank;     // Position in the CPU LRU list while loaded
+  };
+
+  const MxTerrainAsset*   _Asset;
+  UxThreadPool*           _LoadingPool;
+  uint64_t                _GPUBudget;
+  uint64_t                _CPUBudget;
+
+  // Tiles of every level (tiles of a level row-major, from the finest level)
+  std::vector<Tile>       _Tiles;
+  std::vector<uint32_t>   _LevelOffsets;      // Rank of the first tile of every level
+  std::vector<uint32_t>   _LevelTileNbX;
+  std::vector<uint32_t>   _LevelTileNbY;
+  std::vector<uint32_t>   _LevelRows;         // First row of every level in the indirection table
+  uint32_t                _RootLevel;         // Finest level having a single tile (levels above always resident)
+  uint32_t                _SampleSize;
+
+  // CPU cache (least recently used first) and loads in progress
+  std::list<uint32_t>                                 _CachedTiles;
+  std::deque<std::pair<uint32_t, std::future<void>>>  _Loads;
+
+  // Texture array and indirection table
+  GLuint                  _TextureName;
+  GLuint64                _TextureHandle;
+  GLuint                  _TableName;
+  GLuint64                _TableHandle;
+  std::vector<int32_t>    _LayerTiles;        // Tile of every layer (-1: free)
+  std::vector<uint32_t>   _Table;
+  bool                    _IsTableModified;
+
+  // Selection of the frame (kept from frame to frame, no allocation in steady state)
+  std::vector<uint32_t>   _NeededTiles;
+  std::vector<float>      _NeededPriorities;
+  std::vector<uint32_t>   _NeededOrder;
+  std::vector<uint32_t>   _PredictedTiles;
+  std::vector<float>      _PredictedPriorities;
+  std::vector<uint32_t>   _PredictedOrder;
+  uint64_t                _Frame;
+  Statistics              _Statistics;
+
+public:
+  MxTileCache();
+  ~MxTileCache();
+  __DeclareDeletedCtorsAndAssignments(MxTileCache)
+
+  // GPU and CPU budgets in bytes (rendering thread), the asset staying mapped until destroy
+  void create(const MxTerrainAsset& iAsset, UxThreadPool* iLoadingPool, uint64_t iGPUBudget, uint64_t iCPUBudget);
+  void destroy();
+
+  // Selection of the tiles of the view and of the predicted views, loads, uploads and evictions of the frame (eye and
+  // direction in the terrain frame, pixel angle: angle under which a pixel is seen). Returns true if the indirection
+  // table changed.
+  bool update(const Vector3f& iEyeView, const Vector3f& iEyeDirection, const MxViewPredictor::View* iPredictedViews, uint32_t iPredictedViewNb, float iAngle, float iPixelAngle, const Vector2f& iTerrainDimension, float iHeightFactor);
+
+  bool               isCreated() const { return _TextureName != 0; }
+  GLuint64           getTextureHandle() const { return _TextureHandle; }
+  GLuint64           getTableHandle() const { return _TableHandle; }
+  uint32_t           getLevelNb() const { return (uint32_t)_LevelOffsets.size(); }
+  const Statistics&  getStatistics() const { return _Statistics; }
+
+protected:
+  uint32_t getTileRank(uint32_t iLevel, uint32_t iX, uint32_t iY) const { return _LevelOffsets[iLevel] + iY*_LevelTileNbX[iLevel] + iX; }
+
+  // Tile of a level read from the mapping with its borders (loading pool)
+  static void readTile(const MxTerrainAsset& iAsset, uint32_t iLevel, uint32_t iX, uint32_t iY, uint8_t* oSamples);
+
+  // Tiles of the view (time 0) or of a predicted view
+  void select(uint32_t iLevel, uint32_t iX, uint32_t iY, const MxViewPredictor::View& iView, float iAngle, float iPixelAngle, const Vector2f& iTerrainDimension, float iHeightFactor);
+  void load(uint32_t iTile);
+  bool upload(uint32_t iTile, bool iIsPrefetched);
+  void evictCPU(uint32_t iTile);
+  void updateTable();
+};
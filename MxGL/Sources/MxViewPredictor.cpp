@@ -0,0 +1,69 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "MxViewPredictor.h"
+
+MxViewPredictor::MxViewPredictor()
+{
+  _IsInitialized = false;
+  _Time          = 0;
+}
+
+void MxViewPredictor::update(int iTime, const Vector3f& iEyeView, const Vector3f& iEyeDirection)
+{
+  if (_IsInitialized && iTime > _Time)
+  {
+    // Velocities of the frame blended with the previous ones (jitter of the interactive moves)
+    float    dt                = 0.001f * (iTime - _Time);
+    Vector3f velocity          = (iEyeView - _EyeView) / dt;
+    Vector3f directionVelocity = (iEyeDirection - _EyeDirection) / dt;
+    _Velocity          = _Velocity * 0.5f + velocity * 0.5f;
+    _DirectionVelocity = _DirectionVelocity * 0.5f + directionVelocity * 0.5f;
+  }
+  else if (!_IsInitialized)
+  {
+    _Velocity          = Vector3f(0.0f, 0.0f, 0.0f);
+    _DirectionVelocity = Vector3f(0.0f, 0.0f, 0.0f);
+  }
+
+  _IsInitialized = true;
+  _Time          = iTime;
+  _EyeView       = iEyeView;
+  _EyeDirection  = iEyeDirection;
+}
+
+uint32_t MxViewPredictor::predict(View oViews[HorizonNb]) const
+{
+  // Horizons (s) covering the time to read and upload a tile
+  const float horizons[HorizonNb] = { 0.25f, 0.5f, 1.0f, 2.0f };
+
+  if (!_IsInitialized)
+    return 0;
+
+  uint32_t viewNb = 0;
+  for (float horizon : horizons)
+  {
+    View& view = oViews[viewNb];
+    view.time = horizon;
+
+    if (_PathPredictor && _PathPredictor(_Time + (int)(1000.0f * horizon), view.eyeView, view.eyeDirection))
+    {
+      viewNb++;
+      continue;
+    }
+
+    // Still camera: nothing to predict
+    if (_Velocity.length() < 1e-3f && _DirectionVelocity.length() < 1e-3f)
+      return 0;
+
+    view.eyeView      = _EyeView + _Velocity * horizon;
+    view.eyeDirection = _EyeDirection + _DirectionVelocity * horizon;
+    view.eyeDirection.normalize();
+    viewNb++;
+  }
+
+  return viewNb;
+}
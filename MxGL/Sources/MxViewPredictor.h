@@ -0,0 +1,60 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <vmath.h>
+#include <stdint.h>
+#include <functional>
+
+//========================================================================
+//  View Predictor:
+//    Extrapolation of the camera a few horizons ahead (tile prefetching).
+//    The camera driven by an animation follows its deterministic path,
+//    given by the path predictor; otherwise (interactive viewer) the eye
+//    and the viewing direction are extrapolated from their velocities,
+//    smoothed over the last frames.
+//========================================================================
+
+class MxViewPredictor
+{
+public:
+  static const uint32_t HorizonNb = 4;
+
+  struct View
+  {
+    Vector3f  eyeView;
+    Vector3f  eyeDirection;
+    float     time;             // Seconds ahead
+  };
+
+  // Camera at a future time (ms) if driven along a path
+  typedef std::function<bool(int iTime, Vector3f& oEyeView, Vector3f& oEyeDirection)> PathPredictor;
+
+private:
+  PathPredictor  _PathPredictor;
+
+  // Last camera and velocities (per second)
+  bool           _IsInitialized;
+  int            _Time;
+  Vector3f       _EyeView;
+  Vector3f       _EyeDirection;
+  Vector3f       _Velocity;
+  Vector3f       _DirectionVelocity;
+
+public:
+  MxViewPredictor();
+  __DeclareDeletedCtorsAndAssignments(MxViewPredictor)
+
+  void setPathPredictor(const PathPredictor& iPathPredictor) { _PathPredictor = iPathPredictor; }
+
+  // Camera of the frame (time in ms)
+  void update(int iTime, const Vector3f& iEyeView, const Vector3f& iEyeDirection);
+  // Views at the horizons (empty while still or before 2 frames), returns the number of views
+  uint32_t predict(View oViews[HorizonNb]) const;
+};
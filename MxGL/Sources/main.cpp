@@ -1,410 +1,591 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include <gl/glew.h>
-#include <gl/freeglut.h>
-#include <glfw/glfw3.h>
-
-#include <IL/il.h>
-//#include <IL/ilut.h>
-
-#include "UxUtils.h"
-#include "MxViewer.h"
-#include "MxGLObjects.h"
-#include "MxScene.h"
-#include "MxTerrain.h"
-#include "MxLight.h"
-#include "MxFlyAnimation.h"
-#include "MxLightAnimation.h"
-#include "MxHeightAnimation.h"
-
-#include <sstream>
-#include <iomanip>
-
-static uint32_t gWireframeMode = 0;
-static uint32_t gColorMode = 0;
-static uint32_t gIsolineMode = 0;
-static uint32_t gFunctionalMode = 0;
-static uint32_t gMapMode = 0;
-static uint32_t gSmoothMode = 0;
-static uint32_t gAnimationMode = 0;
-static uint32_t gShadowMode = 0;
-static uint32_t gDisplayHelp = 0;
-static float    gDistortionFactor = 4.0f;
-
-void onCharKeyPressed(GLFWwindow* window, unsigned int key);
-float getIsolineStep(uint32_t iMode);
-std::string formatLongInt(uint32_t iNumber);
-void displayText(const std::string& i2DText, void* iFont);
-void displayInfo(const MxViewer& iViewer, const MxScene& iScene, uint32_t iBeforeTime, uint32_t iAfterTime, const std::vector<std::shared_ptr<MxAnimation>>& iAnimations);
-void displayHelp(const MxViewer& iViewer);
-
-void main(int argc, char **argv)
-{
-   if (!glfwInit())
-  {
-    std::cerr << "Failed to initialize GLFW\n";
-    return;
-  }
-
-  GLFWwindow* window = glfwCreateWindow(1800, 1000, "Heightmap Terrain", /*glfwGetPrimaryMonitor()*/ NULL, NULL);
-  if (!window)
-  {
-    std::cerr << "Failed to open window\n";
-    return;
-  }
-
-  glfwMakeContextCurrent(window);
-  glfwSetCharCallback(window, onCharKeyPressed);
-
-  glewInit();
-  glutInit(&argc, argv);
-
-  std::cerr << "============================================\n OpenGL configuration\n";
-  std::cerr << "    Vendor   : " << (char *)glGetString(GL_VENDOR) << "\n";
-  std::cerr << "    Version  : " << (char *)glGetString(GL_VERSION) << "\n";
-  std::cerr << "    Renderer : " << (char *)glGetString(GL_RENDERER) << "\n";
-  std::cerr << "============================================\n";
-
-  // Initialize IL (file decoding for texture definition)
-  ilInit();
- 
-
-  // Creaates a 3D viewer to display the scene
-  MxViewer viewer(window);
-
-  // Creates a scene of 3D objects
-  MxGLObjects::init();
-  MxScene scene;
-
-  // Creates a light (fixed and animated) and adds it to the scene
-  auto spLight = std::make_shared<MxLight>();
-  spLight->init({ 500.0f, 5000.0f, 1000.0f, 1.0f }, { 0.15f, 0.15f, 0.15f, 1.0f }, { 0.15f, 0.15f, 0.15f, 1.0f }, { 0.4f, 0.4f, 0.4f }, 1.0f);
-  scene.addObject(spLight, true);
-
-  // Creates a terrain from a jpeg file and adds it to the scene
-  auto spTerrain = std::make_shared<MxTerrain>();
-  spTerrain->init({ 2000.0f, 1000.0f }, {32, 16}, 350.0f, 64.0f, 100.0f, "Data/terrain1_128x64.jpg", "Data/reliefs.jpg", { 10.0f, 160.0f });
-  scene.addObject(spTerrain);
-  
-  // Creates 4 animations (fly, sun light move, morphing)  
-  auto spFlyAnimation       = std::make_shared<MxFlyAnimation>(1900.0f, 80.0f);
-  auto spLightAnimation     = std::make_shared<MxLightAnimation>(spLight, 12.0f);
-  auto spHeightAnimationMax = std::make_shared<MxHeightAnimation>(spTerrain, false, true, 12.0f);
-  auto spHeightAnimationMin = std::make_shared<MxHeightAnimation>(spTerrain, true, false, 12.0f);
-
-  std::vector<std::shared_ptr<MxAnimation>> animations;
-  animations.push_back(spFlyAnimation);
-  animations.push_back(spLightAnimation);
-  animations.push_back(spHeightAnimationMax);
-  animations.push_back(spHeightAnimationMin);
-
-  scene.addAnimation(spFlyAnimation);
-  scene.addAnimation(spLightAnimation);
-  scene.addAnimation(spHeightAnimationMax);
-  scene.addAnimation(spHeightAnimationMin);
-
-  uint32_t frame = 0;
-  bool running = true;
-  do
-  {
-    // Applies user's parameter modifications to the terrain
-    spTerrain->setWireframeMode(gWireframeMode);
-    spTerrain->setColorMode(gColorMode);
-    spTerrain->setIsolineStep(gIsolineMode == 0 ? 0.0f : getIsolineStep(gIsolineMode));
-    spTerrain->setFunctionalMode(gFunctionalMode == 0 ? 0.0f : pow(20.0f,(float)gFunctionalMode));
-    spTerrain->setMapMode(gMapMode);
-    spTerrain->setSmoothMode(gSmoothMode);
-    spTerrain->setShadowMode(gShadowMode);
-    spTerrain->setDistortionFactor(gDistortionFactor);
-    spTerrain->setMinHeight(-1.0f);
-    spTerrain->setMaxHeight(-1.0f);
-
-    // Reinits light to override animation modifications
-    spLight->init({ 500.0f, 5000.0f, 1000.0f, 1.0f }, { 0.15f, 0.15f, 0.15f, 1.0f }, { 0.25f, 0.25f, 0.25f, 1.0f }, { 0.4f, 0.4f, 0.4f }, 1.0f);
-
-    int timeBefore = glutGet(GLUT_ELAPSED_TIME);
-
-    static uint32_t anim = 0;
-    if (gAnimationMode != anim)
-    {
-      if (anim != 0)
-        animations[anim-1]->disable();
-      if (gAnimationMode != 0)
-      {
-        animations[gAnimationMode-1]->enable();
-        animations[gAnimationMode-1]->init(timeBefore);
-      }
-    }
-
-    anim = gAnimationMode;
-
-    scene.render(timeBefore, viewer.getViewMatrix(), viewer.getProjectionMatrix(), viewer.getViewport());
-    int timeAfter = glutGet(GLUT_ELAPSED_TIME);
-    
-    // Displays rednering info (duration, quantity of geo displayed/discared, active modes/parameters...)
-    displayInfo(viewer, scene, timeBefore, timeAfter, animations);
-
-    // Displays the help window if "h" key has been pressed
-    if (gDisplayHelp)
-      displayHelp(viewer);
-
-    glfwSwapBuffers(window);
-    glfwPollEvents();
-
-    running &= (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_RELEASE);
-    running &= (glfwWindowShouldClose(window) != GL_TRUE);
-
-    frame++;
-  } while (running);
-
-  glfwDestroyWindow(window);
-  glfwTerminate();
-}
-
-void displayInfo(const MxViewer& iViewer, const MxScene& iScene, uint32_t iBeforeTime, uint32_t iAfterTime, const std::vector<std::shared_ptr<MxAnimation>>& iAnimations)
-{
-  float dx = 2.0f / iViewer.getViewport()[0];
-  float dy = 2.0f / iViewer.getViewport()[1];
-
-  // Display information about rendering
-
-  glUseProgram(0);
-
-  glColor3f(0.0f, 0.0f, 0.0f);
-
-  glRasterPos2f(30*dx-1.0f, 45*dy-1.0f);
-  std::stringstream ss1;
-  if (gFunctionalMode != 0)
-    ss1 << "Function f(u,v)=" << gFunctionalMode << "*u(1-u).v(1-v)";
-  else
-  {
-    switch (gSmoothMode)
-    {
-    case 0:
-      ss1 << "Linear Height Interpolation, constant Normals";
-      break;
-    case 1:
-      ss1 << "Linear Interpolation (Height, Normals)";
-      break;
-    case 2:
-      ss1 << "Bicubic Interpolation (Height, Normals)";
-      break;
-    }
-  }
-
-  if (gAnimationMode != 0)
-  {
-    switch (gAnimationMode)
-    {
-    case 1:
-      ss1 << " | Animation #1: fly over the terrain";
-      break;
-    case 2:
-      ss1 << " | Animation #2: sun light from sunrise to sunset";
-      break;
-    case 3:
-      ss1 << " | Animation #3: terrain generation from ground to altitude";
-      break;
-    case 4:
-      ss1 << " | Animation #4: terrain generation from altitude to ground";
-      break;
-    }
-
-    ss1 << " [" << iAnimations[gAnimationMode-1]->getStage() << "]";
-    int fr = iAnimations[gAnimationMode - 1]->frozenUntil();
-    if (fr)
-    {
-      float duration = (fr - iBeforeTime) / 1000.0f;
-      int   nPart = (int)duration;
-      int   dPart = (int)(duration*10.0f) - nPart*10;
-      ss1 << " Frozen " << std::setw(2) << nPart << "." << dPart << " s";
-    }
-  }
-
-  switch (gColorMode)
-  {
-  case 1:
-    ss1 << " | Color Map";
-    break;
-  }
-
-  if (gIsolineMode > 0)
-  {
-    ss1 << " | isoline every " << getIsolineStep(gIsolineMode) << " units (orange)";
-  }
-    
-  switch (gMapMode)
-  {
-  case 1:
-    ss1 << " | Height Map vertices (red, green: projection on z=0)";
-    break;
-  case 2:
-    ss1 << " | Height Map network (red)";
-    break;
-  }
-
-  ss1 << " | Distortion factor=" << std::setprecision(3) << gDistortionFactor;
-  
-  switch (gWireframeMode)
-  {
-    case 1:
-      ss1 << " | Patch border (green) and subdivisions (blue)";
-      break;
-    case 2:
-      ss1 << " | Normals (white: triangle, pink: vertex from map)";
-      break;
-    case 3:
-      ss1 << " | Patch border (green) and subdivisions (blue), Normals (white: triangle, pink: vertex from map)";
-      break;
-  }
-
-  displayText(ss1.str(), GLUT_BITMAP_9_BY_15);
-
-  glRasterPos2f(30*dx-1.0f, 20*dy-1.0f);
-  std::stringstream ss2;
-  ss2 << "Duration=" << std::setw(4) << (iAfterTime-iBeforeTime) << "ms Patches sent=" << std::setw(7) << formatLongInt(iScene.getDrawnPatchNb()) << "/" << std::setw(7) << formatLongInt(iScene.getPatchNb()) << " Triangles=" << std::setw(10) << formatLongInt(iScene.getTriangleNb()) << " (discarded=" << std::setw(9) << formatLongInt(iScene.getDiscardedTriangleNb()) << ")";
-  displayText(ss2.str(), GLUT_BITMAP_9_BY_15);
-
-  float height = 70*dy;
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glColor4f(1.0f, 1.0f, 1.0f, 0.7f);
-  glBegin(GL_QUADS);
-  glVertex2f(-1.0f, -1.0f);
-  glVertex2f( 1.0f, -1.0f);
-  glVertex2f( 1.0f, -1.0f + height);
-  glVertex2f(-1.0f, -1.0f + height);
-  glEnd();
-  __CheckGLErrors; 
-  glDisable(GL_BLEND);
-  glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-  glLineWidth(2.0);
-  glBegin(GL_LINES);
-  glVertex2f(1.0f, -1.0f + height);
-  glVertex2f(-1.0f, -1.0f + height);
-  glEnd();
-  __CheckGLErrors;
-}
-
-void displayHelp(const MxViewer& iViewer)
-{
-  float dx = 2.0f / iViewer.getViewport()[0];
-  float dy = 2.0f / iViewer.getViewport()[1];
-
-  // Display information about rendering
-
-  glUseProgram(0);
-
-  glColor3f(1.0f, 1.0f, 1.0f);
-  glRasterPos2f(365*dx-1.0f, -250*dy+1.0f);
-  displayText("KEY*", GLUT_BITMAP_TIMES_ROMAN_24);
-
-  glRasterPos2f(750*dx-1.0f, -250*dy+1.0f);
-  displayText("COMMAND", GLUT_BITMAP_TIMES_ROMAN_24);
-
-  const std::string texts1[] = { "H", "Q", "+/-", "C", "A", "I", "F", "S", "W" };
-  const std::string texts2[] = { "Show | Hide this help menu", "Quality of interpolation for position (linear, bicubic) and tangent (constant, linear, bicubic)", "Increase | Decrease tesselation factor based on height distortion",
-                                 "Color Map (coloring terrain according a texture map)", "Animations: fly over, sunlight simulation, building terrain from bottom to top and vice versa",
-                                 "Isoline display (different pre-defined values of heights)", "Replace Height Map with functional height (for debug)", "Shadow, alternative method to shadow mapping", "Show | Hide Wireframe representation: borders of patch (green) or/and normals" };
-  for (uint32_t iLine = 0; iLine < SizeOfTable(texts1); iLine++)
-  {
-    glRasterPos2f(380 * dx - 1.0f, -40.0f*iLine*dy-330*dy+1.0f);
-    displayText(texts1[iLine], GLUT_BITMAP_HELVETICA_18);
-
-    glRasterPos2f(480 * dx - 1.0f, -40.0f*iLine*dy-330*dy+1.0f);
-    displayText(texts2[iLine], GLUT_BITMAP_HELVETICA_18);
-  }
-
-  glRasterPos2f(360*dx-1.0f, -720*dy+1.0f);
-  displayText("* repeat key stroke to go to the next circular choice", GLUT_BITMAP_HELVETICA_18);
-  
-  float deltaX = 180 * dx;
-  float deltaY = 180 * dy;
-
-  for (int i = 0; i < 2; i++)
-  {
-    if (i == 0)
-    {
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      glColor4f(1.0f, 0.0f, 0.0f, 0.35f);
-      glBegin(GL_QUADS);
-    }
-    else
-    {
-      glDisable(GL_BLEND);
-      glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
-      glLineWidth(2.0);
-      glBegin(GL_LINE_LOOP);
-    }
-
-    glVertex2f(deltaX - 1.0f, deltaY +70*dy - 1.0f);
-    glVertex2f(-deltaX + 1.0f, deltaY + 70 * dy - 1.0f);
-    glVertex2f(-deltaX + 1.0f, -deltaY + 1.0f);
-    glVertex2f(deltaX - 1.0f, -deltaY + 1.0f);
-    glEnd();
-    __CheckGLErrors;
-  }
-}
-
-std::string formatLongInt(uint32_t iNumber)
-{
-  std::string nbstr = std::to_string(iNumber);
-  std::string nbstrSep;
-  uint32_t nb = 0;
-  for (int32_t n = nbstr.length() - 1; n >= 0; n--)
-  {
-    nbstrSep.insert(nbstrSep.begin(), nbstr[n]);
-    nb++;
-    if (nb % 3 == 0 && n != 0)
-      nbstrSep.insert(nbstrSep.begin(), ',');
-  }
-
-  return nbstrSep;
-}
-
-void displayText(const std::string& i2DText, void* iFont)
-{
-  int len = i2DText.length();
-  for (int i = 0; i < len; i++)
-  {
-    glutBitmapCharacter(iFont, i2DText[i]);
-  }
-  __CheckGLErrors;
-}
-
-void onCharKeyPressed(GLFWwindow* window, unsigned int key)
-{
-  if (key == 'a' || key == 'A')
-    ++gAnimationMode %= 5;
-  else if (key == 'c' || key == 'C')
-    ++gColorMode %= 2;
-  else if (key == 'f' || key == 'F')
-    ++gFunctionalMode %= 4;
-  else if (key == 'h' || key == 'H')
-    ++gDisplayHelp %= 2;
-  else if (key == 'i' || key == 'I')
-    ++gIsolineMode %= 6;
-  else if (key == 'm' || key == 'M')
-    ++gMapMode %= 3;
-  else if (key == 'q' || key == 'Q')
-    ++gSmoothMode %= 3;
-  else if (key == 's' || key == 'S')
-    ++gShadowMode %= 2;
-  else if (key == 'w' || key == 'W')
-    ++gWireframeMode %= 4;
-  else if (key == '+')
-    gDistortionFactor *= 1.1f;
-  else if (key == '-' && gDistortionFactor > 1.0f)
-    gDistortionFactor /= 1.1f;
-}
-
-float getIsolineStep(uint32_t iMode)
-{
-  float steps[] = { 5.0f, 10.0f, 50.0f };
-  return steps[(gIsolineMode - 1) % SizeOfTable(steps)] * pow(10.0f, (float)((gIsolineMode - 1) / SizeOfTable(steps)));
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include <gl/glew.h>
+#include <gl/freeglut.h>
+#include <glfw/glfw3.h>
+
+#include <IL/il.h>
+//#include <IL/ilut.h>
+
+#include "UxUtils.h"
+#include "UxGLState.h"
+#include "UxFrameArena.h"
+#include "UxAllocationCounter.h"
+#include "UxResidencyManager.h"
+#include "UxGPUMemoryRegistry.h"
+#include "UxUploadThread.h"
+#include "MxViewer.h"
+#include "MxGLObjects.h"
+#include "MxScene.h"
+#include "MxTerrain.h"
+#include "MxTerrainAsset.h"
+#include "MxLight.h"
+#include "MxFlyAnimation.h"
+#include "MxLightAnimation.h"
+#include "MxHeightAnimation.h"
+
+#include <cstdio>
+#include <cstring>
+
+static uint32_t gWireframeMode = 0;
+static uint32_t gColorMode = 0;
+static uint32_t gIsolineMode = 0;
+static uint32_t gFunctionalMode = 0;
+static uint32_t gMapMode = 0;
+static uint32_t gSmoothMode = 0;
+static uint32_t gAnimationMode = 0;
+static uint32_t gShadowMode = 0;
+static uint32_t gDisplayHelp = 0;
+static uint32_t gCacheMode = 0;
+static uint32_t gPipelineMode = 0;
+static uint32_t gPatchOrderMode = 1;
+static float    gDistortionFactor = 4.0f;
+static uint32_t gFrameAllocationNb = 0;
+static const char* gAllocationReportPath = nullptr;
+static GLenum   gHeightFormat = 0;
+static const char* gHeightMapPath = "Data/terrain1_128x64.jpg";
+static uint32_t gRawWidth = 0;
+static uint32_t gRawHeight = 0;
+static const char* gBakePath = nullptr;
+static const char* gTerrainLoadingStage = nullptr;
+static uint32_t gTileGPUBudget = 0;
+static uint32_t gTileCPUBudget = 0;
+static const MxTileCache::Statistics* gTileStatistics = nullptr;
+static uint32_t gResidencyBudget = 0;
+static const char* gGPUMemoryReportPath = nullptr;
+
+void onCharKeyPressed(GLFWwindow* window, unsigned int key);
+float getIsolineStep(uint32_t iMode);
+const char* formatLongInt(uint32_t iNumber);
+void displayText(const char* i2DText, void* iFont);
+void displayInfo(const MxViewer& iViewer, const MxScene& iScene, uint32_t iBeforeTime, uint32_t iAfterTime, const std::vector<std::shared_ptr<MxAnimation>>& iAnimations);
+void displayHelp(const MxViewer& iViewer);
+
+void main(int argc, char **argv)
+{
+  // Options "--allocation-report <file.json>": allocations attributed per subsystem (overlay) and written at exit,
+  // "--height-format r8|r16|r16f|r32f": storage of the height map (by default following the image precision),
+  // "--height-map <file>": image, raw file or baked asset (.hmt) of the terrain,
+  // "--raw-size <W>x<H>": dimensions of a raw height map (square by default),
+  // "--bake <file.hmt>": bakes the height map into an asset (mapped at the next starts) and exits,
+  // "--streaming <GPU MB>:<CPU MB>": height map of the asset streamed by tiles under both budgets,
+  // "--residency <MB>": budget of the resident bindless textures (unused ones evicted),
+  // "--gpu-memory-report <file.json>": buffers and textures alive at exit, sorted by size
+  const char*  formatNames[] = { "r8", "r16", "r16f", "r32f" };
+  const GLenum formats[]     = { GL_R8, GL_R16, GL_R16F, GL_R32F };
+  for (int arg = 1; arg < argc - 1; arg++)
+  {
+    if (strcmp(argv[arg], "--allocation-report") == 0)
+      gAllocationReportPath = argv[arg+1];
+    else if (strcmp(argv[arg], "--height-format") == 0)
+    {
+      for (uint32_t format = 0; format < SizeOfTable(formats); format++)
+      {
+        if (strcmp(argv[arg+1], formatNames[format]) == 0)
+          gHeightFormat = formats[format];
+      }
+    }
+    else if (strcmp(argv[arg], "--height-map") == 0)
+      gHeightMapPath = argv[arg+1];
+    else if (strcmp(argv[arg], "--raw-size") == 0)
+      sscanf_s(argv[arg+1], "%ux%u", &gRawWidth, &gRawHeight);
+    else if (strcmp(argv[arg], "--bake") == 0)
+      gBakePath = argv[arg+1];
+    else if (strcmp(argv[arg], "--streaming") == 0)
+      sscanf_s(argv[arg+1], "%u:%u", &gTileGPUBudget, &gTileCPUBudget);
+    else if (strcmp(argv[arg], "--residency") == 0)
+      sscanf_s(argv[arg+1], "%u", &gResidencyBudget);
+    else if (strcmp(argv[arg], "--gpu-memory-report") == 0)
+      gGPUMemoryReportPath = argv[arg+1];
+  }
+
+  // Offline bake step (no GL context needed)
+  if (gBakePath)
+  {
+    ilInit();
+    UxUtils::HeightImage image;
+    UxUtils::decodeHeightMap(gHeightMapPath, gHeightFormat, image, nullptr, Vector2i(gRawWidth, gRawHeight));
+    if (!MxTerrainAsset::bake(image, gBakePath))
+      std::cerr << "Failed to write the terrain asset " << gBakePath << "\n";
+    return;
+  }
+  UxAllocationCounter::setTracking(gAllocationReportPath != nullptr);
+
+   if (!glfwInit())
+  {
+    std::cerr << "Failed to initialize GLFW\n";
+    return;
+  }
+
+  GLFWwindow* window = glfwCreateWindow(1800, 1000, "Heightmap Terrain", /*glfwGetPrimaryMonitor()*/ NULL, NULL);
+  if (!window)
+  {
+    std::cerr << "Failed to open window\n";
+    return;
+  }
+
+  // Hidden window whose context shares the objects of the rendering one: textures created by the upload thread
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  GLFWwindow* uploadWindow = glfwCreateWindow(1, 1, "Upload", NULL, window);
+  glfwDefaultWindowHints();
+  if (!uploadWindow)
+  {
+    std::cerr << "Failed to create the upload context\n";
+    return;
+  }
+
+  glfwMakeContextCurrent(window);
+  glfwSetCharCallback(window, onCharKeyPressed);
+
+  glewInit();
+  glutInit(&argc, argv);
+
+  std::cerr << "============================================\n OpenGL configuration\n";
+  std::cerr << "    Vendor   : " << (char *)glGetString(GL_VENDOR) << "\n";
+  std::cerr << "    Version  : " << (char *)glGetString(GL_VERSION) << "\n";
+  std::cerr << "    Renderer : " << (char *)glGetString(GL_RENDERER) << "\n";
+  std::cerr << "============================================\n";
+
+  // Initialize IL (file decoding for texture definition)
+  ilInit();
+
+  // GL objects created and filled off the render loop (terrain loading)
+  UxUploadThread::start([uploadWindow](bool iCurrent) { glfwMakeContextCurrent(iCurrent ? uploadWindow : NULL); });
+ 
+
+  // Creaates a 3D viewer to display the scene
+  MxViewer viewer(window);
+
+  // Creates a scene of 3D objects
+  MxGLObjects::init();
+  MxScene scene;
+
+  // Creates a light (fixed and animated) and adds it to the scene
+  auto spLight = std::make_shared<MxLight>();
+  spLight->init({ 500.0f, 5000.0f, 1000.0f, 1.0f }, { 0.15f, 0.15f, 0.15f, 1.0f }, { 0.15f, 0.15f, 0.15f, 1.0f }, { 0.4f, 0.4f, 0.4f }, 1.0f);
+  scene.addObject(spLight, true);
+
+  // Creates a terrain from a jpeg file and adds it to the scene (drawn once loaded, the render loop going on meanwhile)
+  UxResidencyManager::setBudget((uint64_t)gResidencyBudget << 20);
+  auto spTerrain = std::make_shared<MxTerrain>();
+  spTerrain->setViewPathPredictor([&scene](int iTime, Vector3f& oEyeView, Vector3f& oEyeDirection) { return scene.predictView(iTime, oEyeView, oEyeDirection); });
+  spTerrain->setStreamingBudgets((uint64_t)gTileGPUBudget << 20, (uint64_t)gTileCPUBudget << 20);
+  spTerrain->setRawSize(Vector2i(gRawWidth, gRawHeight));
+  spTerrain->initAsync({ 2000.0f, 1000.0f }, {32, 16}, 350.0f, 64.0f, 100.0f, gHeightMapPath, "Data/reliefs.jpg", { 10.0f, 160.0f }, gHeightFormat);
+  scene.addObject(spTerrain);
+  
+  // Creates 4 animations (fly, sun light move, morphing)  
+  auto spFlyAnimation       = std::make_shared<MxFlyAnimation>(1900.0f, 80.0f);
+  auto spLightAnimation     = std::make_shared<MxLightAnimation>(spLight, 12.0f);
+  auto spHeightAnimationMax = std::make_shared<MxHeightAnimation>(spTerrain, false, true, 12.0f);
+  auto spHeightAnimationMin = std::make_shared<MxHeightAnimation>(spTerrain, true, false, 12.0f);
+
+  std::vector<std::shared_ptr<MxAnimation>> animations;
+  animations.push_back(spFlyAnimation);
+  animations.push_back(spLightAnimation);
+  animations.push_back(spHeightAnimationMax);
+  animations.push_back(spHeightAnimationMin);
+
+  scene.addAnimation(spFlyAnimation);
+  scene.addAnimation(spLightAnimation);
+  scene.addAnimation(spHeightAnimationMax);
+  scene.addAnimation(spHeightAnimationMin);
+
+  // Per-frame data (info texts, animation stages...) allocated in the frame arena
+  UxFrameArena::reserve(64*1024);
+
+  uint32_t frame = 0;
+  bool running = true;
+  do
+  {
+    UxFrameArena::reset();
+    uint64_t allocationNb = UxAllocationCounter::getAllocationNb();
+
+    // Applies user's parameter modifications to the terrain
+    spTerrain->setWireframeMode(gWireframeMode);
+    spTerrain->setColorMode(gColorMode);
+    spTerrain->setIsolineStep(gIsolineMode == 0 ? 0.0f : getIsolineStep(gIsolineMode));
+    spTerrain->setFunctionalMode(gFunctionalMode == 0 ? 0.0f : pow(20.0f,(float)gFunctionalMode));
+    spTerrain->setMapMode(gMapMode);
+    spTerrain->setSmoothMode(gSmoothMode);
+    spTerrain->setShadowMode(gShadowMode);
+    spTerrain->setDistortionFactor(gDistortionFactor);
+    spTerrain->setCacheMode(gCacheMode);
+    spTerrain->setPipelineMode(gPipelineMode);
+    spTerrain->setPatchOrderMode(gPatchOrderMode);
+    spTerrain->setMinHeight(-1.0f);
+    spTerrain->setMaxHeight(-1.0f);
+
+    // Reinits light to override animation modifications
+    spLight->init({ 500.0f, 5000.0f, 1000.0f, 1.0f }, { 0.15f, 0.15f, 0.15f, 1.0f }, { 0.25f, 0.25f, 0.25f, 1.0f }, { 0.4f, 0.4f, 0.4f }, 1.0f);
+
+    int timeBefore = glutGet(GLUT_ELAPSED_TIME);
+
+    static uint32_t anim = 0;
+    if (gAnimationMode != anim)
+    {
+      if (anim != 0)
+        animations[anim-1]->disable();
+      if (gAnimationMode != 0)
+      {
+        animations[gAnimationMode-1]->enable();
+        animations[gAnimationMode-1]->init(timeBefore);
+      }
+    }
+
+    anim = gAnimationMode;
+
+    scene.render(timeBefore, viewer.getViewMatrix(), viewer.getProjectionMatrix(), viewer.getViewport());
+    int timeAfter = glutGet(GLUT_ELAPSED_TIME);
+    gTerrainLoadingStage = spTerrain->isReady() ? nullptr : spTerrain->getLoadingStage();
+    gTileStatistics      = spTerrain->isStreamed() ? &spTerrain->getTileStatistics() : nullptr;
+    
+    // Displays rednering info (duration, quantity of geo displayed/discared, active modes/parameters...)
+    displayInfo(viewer, scene, timeBefore, timeAfter, animations);
+
+    // Displays the help window if "h" key has been pressed
+    if (gDisplayHelp)
+      displayHelp(viewer);
+
+    glfwSwapBuffers(window);
+    glfwPollEvents();
+
+    // Heap allocations of the frame (0 in steady state, displayed at the next frame)
+    gFrameAllocationNb = (uint32_t)(UxAllocationCounter::getAllocationNb() - allocationNb);
+    UxAllocationCounter::endFrame();
+    UxResidencyManager::endFrame();
+    UxGPUMemoryRegistry::endFrame();
+
+    running &= (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_RELEASE);
+    running &= (glfwWindowShouldClose(window) != GL_TRUE);
+
+    frame++;
+  } while (running);
+
+  // Loading in progress completed before the upload context is released
+  spTerrain->updateLoading(true);
+  UxUploadThread::stop();
+  glfwDestroyWindow(uploadWindow);
+  glfwDestroyWindow(window);
+  glfwTerminate();
+
+  if (gAllocationReportPath && !UxAllocationCounter::writeJSON(gAllocationReportPath))
+    std::cerr << "Failed to write the allocation report " << gAllocationReportPath << "\n";
+  if (gGPUMemoryReportPath && !UxGPUMemoryRegistry::writeJSON(gGPUMemoryReportPath))
+    std::cerr << "Failed to write the GPU memory report " << gGPUMemoryReportPath << "\n";
+}
+
+void displayInfo(const MxViewer& iViewer, const MxScene& iScene, uint32_t iBeforeTime, uint32_t iAfterTime, const std::vector<std::shared_ptr<MxAnimation>>& iAnimations)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::OverlayText);
+
+  float dx = 2.0f / iViewer.getViewport()[0];
+  float dy = 2.0f / iViewer.getViewport()[1];
+
+  // Display information about rendering
+
+  UxGLState::useProgram(0);
+
+  glColor3f(0.0f, 0.0f, 0.0f);
+
+  glRasterPos2f(30*dx-1.0f, 45*dy-1.0f);
+  UxFrameText ss1(1024);
+  if (gFunctionalMode != 0)
+    ss1.append("Function f(u,v)=%u*u(1-u).v(1-v)", gFunctionalMode);
+  else
+  {
+    switch (gSmoothMode)
+    {
+    case 0:
+      ss1.append("Linear Height Interpolation, constant Normals");
+      break;
+    case 1:
+      ss1.append("Linear Interpolation (Height, Normals)");
+      break;
+    case 2:
+      ss1.append("Bicubic Interpolation (Height, Normals)");
+      break;
+    }
+  }
+
+  if (gAnimationMode != 0)
+  {
+    switch (gAnimationMode)
+    {
+    case 1:
+      ss1.append(" | Animation #1: fly over the terrain");
+      break;
+    case 2:
+      ss1.append(" | Animation #2: sun light from sunrise to sunset");
+      break;
+    case 3:
+      ss1.append(" | Animation #3: terrain generation from ground to altitude");
+      break;
+    case 4:
+      ss1.append(" | Animation #4: terrain generation from altitude to ground");
+      break;
+    }
+
+    ss1.append(" [%s]", iAnimations[gAnimationMode-1]->getStage());
+    int fr = iAnimations[gAnimationMode - 1]->frozenUntil();
+    if (fr)
+    {
+      float duration = (fr - iBeforeTime) / 1000.0f;
+      int   nPart = (int)duration;
+      int   dPart = (int)(duration*10.0f) - nPart*10;
+      ss1.append(" Frozen %2d.%d s", nPart, dPart);
+    }
+  }
+
+  switch (gColorMode)
+  {
+  case 1:
+    ss1.append(" | Color Map");
+    break;
+  }
+
+  if (gIsolineMode > 0)
+  {
+    ss1.append(" | isoline every %g units (orange)", getIsolineStep(gIsolineMode));
+  }
+    
+  switch (gMapMode)
+  {
+  case 1:
+    ss1.append(" | Height Map vertices (red, green: projection on z=0)");
+    break;
+  case 2:
+    ss1.append(" | Height Map network (red)");
+    break;
+  }
+
+  ss1.append(" | Distortion factor=%.3g", gDistortionFactor);
+  
+  switch (gWireframeMode)
+  {
+    case 1:
+      ss1.append(" | Patch border (green) and subdivisions (blue)");
+      break;
+    case 2:
+      ss1.append(" | Normals (white: triangle, pink: vertex from map)");
+      break;
+    case 3:
+      ss1.append(" | Patch border (green) and subdivisions (blue), Normals (white: triangle, pink: vertex from map)");
+      break;
+    case 4:
+      ss1.append(" | Patch border (green) and subdivisions (blue) in fill pass");
+      break;
+    case 5:
+      ss1.append(" | Patch border (green) and subdivisions (blue) in fill pass, Normals (white: triangle, pink: vertex from map)");
+      break;
+  }
+
+  if (gCacheMode != 0)
+    ss1.append(" | Cached tesselation");
+
+  if (gPipelineMode == 1)
+    ss1.append(" | GPU subdivision (compute shaders)");
+  else if (gPipelineMode == 2)
+    ss1.append(" | Tesselation without geometry shader");
+
+  if (gPatchOrderMode == 0)
+    ss1.append(" | Row-major patch order");
+  if (gTerrainLoadingStage)
+    ss1.append(" | Loading terrain (%s)", gTerrainLoadingStage);
+
+  displayText(ss1.c_str(), GLUT_BITMAP_9_BY_15);
+
+  glRasterPos2f(30*dx-1.0f, 20*dy-1.0f);
+  UxFrameText ss2(768);
+  ss2.append("Duration=%4u", iAfterTime-iBeforeTime);
+  ss2.append("ms Patches sent=%7s/%7s", formatLongInt(iScene.getDrawnPatchNb()), formatLongInt(iScene.getPatchNb()));
+  ss2.append(" Triangles=%10s (discarded=%9s)", formatLongInt(iScene.getTriangleNb()), formatLongInt(iScene.getDiscardedTriangleNb()));
+  ss2.append(" Allocations=%u", gFrameAllocationNb);
+  if (UxAllocationCounter::isTracking())
+  {
+    // Subsystems having allocated during the previous frame (number/bytes)
+    for (uint32_t tag = 0; tag < UxAllocationCounter::TagNb; tag++)
+    {
+      const UxAllocationCounter::Statistics& frame = UxAllocationCounter::getLastFrame((UxAllocationCounter::Tag)tag);
+      if (frame.allocationNb != 0)
+        ss2.append(" %s=%u/%s", UxAllocationCounter::getTagName((UxAllocationCounter::Tag)tag), (uint32_t)frame.allocationNb, formatLongInt((uint32_t)frame.allocatedSize));
+    }
+  }
+  if (gTileStatistics)
+  {
+    // Streamed height map: tiles of the view, missing ones (ancestor drawn) and cache activity since the start
+    ss2.append(" Tiles=%u/%u/%u (missing=%u)", gTileStatistics->neededTileNb, gTileStatistics->residentTileNb, gTileStatistics->layerNb, gTileStatistics->missingTileNb);
+    ss2.append(" Cached=%sKB Loads=%u Evictions=%u/%u", formatLongInt((uint32_t)(gTileStatistics->cachedSize >> 10)), (uint32_t)gTileStatistics->loadNb, (uint32_t)gTileStatistics->gpuEvictionNb, (uint32_t)gTileStatistics->cpuEvictionNb);
+    // Prefetch: tiles of the predicted views, share of the prefetched tiles available in time, tiles read too late
+    uint32_t hitRate = gTileStatistics->prefetchNb ? (uint32_t)(100 * gTileStatistics->prefetchHitNb / gTileStatistics->prefetchNb) : 0;
+    ss2.append(" Prefetch=%u (hits=%u%%, late=%u)", gTileStatistics->predictedTileNb, hitRate, (uint32_t)gTileStatistics->lateLoadNb);
+  }
+  // Bindless textures: resident/registered, bytes sampled by the frame and resident, budget evictions and thrashing
+  const UxResidencyManager::Statistics& residency = UxResidencyManager::getStatistics();
+  ss2.append(" Resident=%u/%u (%sKB", residency.residentHandleNb, residency.handleNb, formatLongInt((uint32_t)(residency.usedSize >> 10)));
+  ss2.append("/%sKB) Evictions=%u (thrash=%u)", formatLongInt((uint32_t)(residency.residentSize >> 10)), (uint32_t)residency.evictionNb, (uint32_t)residency.thrashNb);
+  // GPU memory recorded at the end of the previous frame: buffers and textures, peak of the frame
+  const UxGPUMemoryRegistry::Statistics& buffers  = UxGPUMemoryRegistry::getLastFrame(UxGPUMemoryRegistry::Buffer);
+  const UxGPUMemoryRegistry::Statistics& textures = UxGPUMemoryRegistry::getLastFrame(UxGPUMemoryRegistry::Texture);
+  ss2.append(" GPU=%sKB", formatLongInt((uint32_t)(buffers.size >> 10)));
+  ss2.append("+%sKB", formatLongInt((uint32_t)(textures.size >> 10)));
+  ss2.append(" (peak=%sKB)", formatLongInt((uint32_t)((buffers.peakSize + textures.peakSize) >> 10)));
+  displayText(ss2.c_str(), GLUT_BITMAP_9_BY_15);
+
+  float height = 70*dy;
+  UxGLState::enable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glColor4f(1.0f, 1.0f, 1.0f, 0.7f);
+  glBegin(GL_QUADS);
+  glVertex2f(-1.0f, -1.0f);
+  glVertex2f( 1.0f, -1.0f);
+  glVertex2f( 1.0f, -1.0f + height);
+  glVertex2f(-1.0f, -1.0f + height);
+  glEnd();
+  __CheckGLErrors; 
+  UxGLState::disable(GL_BLEND);
+  glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+  glLineWidth(2.0);
+  glBegin(GL_LINES);
+  glVertex2f(1.0f, -1.0f + height);
+  glVertex2f(-1.0f, -1.0f + height);
+  glEnd();
+  __CheckGLErrors;
+}
+
+void displayHelp(const MxViewer& iViewer)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::OverlayText);
+
+  float dx = 2.0f / iViewer.getViewport()[0];
+  float dy = 2.0f / iViewer.getViewport()[1];
+
+  // Display information about rendering
+
+  UxGLState::useProgram(0);
+
+  glColor3f(1.0f, 1.0f, 1.0f);
+  glRasterPos2f(365*dx-1.0f, -250*dy+1.0f);
+  displayText("KEY*", GLUT_BITMAP_TIMES_ROMAN_24);
+
+  glRasterPos2f(750*dx-1.0f, -250*dy+1.0f);
+  displayText("COMMAND", GLUT_BITMAP_TIMES_ROMAN_24);
+
+  const char* texts1[] = { "H", "Q", "+/-", "C", "A", "I", "F", "S", "W", "K", "P", "O" };
+  const char* texts2[] = { "Show | Hide this help menu", "Quality of interpolation for position (linear, bicubic) and tangent (constant, linear, bicubic)", "Increase | Decrease tesselation factor based on height distortion",
+                                 "Color Map (coloring terrain according a texture map)", "Animations: fly over, sunlight simulation, building terrain from bottom to top and vice versa",
+                                 "Isoline display (different pre-defined values of heights)", "Replace Height Map with functional height (for debug)", "Shadow, alternative method to shadow mapping", "Show | Hide Wireframe representation: borders of patch (green) or/and normals, borders drawn by the fill pass",
+                                 "Keep the tesselated terrain while camera, light and parameters are unchanged", "Subdivision pipeline: hardware tesselation, adaptive subdivision computed on GPU, tesselation without geometry shader",
+                                 "Order of the patches sent to draw: front-to-back from the eye, row-major" };
+  for (uint32_t iLine = 0; iLine < SizeOfTable(texts1); iLine++)
+  {
+    glRasterPos2f(380 * dx - 1.0f, -32.0f*iLine*dy-330*dy+1.0f);
+    displayText(texts1[iLine], GLUT_BITMAP_HELVETICA_18);
+
+    glRasterPos2f(480 * dx - 1.0f, -32.0f*iLine*dy-330*dy+1.0f);
+    displayText(texts2[iLine], GLUT_BITMAP_HELVETICA_18);
+  }
+
+  glRasterPos2f(360*dx-1.0f, -720*dy+1.0f);
+  displayText("* repeat key stroke to go to the next circular choice", GLUT_BITMAP_HELVETICA_18);
+  
+  float deltaX = 180 * dx;
+  float deltaY = 180 * dy;
+
+  for (int i = 0; i < 2; i++)
+  {
+    if (i == 0)
+    {
+      UxGLState::enable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glColor4f(1.0f, 0.0f, 0.0f, 0.35f);
+      glBegin(GL_QUADS);
+    }
+    else
+    {
+      UxGLState::disable(GL_BLEND);
+      glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
+      glLineWidth(2.0);
+      glBegin(GL_LINE_LOOP);
+    }
+
+    glVertex2f(deltaX - 1.0f, deltaY +70*dy - 1.0f);
+    glVertex2f(-deltaX + 1.0f, deltaY + 70 * dy - 1.0f);
+    glVertex2f(-deltaX + 1.0f, -deltaY + 1.0f);
+    glVertex2f(deltaX - 1.0f, -deltaY + 1.0f);
+    glEnd();
+    __CheckGLErrors;
+  }
+}
+
+const char* formatLongInt(uint32_t iNumber)
+{
+  char nbstr[16];
+  int32_t len = snprintf(nbstr, sizeof(nbstr), "%u", iNumber);
+
+  // Digits copied from the end, a separator every 3 digits (text valid until the end of the frame)
+  int32_t sepLen = len + (len - 1) / 3;
+  char* nbstrSep = UxFrameArena::allocate<char>(sepLen + 1);
+  nbstrSep[sepLen] = '\0';
+  uint32_t nb = 0;
+  for (int32_t n = len - 1, m = sepLen - 1; n >= 0; n--)
+  {
+    nbstrSep[m--] = nbstr[n];
+    nb++;
+    if (nb % 3 == 0 && n != 0)
+      nbstrSep[m--] = ',';
+  }
+
+  return nbstrSep;
+}
+
+void displayText(const char* i2DText, void* iFont)
+{
+  for (const char* c = i2DText; *c; c++)
+  {
+    glutBitmapCharacter(iFont, *c);
+  }
+  __CheckGLErrors;
+}
+
+void onCharKeyPressed(GLFWwindow* window, unsigned int key)
+{
+  if (key == 'a' || key == 'A')
+    ++gAnimationMode %= 5;
+  else if (key == 'c' || key == 'C')
+    ++gColorMode %= 2;
+  else if (key == 'f' || key == 'F')
+    ++gFunctionalMode %= 4;
+  else if (key == 'h' || key == 'H')
+    ++gDisplayHelp %= 2;
+  else if (key == 'i' || key == 'I')
+    ++gIsolineMode %= 6;
+  else if (key == 'm' || key == 'M')
+    ++gMapMode %= 3;
+  else if (key == 'q' || key == 'Q')
+    ++gSmoothMode %= 3;
+  else if (key == 's' || key == 'S')
+    ++gShadowMode %= 2;
+  else if (key == 'w' || key == 'W')
+    ++gWireframeMode %= 6;
+  else if (key == 'k' || key == 'K')
+    ++gCacheMode %= 2;
+  else if (key == 'p' || key == 'P')
+    ++gPipelineMode %= 3;
+  else if (key == 'o' || key == 'O')
+    ++gPatchOrderMode %= 2;
+  else if (key == '+')
+    gDistortionFactor *= 1.1f;
+  else if (key == '-' && gDistortionFactor > 1.0f)
+    gDistortionFactor /= 1.1f;
+}
+
+float getIsolineStep(uint32_t iMode)
+{
+  float steps[] = { 5.0f, 10.0f, 50.0f };
+  return steps[(gIsolineMode - 1) % SizeOfTable(steps)] * pow(10.0f, (float)((gIsolineMode - 1) / SizeOfTable(steps)));
+}
@@ -0,0 +1,113 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <string>
+
+//========================================================================
+//  Allocation Counter:
+//    Counts the heap allocations made through the global operators new
+//    (replaced by this module) and calls an optional hook on each one,
+//    to check that a code section (ie the steady state of the render
+//    loop) allocates nothing. Allocations made by the C runtime or the
+//    drivers (malloc) are not seen.
+//    When tracking is enabled, allocations are also attributed to the
+//    subsystem of the innermost allocation scope of the thread, per
+//    frame (endFrame) and in total, for the overlay and a JSON report.
+//========================================================================
+
+class UxAllocationCounter
+{
+public:
+  // Called on every allocation (size requested), ie to break on an unexpected allocation
+  typedef void (*Hook)(size_t iSize);
+
+  // Subsystems allocations are attributed to
+  enum Tag
+  {
+    Untagged,
+    TerrainData,          // MxTerrain data generation (heights, patches sent)
+    ShaderPreprocessing,  // UxShader loading and UxReportManager directives
+    BufferStaging,        // Vertex/index data staged before GL buffers
+    OverlayText,          // Texts of the info and help overlays
+    TagNb
+  };
+
+  struct Statistics
+  {
+    uint64_t allocationNb;
+    uint64_t allocatedSize;
+  };
+
+private:
+  static std::atomic<uint64_t>  _AllocationNb;
+  static std::atomic<uint64_t>  _AllocatedSize;
+  static Hook                   _Hook;
+
+  static std::atomic<bool>      _Tracking;                   // Set by the rendering thread, read by the allocating threads
+  static thread_local Tag       _CurrentTag;
+  static std::atomic<uint64_t>  _FrameAllocationNb[TagNb];   // Current frame
+  static std::atomic<uint64_t>  _FrameAllocatedSize[TagNb];
+  static Statistics             _LastFrame[TagNb];           // Updated by endFrame
+  static Statistics             _MaxFrame[TagNb];
+  static Statistics             _Total[TagNb];
+  static uint64_t               _FrameNb;
+
+public:
+
+  __DeclareDeletedCtor(UxAllocationCounter)
+
+  static uint64_t getAllocationNb() { return _AllocationNb.load(std::memory_order_relaxed); }
+  static uint64_t getAllocatedSize() { return _AllocatedSize.load(std::memory_order_relaxed); }
+
+  static void setHook(Hook iHook) { _Hook = iHook; }
+
+  // Counts an allocation (called by the replaced operators new)
+  static void count(size_t iSize);
+
+  // Attribution per subsystem (off by default: only the global counts are maintained)
+  static void setTracking(bool iTracking) { _Tracking.store(iTracking, std::memory_order_relaxed); }
+  static bool isTracking() { return _Tracking.load(std::memory_order_relaxed); }
+
+  static Tag  getCurrentTag() { return _CurrentTag; }
+  static void setCurrentTag(Tag iTag) { _CurrentTag = iTag; }
+
+  // Closes the statistics of the frame (to be called once per frame, at the end of the loop)
+  static void endFrame();
+
+  static const char*       getTagName(Tag iTag);
+  static const Statistics& getLastFrame(Tag iTag) { return _LastFrame[iTag]; }
+  static const Statistics& getMaxFrame(Tag iTag) { return _MaxFrame[iTag]; }
+  static const Statistics& getTotal(Tag iTag) { return _Total[iTag]; }
+  static uint64_t          getFrameNb() { return _FrameNb; }
+
+  // Writes the statistics per subsystem (last frame, peak frame, total) in a JSON file
+  static bool writeJSON(const std::string& iFileName);
+};
+
+
+//========================================================================
+//  Allocation Scope:
+//    Attributes the allocations of the thread to a subsystem until the
+//    end of the C++ scope (previous tag restored, scopes may be nested).
+//========================================================================
+
+class UxAllocationScope
+{
+private:
+  UxAllocationCounter::Tag _PreviousTag;
+
+public:
+  UxAllocationScope(UxAllocationCounter::Tag iTag) : _PreviousTag(UxAllocationCounter::getCurrentTag()) { UxAllocationCounter::setCurrentTag(iTag); }
+  ~UxAllocationScope() { UxAllocationCounter::setCurrentTag(_PreviousTag); }
+  __DeclareDeletedCtorsAndAssignments(UxAllocationScope)
+};
@@ -0,0 +1,76 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+//========================================================================
+//  Frame Arena:
+//    Linear allocator for the data living during a frame (texts, temporary
+//    tables...). Allocating moves a pointer, the whole arena being released
+//    at once by reset() at the beginning of the next frame. Allocations
+//    exceeding the block are served by the heap and the block is enlarged
+//    to the peak at the next reset: the steady state allocates nothing.
+//========================================================================
+
+class UxFrameArena
+{
+private:
+  static uint8_t*             _Block;
+  static size_t               _Capacity;
+  static size_t               _Used;
+  static size_t               _Requested;      // Bytes requested during the current frame (block and overflows, padding included)
+  static std::vector<void*>*  _Overflows;      // Heap blocks of the allocations exceeding the block (current frame)
+
+public:
+
+  __DeclareDeletedCtor(UxFrameArena)
+
+  static void reserve(size_t iCapacity);
+
+  // Releases the allocations of the previous frame (pointers no longer valid)
+  static void reset();
+
+  static void* allocate(size_t iSize, size_t iAlignment = sizeof(void*));
+
+  template<typename tpType>
+  static tpType* allocate(size_t iNumber) { return reinterpret_cast<tpType*>(allocate(iNumber*sizeof(tpType), alignof(tpType))); }
+
+  // Text formatted in the arena (printf format)
+  static const char* format(const char* iFormat, ...);
+
+  static size_t getCapacity() { return _Capacity; }
+  static size_t getUsedSize() { return _Used; }
+};
+
+
+//========================================================================
+//  Frame Text:
+//    Text of fixed capacity built in the frame arena by successive
+//    formatted appends (truncated beyond the capacity).
+//========================================================================
+
+class UxFrameText
+{
+private:
+  char*   _Text;
+  size_t  _Length;
+  size_t  _Capacity;
+
+public:
+  UxFrameText(size_t iCapacity);
+  __DeclareDeletedCtorsAndAssignments(UxFrameText)
+
+  UxFrameText& append(const char* iFormat, ...);
+
+  const char* c_str() const { return _Text; }
+  size_t      length() const { return _Length; }
+};
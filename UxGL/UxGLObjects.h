@@ -1,104 +1,125 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include "UxGL.h"
-#include "UxUniformBlock.h"
-#include "UxShaderStorage.h"
-
-#include <vector>
-#include <memory>
-
-class UxVertexInputAttribute;
-
-//========================================================================
-//  OpenGL Context Object Manager:
-//    Manages list of OpenGL context objects.
-//========================================================================
-
-class UxGLObjects
-{
-private:
-  static bool _Startup;
-  static void Startup();
-  static std::vector<std::shared_ptr<UxUniformBlockBase>>*      _UniformBlocks;
-  static std::vector<std::shared_ptr<UxVertexInputAttribute>>*  _InputAttributes;
-  static std::vector<std::shared_ptr<UxShaderStorageBase>>*     _ShaderStorages;
-
-public:
-
-  __DeclareDeletedCtor(UxGLObjects)
-
-  static void addInputAttribute(const std::string& iAttributeName);
-  static std::shared_ptr<UxVertexInputAttribute> getInputAttribute(const std::string& iAttributeName);
-
-  template<typename tpUBOStruct>
-  static void addUniformBlock(const std::string& iUniformName, GLenum iUsage = GL_DYNAMIC_DRAW);
-
-  template<typename tpSSBOStruct>
-  static void addStorageBlock(const std::string& iStorageName, GLenum iUsage);
-
-  static std::shared_ptr<UxUniformBlockBase> getUniformBlock(const std::string& iUniformName);
-
-  template<typename tpUBOStruct>
-  static std::shared_ptr<UxUniformBlock<tpUBOStruct>> getUniformBlock(const std::string& iUniformName);
-
-  static std::shared_ptr<UxShaderStorageBase> getShaderStorage(const std::string& iStorageName);
-
-  template<typename tpSSBOStruct>
-  static std::shared_ptr<UxShaderStorage<tpSSBOStruct>> getShaderStorage(const std::string& iStorageName);
-};
-
-template<typename tpUBOStruct>
-void UxGLObjects::addUniformBlock(const std::string& iUniformName, GLenum iUsage)
-{
-  Startup();
-
-  UxUniformBlock<tpUBOStruct>* pBlock = new UxUniformBlock<tpUBOStruct>(iUniformName, iUsage);
-  _UniformBlocks->push_back(std::shared_ptr<UxUniformBlockBase>(pBlock));
-}
-
-template<typename tpUBOStruct>
-std::shared_ptr<UxUniformBlock<tpUBOStruct>> UxGLObjects::getUniformBlock(const std::string& iBlockName)
-{
-  Startup();
-
-  for (auto it = _UniformBlocks->cbegin(); it != _UniformBlocks->cend(); it++)
-  {
-    if ((*it)->getName() == iBlockName)
-      return std::dynamic_pointer_cast<UxUniformBlock<tpUBOStruct>>(*it);
-  }
-
-  __Assert(std::string("Uniform block \"") + iBlockName + "\" not (yet) registered.");
-
-    return nullptr;
-}
-
-template<typename tpSSBOStruct>
-void UxGLObjects::addShaderStorage(const std::string& iStorageName, GLenum iUsage)
-{
-  Startup();
-
-  UxShaderStorage<tpSSBOStruct>* pStorage = new UxShaderStorage<tpSSBOStruct>(iStorageName, iUsage);
-  _ShaderStorages->push_back(std::shared_ptr<UxShaderStorageBase>(pStorage));
-}
-
-template<typename tpSSBOStruct>
-std::shared_ptr<UxShaderStorage<tpSSBOStruct>> UxGLObjects::getShaderStorage(const std::string& iStorageName)
-{
-  Startup();
-
-  for (auto it = _ShaderStorages->cbegin(); it != _ShaderStorages->cend(); it++)
-  {
-    if ((*it)->getName() == iStorageName)
-      return std::dynamic_pointer_cast<UxShaderStorage<tpSSBOStruct>>(*it);
-  }
-
-  __Assert(std::string("Shader storage \"") + iStorageName + "\" not (yet) registered.");
-
-  return nullptr;
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "UxUniformBlock.h"
+#include "UxShaderStorage.h"
+#include "UxHandle.h"
+
+#include <vector>
+#include <memory>
+
+class UxVertexInputAttribute;
+
+//========================================================================
+//  OpenGL Context Object Manager:
+//    Manages list of OpenGL context objects. Registration returns a typed
+//    handle resolved in constant time (per frame accesses); lookup by
+//    name is meant for the startup.
+//========================================================================
+
+class UxGLObjects
+{
+private:
+  static bool _Startup;
+  static void Startup();
+  static std::vector<std::shared_ptr<UxUniformBlockBase>>*      _UniformBlocks;
+  static std::vector<std::shared_ptr<UxVertexInputAttribute>>*  _InputAttributes;
+  static std::vector<std::shared_ptr<UxShaderStorageBase>>*     _ShaderStorages;
+
+public:
+
+  __DeclareDeletedCtor(UxGLObjects)
+
+  static UxHandle<UxVertexInputAttribute> addInputAttribute(const std::string& iAttributeName);
+  static std::shared_ptr<UxVertexInputAttribute> getInputAttribute(const std::string& iAttributeName);
+  static UxVertexInputAttribute* getInputAttribute(const UxHandle<UxVertexInputAttribute>& iAttribute);
+
+  template<typename tpUBOStruct>
+  static UxHandle<UxUniformBlock<tpUBOStruct>> addUniformBlock(const std::string& iUniformName, GLenum iUsage = GL_DYNAMIC_DRAW);
+
+  template<typename tpSSBOStruct>
+  static UxHandle<UxShaderStorage<tpSSBOStruct>> addShaderStorage(const std::string& iStorageName, GLenum iUsage);
+
+  static std::shared_ptr<UxUniformBlockBase> getUniformBlock(const std::string& iUniformName);
+  static UxUniformBlockBase* getUniformBlock(const UxHandle<UxUniformBlockBase>& iUniformBlock);
+
+  template<typename tpUBOStruct>
+  static std::shared_ptr<UxUniformBlock<tpUBOStruct>> getUniformBlock(const std::string& iUniformName);
+
+  // The handle type guarantees the structure: no dynamic cast
+  template<typename tpUBOStruct>
+  static UxUniformBlock<tpUBOStruct>* getUniformBlock(const UxHandle<UxUniformBlock<tpUBOStruct>>& iUniformBlock)
+  { return static_cast<UxUniformBlock<tpUBOStruct>*>(getUniformBlock(UxHandle<UxUniformBlockBase>(iUniformBlock))); }
+
+  static std::shared_ptr<UxShaderStorageBase> getShaderStorage(const std::string& iStorageName);
+  static UxShaderStorageBase* getShaderStorage(const UxHandle<UxShaderStorageBase>& iShaderStorage);
+
+  template<typename tpSSBOStruct>
+  static std::shared_ptr<UxShaderStorage<tpSSBOStruct>> getShaderStorage(const std::string& iStorageName);
+
+  template<typename tpSSBOStruct>
+  static UxShaderStorage<tpSSBOStruct>* getShaderStorage(const UxHandle<UxShaderStorage<tpSSBOStruct>>& iShaderStorage)
+  { return static_cast<UxShaderStorage<tpSSBOStruct>*>(getShaderStorage(UxHandle<UxShaderStorageBase>(iShaderStorage))); }
+};
+
+template<typename tpUBOStruct>
+UxHandle<UxUniformBlock<tpUBOStruct>> UxGLObjects::addUniformBlock(const std::string& iUniformName, GLenum iUsage)
+{
+  Startup();
+
+  UxUniformBlock<tpUBOStruct>* pBlock = new UxUniformBlock<tpUBOStruct>(iUniformName, iUsage);
+  _UniformBlocks->push_back(std::shared_ptr<UxUniformBlockBase>(pBlock));
+
+  UxHandle<UxUniformBlockBase> handle = pBlock->getHandle();
+  return UxHandle<UxUniformBlock<tpUBOStruct>>(handle.getIndex(), handle.getGeneration());
+}
+
+template<typename tpUBOStruct>
+std::shared_ptr<UxUniformBlock<tpUBOStruct>> UxGLObjects::getUniformBlock(const std::string& iBlockName)
+{
+  Startup();
+
+  for (auto it = _UniformBlocks->cbegin(); it != _UniformBlocks->cend(); it++)
+  {
+    if ((*it)->getName() == iBlockName)
+      return std::dynamic_pointer_cast<UxUniformBlock<tpUBOStruct>>(*it);
+  }
+
+  __Assert(std::string("Uniform block \"") + iBlockName + "\" not (yet) registered.");
+
+    return nullptr;
+}
+
+template<typename tpSSBOStruct>
+UxHandle<UxShaderStorage<tpSSBOStruct>> UxGLObjects::addShaderStorage(const std::string& iStorageName, GLenum iUsage)
+{
+  Startup();
+
+  UxShaderStorage<tpSSBOStruct>* pStorage = new UxShaderStorage<tpSSBOStruct>(iStorageName, iUsage);
+  _ShaderStorages->push_back(std::shared_ptr<UxShaderStorageBase>(pStorage));
+
+  UxHandle<UxShaderStorageBase> handle = pStorage->getHandle();
+  return UxHandle<UxShaderStorage<tpSSBOStruct>>(handle.getIndex(), handle.getGeneration());
+}
+
+template<typename tpSSBOStruct>
+std::shared_ptr<UxShaderStorage<tpSSBOStruct>> UxGLObjects::getShaderStorage(const std::string& iStorageName)
+{
+  Startup();
+
+  for (auto it = _ShaderStorages->cbegin(); it != _ShaderStorages->cend(); it++)
+  {
+    if ((*it)->getName() == iStorageName)
+      return std::dynamic_pointer_cast<UxShaderStorage<tpSSBOStruct>>(*it);
+  }
+
+  __Assert(std::string("Shader storage \"") + iStorageName + "\" not (yet) registered.");
+
+  return nullptr;
+}
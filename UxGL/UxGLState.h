@@ -0,0 +1,56 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <gl/glew.h>
+#include <stdint.h>
+#include <map>
+
+//========================================================================
+//  OpenGL Context State Cache:
+//    Keeps the program, vertex array, buffers and capabilities last set
+//    on the context and skips the redundant changes. The objects being
+//    created and modified with direct state access, bindings are only
+//    needed for draws and dispatches. Any state change made outside the
+//    cache has to be followed by invalidate().
+//========================================================================
+
+class UxGLState
+{
+private:
+  static GLuint                    _Program;                // Program in use (0: none or unknown)
+  static GLuint                    _VertexArray;            // Vertex array bound
+  static std::map<GLuint, GLuint>  _ElementBuffers;         // Element buffer attached to each vertex array
+  static std::map<GLenum, GLuint>  _Buffers;                // Buffer bound to each target (indirect commands...)
+  static std::map<GLenum, bool>    _Capabilities;           // Capabilities enabled or disabled
+  static uint64_t                  _ChangeNb;               // Statistics: state changes sent to the driver
+  static uint64_t                  _SkippedChangeNb;        //             redundant changes skipped
+
+public:
+
+  __DeclareDeletedCtor(UxGLState)
+
+  static void useProgram(GLuint iProgram);
+  static void bindVertexArray(GLuint iVertexArray, GLuint iElementBuffer);
+  static void bindBuffer(GLenum iTarget, GLuint iBuffer);
+  static void enable(GLenum iCapability) { setCapability(iCapability, true); }
+  static void disable(GLenum iCapability) { setCapability(iCapability, false); }
+  static void setCapability(GLenum iCapability, bool iEnabled);
+
+  // Deletes the objects and forgets the bindings referring to them (names might be reused by the driver)
+  static void deleteProgram(GLuint& ioProgram);
+  static void deleteVertexArray(GLuint& ioVertexArray);
+  static void deleteBuffer(GLuint& ioBuffer);
+
+  // Forgets the cached state (context modified by code not using the cache)
+  static void invalidate();
+
+  static uint64_t getChangeNb() { return _ChangeNb; }
+  static uint64_t getSkippedChangeNb() { return _SkippedChangeNb; }
+};
@@ -0,0 +1,83 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <gl/glew.h>
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include <string>
+
+//========================================================================
+//  GPU Memory Registry:
+//    Records the storage of the GL buffers and textures when it is
+//    allocated (owner, bytes, usage) and released, the reallocations of
+//    a same object being counted. Totals and peaks are kept per frame
+//    (endFrame) and since the start, and the allocations still alive can
+//    be written sorted by size in a JSON report (at exit: the objects
+//    not released, ie leaks once their owners are destroyed). The extra
+//    storage of the driver (alignment, residency) is not seen. Objects
+//    may be recorded by any thread (upload context).
+//========================================================================
+
+class UxGPUMemoryRegistry
+{
+public:
+  enum Type
+  {
+    Buffer,
+    Texture,
+    TypeNb
+  };
+
+  struct Allocation
+  {
+    std::string  owner;           // Class of the owner and its name (ie "UxUniformBlock u_Viewing")
+    uint64_t     size;
+    GLenum       usage;           // Usage of the buffer (0: immutable storage) or internal format of the texture
+    uint32_t     reallocationNb;
+    uint64_t     frame;           // Frame of the last (re)allocation
+  };
+
+  struct Statistics
+  {
+    uint32_t  objectNb;
+    uint64_t  size;               // Bytes at the end of the frame
+    uint64_t  peakSize;           // Highest total during the frame
+    uint64_t  allocatedSize;      // Bytes (re)allocated during the frame
+    uint64_t  releasedSize;
+  };
+
+private:
+  static std::mutex                                        _Mutex;
+  static std::map<std::pair<Type, GLuint>, Allocation>     _Allocations;
+  static Statistics                                        _Frame[TypeNb];       // Current frame
+  static Statistics                                        _LastFrame[TypeNb];   // Updated by endFrame
+  static uint64_t                                          _PeakSize[TypeNb];    // Since the start
+  static uint64_t                                          _FrameNb;
+
+public:
+
+  __DeclareDeletedCtor(UxGPUMemoryRegistry)
+
+  // Storage of an object allocated, or reallocated if the object is already recorded
+  static void record(Type iType, GLuint iName, const std::string& iOwner, uint64_t iSize, GLenum iUsage);
+  // Storage released (before the object is deleted, objects not recorded ignored)
+  static void release(Type iType, GLuint iName);
+
+  // Closes the statistics of the frame (to be called once per frame, at the end of the loop)
+  static void endFrame();
+
+  static const Statistics& getLastFrame(Type iType) { return _LastFrame[iType]; }
+  static uint64_t          getPeakSize(Type iType) { return _PeakSize[iType]; }
+  static const char*       getTypeName(Type iType);
+
+  // Writes the totals and the allocations alive sorted by decreasing size in a JSON file
+  static bool writeJSON(const std::string& iFileName);
+};
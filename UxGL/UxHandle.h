@@ -0,0 +1,46 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <stdint.h>
+#include <type_traits>
+
+//========================================================================
+//  Typed Handle:
+//    Stable reference to an object registered in a table (index of the
+//    slot and generation of the slot when registered). Resolving a
+//    handle is a direct access, the type being checked at compile time
+//    and the generation detecting a slot freed and reused since.
+//========================================================================
+
+template<typename tpObjectType>
+class UxHandle
+{
+public:
+  static const uint32_t InvalidIndex = 0xFFFFFFFF;
+
+private:
+  uint32_t _Index;
+  uint32_t _Generation;
+
+public:
+  UxHandle() : _Index(InvalidIndex), _Generation(0) {}
+  UxHandle(uint32_t iIndex, uint32_t iGeneration) : _Index(iIndex), _Generation(iGeneration) {}
+
+  // Handle on a derived type usable as handle on its base type
+  template<typename tpDerivedType, typename = typename std::enable_if<std::is_base_of<tpObjectType, tpDerivedType>::value>::type>
+  UxHandle(const UxHandle<tpDerivedType>& iHandle) : _Index(iHandle.getIndex()), _Generation(iHandle.getGeneration()) {}
+
+  uint32_t getIndex() const { return _Index; }
+  uint32_t getGeneration() const { return _Generation; }
+  bool     isValid() const { return _Index != InvalidIndex; }
+
+  bool operator==(const UxHandle& iHandle) const { return _Index == iHandle._Index && _Generation == iHandle._Generation; }
+  bool operator!=(const UxHandle& iHandle) const { return !(*this == iHandle); }
+};
@@ -1,50 +1,76 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include "UxGL.h"
-#include <GL/glew.h>
-#include <vector>
-
-//========================================================================
-//  Element Array Buffer encapsulation:
-//    Manages index buffer to configure elements to draw in conjonction
-//    with a Vertex Array Object (VAO) or UxVertexArray.
-//========================================================================
-
-class UxIndexBuffer
-{
-private:
-  GLuint              _Buffer;                // GL buffer id
-  std::vector<GLuint> _IndexVector;           // Vector of indices
-  int32_t             _BufferSize;            // Size of the buffer fed with the vector
-  uint32_t            _PrimitiveRestartIndex; // Primitive restart attribute for strips
-
-public:
-
-  UxIndexBuffer();
-  ~UxIndexBuffer();
-  __DeclareDeletedCtorsAndAssignments(UxIndexBuffer)
-
-  void        clearVector();          // Removes all the values from the vector
-  void        store(GLenum iUsage);   // Stores the vector content into the buffer
-  void        bind() const;           // Bind the buffer to the current context (prior glDrawElements)
-  static void unbind();               // Unbind any buffer to the current context 
-  uint32_t    getBufferSize() const;  // Returns the size of the buffer
-
-  // Mathods to feed the index vector according different browsing patterns
-
-  void addElement(int32_t iOffset, uint32_t iIndex);
-  void addLinearRow(int32_t iOffset, uint32_t iLength);
-  void addLinearMatrix(int32_t iOffset, uint32_t iColNumber, uint32_t iRowNumber);
-  void addPatchesFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber);
-  void addRowLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex);
-  void addColumnLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex);
-
-private:
-  void addColumnLineStrips(int32_t iOffset, bool iColumnMajorOrder, uint32_t iStrip, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex);
-};
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include <GL/glew.h>
+#include <vector>
+
+class UxStreamBuffer;
+
+//========================================================================
+//  Element Array Buffer encapsulation:
+//    Manages index buffer to configure elements to draw in conjonction
+//    with a Vertex Array Object (VAO) or UxVertexArray. The indices are
+//    stored on 8, 16 or 32 bits according to the max index of the
+//    buffer, the primitive restart index being the max value of the type.
+//========================================================================
+
+class UxIndexBuffer
+{
+private:
+  GLuint              _Buffer;                // GL buffer id
+  std::vector<GLuint> _IndexVector;           // Vector of indices
+  int32_t             _BufferSize;            // Size of the buffer fed with the vector
+  uint32_t            _PrimitiveRestartIndex; // Primitive restart attribute for strips (as fed, 0: none)
+  GLenum              _Type;                  // Type of the stored indices (GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT)
+  GLsizeiptr          _AllocatedSize;         // Size of the buffer storage (bytes), kept while the content fits
+
+  // Indices written directly into a stream buffer (between beginStream and endStream)
+  GLuint              _StreamBuffer;          // Buffer of the stream (0 if the own buffer is used)
+  GLintptr            _Offset;                // Offset of the indices in the buffer (bytes)
+  uint8_t*            _StreamData;
+  uint32_t            _StreamCapacity;
+  uint32_t            _StreamIndexNb;
+
+public:
+
+  UxIndexBuffer();
+  ~UxIndexBuffer();
+  __DeclareDeletedCtorsAndAssignments(UxIndexBuffer)
+
+  void        clearVector();          // Removes all the values from the vector
+  void        store(GLenum iUsage);   // Stores the vector content into the buffer
+  void        setPrimitiveRestart() const;  // Primitive restart state of the buffer (prior glDrawElements)
+  uint32_t    getBufferSize() const;        // Returns the size of the buffer
+  GLuint      getBuffer() const { return _StreamBuffer ? _StreamBuffer : _Buffer; }
+  GLintptr    getOffset() const { return _Offset; }  // Offset of the first index (draws)
+  GLenum      getType() const { return _Type; }       // Type of the indices (draws)
+
+  // Indices written in a region of the stream buffer (by the returned pointer or the add methods) instead of the
+  // vector, no copy nor reallocation. The region remains valid until the next allocations of the stream. The
+  // type of the indices (see getType) is selected from the max index to be written.
+  void*       beginStream(UxStreamBuffer& ioStream, uint32_t iMaxIndexNb, uint32_t iMaxIndex);
+  void        endStream(int32_t iIndexNb = -1);     // Number of indices written by the pointer (-1: by the add methods)
+
+  // Smallest type holding the indices up to the max index (the max value of the type being the restart index)
+  static GLenum   selectType(uint32_t iMaxIndex);
+  static uint32_t getTypeSize(GLenum iType);
+  static GLuint   getRestartIndex(GLenum iType);
+
+  // Mathods to feed the index vector according different browsing patterns
+
+  void addElement(int32_t iOffset, uint32_t iIndex);
+  void addLinearRow(int32_t iOffset, uint32_t iLength);
+  void addLinearMatrix(int32_t iOffset, uint32_t iColNumber, uint32_t iRowNumber);
+  void addPatchesFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber);
+  void addRowLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex);
+  void addColumnLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex);
+
+private:
+  void addColumnLineStrips(int32_t iOffset, bool iColumnMajorOrder, uint32_t iStrip, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex);
+};
@@ -0,0 +1,45 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+//========================================================================
+//  Mapped File:
+//    Read-only view of a whole file mapped into the address space: the
+//    pages are read from the disk (or the system cache) on first access,
+//    the content being consulted in place without reading nor copying
+//    it. The view stays valid until close() or the destruction.
+//========================================================================
+
+class UxMappedFile
+{
+private:
+  std::string     _Path;
+  void*           _File;        // System handles of the file and of the mapping
+  void*           _Mapping;
+  const uint8_t*  _Data;
+  uint64_t        _Size;
+
+public:
+  UxMappedFile();
+  ~UxMappedFile();
+  __DeclareDeletedCtorsAndAssignments(UxMappedFile)
+
+  // False if the file can't be opened or mapped (empty files included)
+  bool open(const std::string& iPath);
+  void close();
+
+  bool               isOpen() const { return _Data != nullptr; }
+  const std::string& getPath() const { return _Path; }
+  const uint8_t*     getData() const { return _Data; }
+  uint64_t           getSize() const { return _Size; }
+};
@@ -1,65 +1,97 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include "UxGL.h"
-#include "UxShader.h"
-#include "UxVertexArrayBase.h"
-#include "UxIndexBuffer.h"
-
-#include <gl/glew.h>
-#include <string>
-#include <memory>
-#include <map>
-#include <set>
-
-class UxVertexInputAttribute;
-
-//========================================================================
-//  Program encapsulation:
-//    Manages shaders, associated reports and vertex attributes. 
-//========================================================================
-
-class UxProgram
-{
-private:
-  // Correlation table between GL_xxx OpenGL define types and GLSL types
-  static std::map<int, std::pair<const char*, const char*>> _TypeTable;
-
-private:
-  GLuint                                    _GLid;     // GL program id
-  std::string                               _Name;     // Application name
-  std::set<std::shared_ptr<UxReportBase>>   _Reports;  // Set of reports invoked by the shaders linked to the program
-
-public:
-  UxProgram(const char* iName);
-  ~UxProgram();
-  __DeclareDeletedCtorsAndAssignments(UxProgram)
-
-  GLuint id() const { return _GLid; };
-  const char* getName() const { return _Name.c_str(); }
-
-  // Displays on the standard output the structure (inputs/outputs, attributes, UBo, SSBo, ...) of the program
-  void introspect() const;
-
-  void attachShaders(const std::vector<UxShader>& shaders, uint32_t indexStart, uint32_t indexEnd);
-  void link();
-
-  // Binds vertex attribute (input of vertex shader) to the program
-  void bindVertexAttributes(const char* iBindings[][2], uint32_t iBindingNb);
-  void bindVertexAttribute(std::shared_ptr<UxVertexInputAttribute> iInputAttribute, const std::string& iShaderInputName);
-
-  // Bind the SSBo associated to the report to the program
-  void bindReports();
-
-  // Encapsulation of glUseProgram
-  void use() const;
-
-  // Draw elements specified in a VAO using an Element Array Buffer
-  void draw(GLenum iMode, const UxVertexArrayBase& iVertexArray, const UxIndexBuffer& iIndexBuffer);
-};
-
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "UxShader.h"
+#include "UxVertexArrayBase.h"
+#include "UxIndexBuffer.h"
+
+#include <gl/glew.h>
+#include <string>
+#include <memory>
+#include <map>
+#include <set>
+
+class UxVertexInputAttribute;
+class UxTransformFeedback;
+class UxShaderStorageBase;
+
+//========================================================================
+//  Program encapsulation:
+//    Manages shaders, associated reports and vertex attributes. 
+//========================================================================
+
+class UxProgram
+{
+private:
+  // Correlation table between GL_xxx OpenGL define types and GLSL types
+  static std::map<int, std::pair<const char*, const char*>> _TypeTable;
+
+  // Vertex array without attribute, bound for attributeless draws (vertices computed by the vertex shader)
+  static GLuint _EmptyVertexArray;
+
+private:
+  GLuint                                    _GLid;     // GL program id
+  std::string                               _Name;     // Application name
+  std::set<std::shared_ptr<UxReportBase>>   _Reports;  // Set of reports invoked by the shaders linked to the program
+
+public:
+  UxProgram(const char* iName);
+  ~UxProgram();
+  __DeclareDeletedCtorsAndAssignments(UxProgram)
+
+  GLuint id() const { return _GLid; };
+  const char* getName() const { return _Name.c_str(); }
+
+  // Displays on the standard output the structure (inputs/outputs, attributes, UBo, SSBo, ...) of the program
+  void introspect() const;
+
+  void attachShaders(const std::vector<UxShader>& shaders, uint32_t indexStart, uint32_t indexEnd);
+  void link();
+
+  // Declares the outputs captured by transform feedback (interleaved in a single buffer) and relinks the program
+  void setFeedbackVaryings(const char* iVaryings[], uint32_t iVaryingNb);
+
+  // Binds vertex attribute (input of vertex shader) to the program
+  void bindVertexAttributes(const char* iBindings[][2], uint32_t iBindingNb);
+  void bindVertexAttribute(std::shared_ptr<UxVertexInputAttribute> iInputAttribute, const std::string& iShaderInputName);
+
+  // Bind the SSBo associated to the report to the program
+  void bindReports();
+
+  // Encapsulation of glUseProgram
+  void use() const;
+
+  // Draw elements specified in a VAO using an Element Array Buffer
+  void draw(GLenum iMode, const UxVertexArrayBase& iVertexArray, const UxIndexBuffer& iIndexBuffer);
+
+  // Draw elements without vertex attribute, the vertex shader deriving the vertex from its index (gl_VertexID)
+  void draw(GLenum iMode, const UxIndexBuffer& iIndexBuffer);
+
+  // Draw iVertexNb vertices without vertex attribute nor index, the vertex shader deriving the vertex from its rank (gl_VertexID)
+  void draw(GLenum iMode, GLsizei iVertexNb);
+
+  // Draw elements and captures the resulting primitives (iCapturedMode: GL_POINTS, GL_LINES or GL_TRIANGLES)
+  void drawAndCapture(GLenum iMode, const UxVertexArrayBase& iVertexArray, const UxIndexBuffer& iIndexBuffer, UxTransformFeedback& ioFeedback, GLenum iCapturedMode);
+  void drawAndCapture(GLenum iMode, const UxIndexBuffer& iIndexBuffer, UxTransformFeedback& ioFeedback, GLenum iCapturedMode);
+
+  // Draw the primitives previously captured by a transform feedback into the buffer of the vertex array
+  void drawCapture(GLenum iMode, const UxVertexArrayBase& iCaptureArray, const UxTransformFeedback& iFeedback);
+
+  // Draw elements with parameters (DrawElementsIndirectCommand) read from a shader storage written by the GPU
+  void drawIndirect(GLenum iMode, const UxVertexArrayBase& iVertexArray, const UxIndexBuffer& iIndexBuffer, const UxShaderStorageBase& iCommandStorage, GLintptr iCommandOffset);
+
+  // Launch compute work groups (program made of a compute shader), the group numbers being possibly read from a shader storage
+  void dispatch(GLuint iGroupNbX, GLuint iGroupNbY = 1, GLuint iGroupNbZ = 1);
+  void dispatchIndirect(const UxShaderStorageBase& iCommandStorage, GLintptr iCommandOffset);
+
+private:
+  // Vertex array without attribute, with the element buffer of the index buffer (none if nullptr)
+  static void bindEmptyVertexArray(const UxIndexBuffer* iIndexBuffer);
+};
+
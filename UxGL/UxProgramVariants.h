@@ -0,0 +1,59 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <gl/glew.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+class UxProgram;
+
+
+//========================================================================
+//  Program variants:
+//    Set of programs linked from the same shader files, each variant
+//    being specialized by defines (render modes known at compile time).
+//    Variants are compiled and linked at first request, then kept.
+//========================================================================
+
+class UxProgramVariants
+{
+public:
+  // Shader of the variants: type and files (the header being prepended by UxShader)
+  typedef std::pair<GLenum, std::vector<std::string>>  ShaderFiles;
+
+  // Completes a newly linked variant (feedback varyings, uniform block bindings, reports...)
+  typedef std::function<void(UxProgram*)>              Setup;
+
+  // Fills the defines of a variant ("NAME" or "NAME VALUE")
+  typedef std::function<void(std::vector<std::string>&)>  DefinesBuilder;
+
+private:
+  std::string                        _Name;         // Application name (suffixed by the defines for every variant)
+  std::vector<ShaderFiles>           _Shaders;
+  Setup                              _Setup;
+  std::map<uint32_t, UxProgram*>     _Variants;     // Variants by key of the caller
+
+public:
+  UxProgramVariants(const char* iName, const std::vector<ShaderFiles>& iShaders, Setup iSetup);
+  ~UxProgramVariants();
+  __DeclareDeletedCtorsAndAssignments(UxProgramVariants)
+
+  const char* getName() const { return _Name.c_str(); }
+  uint32_t    getVariantNb() const { return (uint32_t)_Variants.size(); }
+
+  // Variant identified by a key of the caller (ie its render modes), which must determine the defines: the defines are
+  // only built when the variant is linked at its first request (no allocation afterwards, whatever the callers)
+  UxProgram* get(uint32_t iKey, const DefinesBuilder& iBuilder);
+
+private:
+  UxProgram* link(const std::vector<std::string>& iDefines);
+};
@@ -0,0 +1,88 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <gl/glew.h>
+#include <stdint.h>
+#include <map>
+
+//========================================================================
+//  Bindless Texture Residency Manager:
+//    Keeps the texture handles registered by their owners resident only
+//    while they are sampled. A handle is made resident when a draw of
+//    the frame uses it (visible object), the handles left unused the
+//    longest being made non resident beforehand so that the resident
+//    textures stay under the budget (0: no budget). The handles used by
+//    the frame are never evicted: the budget may be exceeded when they
+//    do not fit. Residency being a state of the context, every call is
+//    made by the rendering thread.
+//========================================================================
+
+class UxResidencyManager
+{
+public:
+  // Frames after its eviction during which making a handle resident again counts as thrashing
+  static const uint32_t ThrashFrameNb = 60;
+
+  // Last frame state, the counters being cumulated since the start
+  struct Statistics
+  {
+    uint32_t  handleNb;           // Handles registered
+    uint32_t  residentHandleNb;
+    uint64_t  registeredSize;     // Bytes of the textures registered
+    uint64_t  residentSize;
+    uint64_t  usedSize;           // Bytes of the textures sampled by the last frame
+    uint64_t  peakResidentSize;
+    uint64_t  residencyNb;        // Handles made resident
+    uint64_t  evictionNb;         // Handles made non resident by the budget
+    uint64_t  thrashNb;           // Handles made resident again within ThrashFrameNb frames after their eviction
+  };
+
+private:
+  struct Entry
+  {
+    uint64_t  size;
+    uint64_t  lastUsedFrame;
+    uint64_t  evictionFrame;
+    bool      isResident;
+    bool      isEvicted;          // Made non resident by the budget (thrash detection)
+  };
+
+  static std::map<GLuint64, Entry>  _Entries;
+  static uint64_t                   _Budget;
+  static uint64_t                   _Frame;
+  static uint64_t                   _FrameUsedSize;
+  static Statistics                 _Statistics;
+
+public:
+
+  __DeclareDeletedCtor(UxResidencyManager)
+
+  static void     setBudget(uint64_t iBudget) { _Budget = iBudget; }
+  static uint64_t getBudget() { return _Budget; }
+
+  // Handle of a texture registered non resident, its size read from the storage of the texture
+  static void registerHandle(GLuint64 iHandle, GLuint iTextureName);
+  // Handle made non resident if needed and forgotten (before the texture is deleted)
+  static void unregisterHandle(GLuint64 iHandle);
+
+  // Handle sampled by the draws of the frame, made resident if it is not (handles not used by the frame evicted in least
+  // recently used order to make room)
+  static void use(GLuint64 iHandle);
+
+  // Closes the frame: handles not used by the frame evicted while over the budget (to be called once per frame)
+  static void endFrame();
+
+  static const Statistics& getStatistics() { return _Statistics; }
+
+protected:
+  // Evicts the least recently used handles not used by the frame until iSize more bytes fit in the budget
+  static void makeRoom(uint64_t iSize);
+  static void evict(GLuint64 iHandle, Entry& ioEntry);
+};
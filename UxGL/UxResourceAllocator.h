@@ -1,138 +1,181 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include "UxGL.h"
-#include "UxError.h"
-
-#include <vector>
-#include <memory>
-#include <cassert>
-#include <gl/glew.h>
-
-
-//========================================================================
-//  Generic Resource Allocator:
-//    Manages allocation inside a set of linear resource.
-//========================================================================
-
-template<typename tpResourceType, GLenum tpMaxResourceEnum>
-class UxResourceAllocator
-{
-private:
-  // Static initialisations
-  static bool _Startup;
-  static void Startup();
-
-  // Table of allocated resources by the application
-  static std::vector<std::shared_ptr<tpResourceType>>* _Allocations;
-
-public:
-  
-  // Allocate a new resource
-  static uint32_t allocate(tpResourceType* iResourceInstance, const std::string& iName, int32_t iResourceIndex);
-
-  // Retrieves resource from its name in the table of allocations
-  static std::shared_ptr<tpResourceType> getResource(const std::string& iName);
-
-  // Removes the resource from the table
-  static void remove(const tpResourceType* iResource);
-  
-  __DeclareDeletedCtor(UxResourceAllocator)
-};
-
-template<typename tpResourceType, GLenum tpMaxResourceEnum>
-std::vector<std::shared_ptr<tpResourceType>>* UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::_Allocations = nullptr;
-
-template<typename tpResourceType, GLenum tpMaxResourceEnum>
-bool UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::_Startup = false;
-
-template<typename tpResourceType, GLenum tpMaxResourceEnum>
-void UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::Startup()
-{
-  if (!_Startup)
-  {
-    _Allocations = new std::vector<std::shared_ptr<tpResourceType>>();
-
-    GLint size;
-    glGetIntegerv(tpMaxResourceEnum, &size);
-    __CheckGLErrors;
-    _Allocations->resize(size, nullptr);
-    _Startup = true;
-  }
-}
-
-template<typename tpResourceType, GLenum tpMaxResourceEnum>
-uint32_t UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::allocate(tpResourceType* iResourceInstance, const std::string& iName, int32_t iResourceIndex)
-{
-  Startup();
-
-  // If location is explicit must be possible (less than max attribute location) and not yet allocated
-  assert(iResourceIndex == -1 || ((uint32_t)iResourceIndex < _Allocations->size() && !_Allocations->at(iResourceIndex)));
-
-  // verifies name unicity
-  for (auto it = _Allocations->begin(); it != _Allocations->end(); it++)
-  {
-    if (*it && ((*it)->getName() == iName))
-    {
-      UxError::error(__FILE__, __LINE__) << "Resource name, " << iName.c_str() << ",is not unique for " << typeid(tpResourceType).name() << ".\n";
-      UxError::UxError::exit(-1);
-    }
-  }
-
-  if (iResourceIndex == -1)
-  {
-    // Allocate the first free location to the new attribute
-    for (auto it = _Allocations->begin(); it != _Allocations->end(); it++)
-    {
-      if (!*it)
-      {
-        *it = std::shared_ptr<tpResourceType>(iResourceInstance);
-        return it - _Allocations->begin();
-      }
-    }
-
-    // No place left, exits
-    UxError::error(__FILE__, __LINE__) << "Maximum number of resource " << typeid(tpResourceType).name() << " (" << _Allocations->size() << ") reached.\n";
-    UxError::UxError::exit(-1);
-  }
-  
-  // Direct allocation
-  (*_Allocations)[iResourceIndex] = std::shared_ptr<tpResourceType>(iResourceInstance);
-
-  return iResourceIndex;
-}
-
-template <typename tpResourceType, GLenum tpMaxResourceEnum>
-std::shared_ptr<tpResourceType> UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::getResource(const std::string& iName)
-{
-  Startup();
-
-  for (auto it = _Allocations->begin(); it != _Allocations->end(); it++)
-  {
-    if (*it && iName == (*it)->getName())
-      return *it;
-  }
-
-  assert(0);
-  return nullptr;
-}
-
-template <typename tpResourceType, GLenum tpMaxResourceEnum>
-void UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::remove(const tpResourceType* iResource)
-{
-  Startup();
-
-  for (auto it = _Allocations->begin(); it != _Allocations->end(); it++)
-  {
-    if (it->get() == iResource)
-    {
-      *it = std::shared_ptr<tpResourceType>(nullptr);
-      return;
-   }
-  }
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "UxError.h"
+#include "UxHandle.h"
+
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <cassert>
+#include <gl/glew.h>
+
+
+//========================================================================
+//  Generic Resource Allocator:
+//    Manages allocation inside a set of linear resource. The allocator
+//    does not own the resources (removed by their destructor). Names are
+//    only used at allocation: the resources are then reached by their
+//    index or by a handle (index and generation of the slot).
+//========================================================================
+
+template<typename tpResourceType, GLenum tpMaxResourceEnum>
+class UxResourceAllocator
+{
+private:
+  struct Slot
+  {
+    tpResourceType* resource;
+    uint32_t        generation;   // Incremented each time the slot is freed
+  };
+
+  // Static initialisations
+  static bool _Startup;
+  static void Startup();
+
+  // Table of allocated resources by the application
+  static std::vector<Slot>*                 _Allocations;
+  static std::map<std::string, uint32_t>*   _Names;       // Index of the allocated resources by name
+  static std::set<uint32_t>*                _FreeSlots;   // Ordered (first free location allocated first)
+
+public:
+  
+  // Allocate a new resource
+  static uint32_t allocate(tpResourceType* iResourceInstance, const std::string& iName, int32_t iResourceIndex);
+
+  // Handle on the resource allocated at the index
+  static UxHandle<tpResourceType> getHandle(uint32_t iResourceIndex);
+
+  // Retrieves resource from its name in the table of allocations
+  static tpResourceType* getResource(const std::string& iName);
+
+  // Retrieves resource from its handle (nullptr if removed since)
+  static tpResourceType* getResource(const UxHandle<tpResourceType>& iHandle);
+
+  // Removes the resource from the table
+  static void remove(const tpResourceType* iResource);
+  
+  __DeclareDeletedCtor(UxResourceAllocator)
+};
+
+template<typename tpResourceType, GLenum tpMaxResourceEnum>
+std::vector<typename UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::Slot>* UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::_Allocations = nullptr;
+
+template<typename tpResourceType, GLenum tpMaxResourceEnum>
+std::map<std::string, uint32_t>* UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::_Names = nullptr;
+
+template<typename tpResourceType, GLenum tpMaxResourceEnum>
+std::set<uint32_t>* UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::_FreeSlots = nullptr;
+
+template<typename tpResourceType, GLenum tpMaxResourceEnum>
+bool UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::_Startup = false;
+
+template<typename tpResourceType, GLenum tpMaxResourceEnum>
+void UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::Startup()
+{
+  if (!_Startup)
+  {
+    _Allocations = new std::vector<Slot>();
+    _Names       = new std::map<std::string, uint32_t>();
+    _FreeSlots   = new std::set<uint32_t>();
+
+    GLint size;
+    glGetIntegerv(tpMaxResourceEnum, &size);
+    __CheckGLErrors;
+    _Allocations->resize(size, Slot{ nullptr, 0 });
+    for (GLint index = 0; index < size; index++)
+      _FreeSlots->insert(_FreeSlots->end(), index);
+    _Startup = true;
+  }
+}
+
+template<typename tpResourceType, GLenum tpMaxResourceEnum>
+uint32_t UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::allocate(tpResourceType* iResourceInstance, const std::string& iName, int32_t iResourceIndex)
+{
+  Startup();
+
+  // If location is explicit must be possible (less than max attribute location) and not yet allocated
+  assert(iResourceIndex == -1 || ((uint32_t)iResourceIndex < _Allocations->size() && !_Allocations->at(iResourceIndex).resource));
+
+  // verifies name unicity
+  if (_Names->find(iName) != _Names->end())
+  {
+    UxError::error(__FILE__, __LINE__) << "Resource name, " << iName.c_str() << ",is not unique for " << typeid(tpResourceType).name() << ".\n";
+    UxError::UxError::exit(-1);
+  }
+
+  uint32_t index = iResourceIndex;
+  if (iResourceIndex == -1)
+  {
+    // No place left, exits
+    if (_FreeSlots->empty())
+    {
+      UxError::error(__FILE__, __LINE__) << "Maximum number of resource " << typeid(tpResourceType).name() << " (" << _Allocations->size() << ") reached.\n";
+      UxError::UxError::exit(-1);
+    }
+
+    // Allocate the first free location to the new attribute
+    index = *_FreeSlots->begin();
+  }
+  
+  _FreeSlots->erase(index);
+  (*_Names)[iName] = index;
+  (*_Allocations)[index].resource = iResourceInstance;
+
+  return index;
+}
+
+template <typename tpResourceType, GLenum tpMaxResourceEnum>
+UxHandle<tpResourceType> UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::getHandle(uint32_t iResourceIndex)
+{
+  Startup();
+
+  assert(iResourceIndex < _Allocations->size() && (*_Allocations)[iResourceIndex].resource);
+  return UxHandle<tpResourceType>(iResourceIndex, (*_Allocations)[iResourceIndex].generation);
+}
+
+template <typename tpResourceType, GLenum tpMaxResourceEnum>
+tpResourceType* UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::getResource(const std::string& iName)
+{
+  Startup();
+
+  auto it = _Names->find(iName);
+  if (it != _Names->end())
+    return (*_Allocations)[it->second].resource;
+
+  assert(0);
+  return nullptr;
+}
+
+template <typename tpResourceType, GLenum tpMaxResourceEnum>
+tpResourceType* UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::getResource(const UxHandle<tpResourceType>& iHandle)
+{
+  assert(_Startup && iHandle.isValid() && iHandle.getIndex() < _Allocations->size());
+
+  const Slot& slot = (*_Allocations)[iHandle.getIndex()];
+  return slot.generation == iHandle.getGeneration() ? slot.resource : nullptr;
+}
+
+template <typename tpResourceType, GLenum tpMaxResourceEnum>
+void UxResourceAllocator<tpResourceType, tpMaxResourceEnum>::remove(const tpResourceType* iResource)
+{
+  Startup();
+
+  auto it = _Names->find(iResource->getName());
+  if (it == _Names->end() || (*_Allocations)[it->second].resource != iResource)
+    return;
+
+  // The generation of the slot invalidates the handles still referring to the resource
+  Slot& slot = (*_Allocations)[it->second];
+  slot.resource = nullptr;
+  slot.generation++;
+  _FreeSlots->insert(it->second);
+  _Names->erase(it);
+}
@@ -0,0 +1,81 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <gl/glew.h>
+#include <stdint.h>
+#include <string>
+
+//========================================================================
+//  Streaming Buffer:
+//    Ring of GPU memory persistently mapped, suballocated to the data
+//    written by the CPU for the next draws (vertices, indices...). The
+//    caller writes directly into the allocation and draws from its
+//    offset. A fence set after the draws protects the allocations: a
+//    region is only reused once the GPU finished reading it.
+//========================================================================
+
+class UxStreamBuffer
+{
+public:
+  struct Allocation
+  {
+    GLuint      buffer;   // GL buffer of the ring (changes if the ring grows)
+    GLintptr    offset;   // Offset of the allocation in the buffer (bytes)
+    void*       data;     // Mapped memory to write into
+    GLsizeiptr  size;
+  };
+
+private:
+  std::string  _Name;
+  GLuint       _Buffer;
+  GLsizeiptr   _Capacity;
+  uint8_t*     _MappedData;
+  uint64_t     _Head;       // Write position (bytes allocated since creation, never wrapped)
+  uint64_t     _Released;   // Position up to which the GPU finished reading
+  uint64_t     _Fenced;     // Position of the last fence
+  uint64_t     _WaitNb;     // Statistics: allocations having waited for the GPU
+
+  // Frames whose allocations are in the ring at once (written by the CPU, read by the GPU): an allocation larger than
+  // the ring divided by this number makes the next frame wait for the GPU
+  static const uint32_t FrameInFlightNb = 3;
+
+  // Fences pending and write position when set (fixed ring: no allocation per frame)
+  static const uint32_t MaxFenceNb = 16;
+  struct Fence
+  {
+    GLsync    sync;
+    uint64_t  position;
+  };
+  Fence        _Fences[MaxFenceNb];
+  uint32_t     _FirstFence;
+  uint32_t     _FenceNb;
+
+public:
+  UxStreamBuffer(const std::string& iName, GLsizeiptr iCapacity);
+  ~UxStreamBuffer();
+  __DeclareDeletedCtorsAndAssignments(UxStreamBuffer)
+
+  // Contiguous region written by the caller (waits if the region is still read by the GPU). The ring grows if the
+  // allocation is larger than its capacity: allocations not yet drawn are then lost.
+  Allocation allocate(GLsizeiptr iSize, GLsizeiptr iAlignment);
+
+  // Protects the allocations made since the last fence (to be called once the draws reading them are sent)
+  void fence();
+
+  const std::string& getName() const { return _Name; }
+  GLuint             getBuffer() const { return _Buffer; }
+  GLsizeiptr         getCapacity() const { return _Capacity; }
+  uint64_t           getWaitNb() const { return _WaitNb; }
+
+private:
+  void create(GLsizeiptr iCapacity);
+  void destroy();
+  void waitOldestFence();
+};
@@ -0,0 +1,58 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+//========================================================================
+//  Thread Pool:
+//    Fixed set of worker threads running the submitted tasks in their
+//    order of submission (CPU work only, no GL context on the workers).
+//    The future of a task is polled (wait_for(0)) or waited for by the
+//    submitter. The destructor completes the pending tasks. A shared
+//    pool serves the loading tasks and the parallel loops, whose caller
+//    runs chunks of the loop while it waits (no deadlock when the loop
+//    is called from a task of the pool).
+//========================================================================
+
+class UxThreadPool
+{
+private:
+  std::vector<std::thread>                _Threads;
+  std::deque<std::packaged_task<void()>>  _Tasks;
+  std::mutex                              _Mutex;
+  std::condition_variable                 _Condition;
+  bool                                    _Stopping;
+
+public:
+  // iThreadNb=0: one thread per hardware thread but the rendering one (one at least)
+  UxThreadPool(uint32_t iThreadNb = 0);
+  ~UxThreadPool();
+  __DeclareDeletedCtorsAndAssignments(UxThreadPool)
+
+  std::future<void> submit(std::function<void()> iTask);
+
+  // Calls iFunction for every index of [iBegin, iEnd[, the chunks of the range being run by the workers and the caller
+  void parallelFor(uint32_t iBegin, uint32_t iEnd, const std::function<void(uint32_t)>& iFunction);
+
+  uint32_t getThreadNb() const { return (uint32_t)_Threads.size(); }
+
+  // Pool shared by the application (created at first use, never destroyed)
+  static UxThreadPool& getShared();
+
+private:
+  void run();
+};
@@ -0,0 +1,44 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include "gl/glew.h"
+#include <stdint.h>
+
+class UxVertexArrayBase;
+
+//========================================================================
+//  Transform Feedback encapsulation:
+//    Captures the vertex stream output by the last vertex processing
+//    stage (VS, TES or GS) into the buffer of a vertex array, the
+//    captured vertices being drawn later without knowing their number.
+//========================================================================
+
+class UxTransformFeedback
+{
+private:
+  GLuint _Feedback;    // GL transform feedback object id
+  bool   _IsActive;    // Capture in progress (between begin and end)
+  bool   _IsCaptured;  // At least one capture completed since last attach
+
+public:
+  UxTransformFeedback();
+  ~UxTransformFeedback();
+  __DeclareDeletedCtorsAndAssignments(UxTransformFeedback)
+
+  GLuint id() const { return _Feedback; }
+  bool   isCaptured() const { return _IsCaptured; }
+
+  // Sets the buffer of the vertex array as capture target (storage reserved by the vertex array)
+  void attach(const UxVertexArrayBase& iCaptureArray);
+
+  // Captures the primitives drawn between begin and end (program with feedback varyings in use)
+  void begin(GLenum iPrimitiveMode);
+  void end();
+};
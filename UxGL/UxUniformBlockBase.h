@@ -1,48 +1,59 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include "UxGL.h"
-#include "UxResourceAllocator.h"
-
-class UxProgram;
-    
-//========================================================================
-//  Uniform Block encapsulation:
-//    Manages automatic resource allocation.
-//========================================================================
-
-class UxUniformBlockBase
-{
-  typedef class UxResourceAllocator<UxUniformBlockBase, GL_MAX_UNIFORM_BUFFER_BINDINGS> allocator;
-
-private:
-  std::string _Name;
-  GLuint      _Buffer;
-  GLuint      _Binding;
-  std::string _StructureName;
-  size_t      _BufferSize;
-
-protected:
-  bool        _IsMapped;
-
-public:
-
-  UxUniformBlockBase(const std::string& iName, GLenum iUsage, int32_t iBinding, const std::string& iStructureName, size_t iBufferSize);
-  virtual ~UxUniformBlockBase();
-  __DeclareDeletedCtorsAndAssignments(UxUniformBlockBase)
-
-  uint32_t            getLocation() const { return _Binding; }
-  const std::string&  getName() const { return _Name; }
-
-  void bindToProgram(const UxProgram* iProgram, const std::string& iUniformName);
-
-protected:
-  
-  void map();
-  void unmap();
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "UxResourceAllocator.h"
+
+#include <vector>
+
+class UxProgram;
+    
+//========================================================================
+//  Uniform Block encapsulation:
+//    Manages automatic resource allocation.
+//========================================================================
+
+class UxUniformBlockBase
+{
+  typedef class UxResourceAllocator<UxUniformBlockBase, GL_MAX_UNIFORM_BUFFER_BINDINGS> allocator;
+
+private:
+  std::string _Name;
+  GLuint      _Buffer;
+  GLuint      _Binding;
+  std::string _StructureName;
+  size_t      _BufferSize;
+  uint64_t    _Revision;       // Incremented each time the content of the buffer is actually modified
+
+  std::vector<uint8_t> _Content;  // Copy of the last content sent to the buffer
+  std::vector<uint8_t> _Staging;  // Content exposed between map and unmap
+
+protected:
+  bool        _IsMapped;
+
+public:
+
+  UxUniformBlockBase(const std::string& iName, GLenum iUsage, int32_t iBinding, const std::string& iStructureName, size_t iBufferSize);
+  virtual ~UxUniformBlockBase();
+  __DeclareDeletedCtorsAndAssignments(UxUniformBlockBase)
+
+  uint32_t            getLocation() const { return _Binding; }
+  const std::string&  getName() const { return _Name; }
+  uint64_t            getRevision() const { return _Revision; }
+
+  // Handle on the block (slot of its binding point) and block from a handle (nullptr if deleted since)
+  UxHandle<UxUniformBlockBase>  getHandle() const { return allocator::getHandle(_Binding); }
+  static UxUniformBlockBase*    get(const UxHandle<UxUniformBlockBase>& iHandle) { return allocator::getResource(iHandle); }
+
+  void bindToProgram(const UxProgram* iProgram, const std::string& iUniformName);
+
+protected:
+  
+  void* map();
+  void  unmap();
 };
\ No newline at end of file
@@ -0,0 +1,93 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <gl/glew.h>
+
+//========================================================================
+//  Upload Ticket:
+//    Completion of a job of the upload thread, polled by the rendering
+//    thread. The job is complete once the GPU has executed its commands
+//    (fence signaled): the objects it created or filled can be used by
+//    the rendering context.
+//========================================================================
+
+class UxUploadTicket
+{
+  friend class UxUploadThread;
+
+private:
+  std::atomic<GLsync> _Fence;         // Set by the upload thread once the commands of the job are flushed
+  bool                _IsComplete;
+
+public:
+  UxUploadTicket();
+  ~UxUploadTicket();
+  __DeclareDeletedCtorsAndAssignments(UxUploadTicket)
+
+  // No wait (rendering thread)
+  bool isComplete();
+  // Blocks until the job is executed by the GPU
+  void wait();
+};
+
+
+//========================================================================
+//  Upload Thread:
+//    Thread owning a GL context shared with the rendering one (textures,
+//    buffers and sync objects are shared, not the container objects such
+//    as the vertex arrays) to create and fill GL objects without stalling
+//    the render loop. The jobs are run in their order of submission, a
+//    fence being inserted after each of them.
+//    The jobs must not use UxGLState (cache of the rendering context
+//    bindings) nor make texture handles resident (residency is per
+//    context: done by the rendering thread once the ticket is complete).
+//    Without a started thread, the jobs are run by the caller.
+//========================================================================
+
+class UxUploadThread
+{
+private:
+  struct Job
+  {
+    std::function<void()>            job;
+    std::shared_ptr<UxUploadTicket>  ticket;
+  };
+
+  static std::thread*             _Thread;
+  static std::deque<Job>          _Jobs;
+  static std::mutex               _Mutex;
+  static std::condition_variable  _Condition;
+  static bool                     _Stopping;
+
+public:
+  __DeclareDeletedCtor(UxUploadThread)
+
+  // iBindContext(true) makes the shared context current on the calling thread, iBindContext(false) releases it
+  static void start(const std::function<void(bool)>& iBindContext);
+  // Completes the pending jobs and releases the context
+  static void stop();
+  static bool isStarted();
+
+  static std::shared_ptr<UxUploadTicket> submit(const std::function<void()>& iJob);
+  // Job without completion ticket (ie intermediate step of a sequence whose last job is submitted), may be posted by
+  // any thread once the upload thread is started
+  static void post(const std::function<void()>& iJob);
+
+private:
+  // Fence inserted after the commands of the job, flushed so that the rendering thread can wait for it
+  static void signal(UxUploadTicket& ioTicket);
+};
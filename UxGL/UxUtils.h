@@ -1,39 +1,116 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include <GL/glew.h>
-#include <vmath.h>
-
-#define SizeOfTable(table)  (sizeof(table)/sizeof(table[0]))
-
-class UxUtils
-{
-public:
-
-  //===============================================================================
-  //   Cofactor matrix (or matrix of the minors) of a 3x3 matrix
-  //     Used especially to determine inverse matrix (cf. Matrix3<T>::inverse),
-  //     but also in case of non-isometric matrix transformation (where cross
-  //     product is not distribute over this matrix transformation, i.e.
-  //     (M.V1)x(M.V2) = Cofactor(M).(V1xV2) <> M.(V1xV2)).
-  //     For Matrix4f, the cofactor are only computed on 3x3 sub-matrix 
-  //     (translation is left unchnaged).
-  //===============================================================================
-
-  static Matrix3f cofactor(Matrix3f m);
-  static Matrix4f cofactor(Matrix4f m);
-
-  static Vector3f rotatePoint(const Vector3f& iPointToRotate, const Vector3f& iPointOnAxis, const Vector3f& iAxisDirection, float iRadAngle);
-  static Vector3f rotateVector(const Vector3f& iVectorToRotate, const Vector3f& iAxisDirection, float iRadAngle);
-
-  static void createBindlessTexture(const std::string& iFilePath, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident = true);
-
-  static std::string GLSLTypeToCPlusPlus(const char* iDeclaration);
-
-  static bool deviation(float iRefValue, float iComputedValue, float iRatio);
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include <GL/glew.h>
+#include <vmath.h>
+
+#include <functional>
+#include <vector>
+
+#define SizeOfTable(table)  (sizeof(table)/sizeof(table[0]))
+
+class UxUtils
+{
+public:
+
+  //===============================================================================
+  //   Cofactor matrix (or matrix of the minors) of a 3x3 matrix
+  //     Used especially to determine inverse matrix (cf. Matrix3<T>::inverse),
+  //     but also in case of non-isometric matrix transformation (where cross
+  //     product is not distribute over this matrix transformation, i.e.
+  //     (M.V1)x(M.V2) = Cofactor(M).(V1xV2) <> M.(V1xV2)).
+  //     For Matrix4f, the cofactor are only computed on 3x3 sub-matrix 
+  //     (translation is left unchnaged).
+  //===============================================================================
+
+  static Matrix3f cofactor(Matrix3f m);
+  static Matrix4f cofactor(Matrix4f m);
+
+  static Vector3f rotatePoint(const Vector3f& iPointToRotate, const Vector3f& iPointOnAxis, const Vector3f& iAxisDirection, float iRadAngle);
+  static Vector3f rotateVector(const Vector3f& iVectorToRotate, const Vector3f& iAxisDirection, float iRadAngle);
+
+  // iMipmaps: averaged mip chain computed on CPU (8 bits components) to sample distant regions on coarser levels,
+  // iMakeResident: handle registered in the residency manager and made resident (rendering thread, see UxResidencyManager)
+  static void createBindlessTexture(const std::string& iFilePath, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident = true, bool iMipmaps = false);
+  // Image decoded on CPU, as read from the file (decoding and texture creation split so that they can run on
+  // different threads)
+  struct Image
+  {
+    std::vector<uint8_t> data;
+    GLenum               format;          // Pixel format (luminance decoded as GL_RED or GL_RG)
+    GLenum               type;            // Type of the components
+    uint32_t             componentNb;
+    uint32_t             width;
+    uint32_t             height;
+    bool                 isLuminance;     // Red (and green) read back as luminance (and alpha) through the swizzle
+  };
+
+  // Decoders serialized (DevIL state is global): may be called by any thread
+  static void decodeImage(const std::string& iFilePath, Image& oImage);
+  static void createTexture(const Image& iImage, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident = true, bool iMipmaps = false);
+  // Height map decoded on CPU, single channel in the type of the texture storage (kept to derive the CPU heights
+  // without reading the texture back)
+  struct HeightImage
+  {
+    std::vector<uint8_t> samples;         // Row-major
+    GLenum               internalFormat;  // R8, R16 (normalized), R16F or R32F
+    GLenum               type;            // Type of the samples (GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_HALF_FLOAT or GL_FLOAT)
+    uint32_t             width;
+    uint32_t             height;
+    Vector2f             range;           // Remapping of the values to [0,1] (value*scale+offset): elevations of the float formats
+  };
+
+  // Progressive decoding of a height map: onStart once the image is allocated (dimensions and format known, no sample
+  // decoded yet), onStrip every time rows are decoded (called by the decoding threads, in any order)
+  struct HeightDecodingListener
+  {
+    std::function<void(const HeightImage& iImage)>            onStart;
+    std::function<void(uint32_t iFirstRow, uint32_t iRowNb)>  onStrip;
+  };
+
+  // Decoded by strips of rows in parallel, straight into the single channel of the storage: headerless raw files (.r8,
+  // .r16 or .raw, .r32 for floats: little endian, iRawSize or square if null) read by strips, PNG rows inflated by libpng
+  // and TIFF strips decompressed by libtiff while converted, other formats (and layouts unsupported by both paths)
+  // decoded by DevIL then converted by strips. iInternalFormat=0 selecting the format from the decoded image (8 bits:
+  // R8, 16 bits: R16, float: R32F)
+  static void decodeHeightMap(const std::string& iFilePath, GLenum iInternalFormat, HeightImage& oImage, const HeightDecodingListener* iListener = nullptr, const Vector2i& iRawSize = Vector2i(0, 0));
+  static void createHeightTexture(const HeightImage& iImage, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident = true, bool iMipmaps = false);
+  // Steps of createHeightTexture for a progressive upload: storage allocated once the dimensions are known, rows filled
+  // as they are decoded, mip chain and handle once the whole image is decoded
+  static void createHeightStorage(const HeightImage& iImage, GLuint& oTextureName, bool iMipmaps = false);
+  static void uploadHeightRows(GLuint iTextureName, const HeightImage& iImage, uint32_t iFirstRow, uint32_t iRowNb);
+  static void completeHeightTexture(const HeightImage& iImage, GLuint iTextureName, GLuint64& oTextureHandle, bool iMakeResident = true, bool iMipmaps = false);
+  // Rows of a texture level filled from a pixel unpack buffer (transfer done by the GPU, asynchronously)
+  static void uploadTextureRows(GLuint iTextureName, GLint iLevel, uint32_t iFirstRow, uint32_t iWidth, uint32_t iRowNb, GLenum iFormat, GLenum iType, const void* iData, size_t iSize);
+  static void createMipmaps(GLuint iTextureName, uint32_t iWidth, uint32_t iHeight, GLenum iFormat, uint32_t iComponentNb, const uint8_t* iData);
+  // Sized internal format of a texture storage (1 to 4 components, 8 or 16 bits normalized or 32 bits float)
+  static GLenum getSizedFormat(uint32_t iComponentNb, GLenum iType);
+  // Bytes of the storage of a texture (all levels and layers, read from the context)
+  static uint64_t getTextureSize(GLuint iTextureName);
+
+  // Type of the components of a single channel texture (GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_HALF_FLOAT or GL_FLOAT) and its size
+  static GLenum   getHeightType(GLenum iInternalFormat);
+  static uint32_t getTypeSize(GLenum iType);
+  // Half precision float (IEEE 754 binary16) from/to float
+  static float    halfToFloat(uint16_t iHalf);
+  static uint16_t floatToHalf(float iValue);
+  // Sample of a single channel type read as a float (integer types normalized) or written from it (clamped to [0,1]
+  // and rounded for the integer types)
+  static float    loadSample(const uint8_t* iSample, GLenum iType);
+  static void     storeSample(uint8_t* oSample, GLenum iType, float iValue);
+
+  // Calls iFunction for every index of [iBegin, iEnd[, the range being split among the threads of the shared pool and the caller
+  static void parallelFor(uint32_t iBegin, uint32_t iEnd, const std::function<void(uint32_t)>& iFunction);
+
+  static std::string GLSLTypeToCPlusPlus(const char* iDeclaration);
+
+  static bool deviation(float iRefValue, float iComputedValue, float iRatio);
+
+  // Morton code (Z-order) of 2D coordinates, x on even bits and y on odd bits
+  static uint32_t mortonCode(uint16_t iX, uint16_t iY);
 };
\ No newline at end of file
@@ -1,48 +1,65 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#pragma once
-
-#include "UxGL.h"
-#include "UxIndexBuffer.h"
-#include "UxVertexInputAttribute.h"
-
-//========================================================================
-//  Vertex Array Object (VAO) encapsulation:
-//    Manages buffer of vefrtex to configure elements to draw in 
-//    conjonction with a Element Array Buffer or UxIndexBuffer.
-//    Base class, the derive class are templates integrating the data
-//    structure of a vertex (position, color, texture coordinates...).
-//========================================================================
-
-class UxVertexArrayBase
-{
-private:
-  GLuint  _Array;        // GL vertex array id
-  GLuint  _Buffer;       // GL buffer (vertices) id
-  int32_t _BufferSize;   // Size of the buffer fed with the vector
-
-public:
-
-  UxVertexArrayBase();
-  ~UxVertexArrayBase();
-  __DeclareDeletedCtorsAndAssignments(UxVertexArrayBase)
-
-  virtual void clearVector();                          // Removes all the values from the vector
-  void store(GLenum iUsage);                           // Stores the vector content into the buffer
-  void bind(const UxIndexBuffer& iIndexBuffer) const;  // Bind the buffer to the current context (prior glDrawElements)
-  static void unbind();                                // Unbind any buffer to the current context 
-
-  // Links a vertex attribute to the array
-  void linkAttribute(std::shared_ptr<UxVertexInputAttribute> iInputAttribute, GLenum iDataAttributeType, uint32_t iNbComponents, 
-                     uint32_t iAttributeSize, uint32_t iAttributeOffset, bool iNormalized);
-
-protected:
-  // To be implemented by derived class tempate
-  virtual uint32_t     getElementNumber() const = 0;
-  virtual uint32_t     getStructureSize() const = 0;
-  virtual const void*  getData() const = 0;
-};
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#pragma once
+
+#include "UxGL.h"
+#include "UxIndexBuffer.h"
+#include "UxVertexInputAttribute.h"
+
+class UxStreamBuffer;
+
+//========================================================================
+//  Vertex Array Object (VAO) encapsulation:
+//    Manages buffer of vefrtex to configure elements to draw in 
+//    conjonction with a Element Array Buffer or UxIndexBuffer.
+//    Base class, the derive class are templates integrating the data
+//    structure of a vertex (position, color, texture coordinates...).
+//========================================================================
+
+class UxVertexArrayBase
+{
+private:
+  GLuint      _Array;          // GL vertex array id
+  GLuint      _Buffer;         // GL buffer (vertices) id
+  int32_t     _BufferSize;     // Size of the buffer fed with the vector
+  GLsizeiptr  _AllocatedSize;  // Size of the buffer storage (bytes), kept while the content fits
+  bool        _IsStreamed;     // Vertices read from a stream buffer region
+  bool        _IsStreaming;    // Between beginStream and endStream
+
+public:
+
+  UxVertexArrayBase();
+  ~UxVertexArrayBase();
+  __DeclareDeletedCtorsAndAssignments(UxVertexArrayBase)
+
+  virtual void clearVector();                          // Removes all the values from the vector
+  void store(GLenum iUsage);                           // Stores the vector content into the buffer
+  void reserve(uint32_t iElementNumber, GLenum iUsage); // Allocates the buffer without data (fed by the GPU, ie transform feedback)
+  void bind(const UxIndexBuffer& iIndexBuffer) const;  // Bind the array with the index buffer attached (prior glDrawElements)
+
+  // Vertices written directly in a region of the stream buffer (no vector, no copy), read by the array until the
+  // next store or stream. The region remains valid until the next allocations of the stream.
+  void* beginStream(UxStreamBuffer& ioStream, uint32_t iMaxElementNumber);
+  void  endStream(uint32_t iElementNumber);
+
+  GLuint  getArray() const { return _Array; }
+  GLuint  getBuffer() const { return _Buffer; }
+  int32_t getBufferSize() const { return _BufferSize; }
+
+  // Links a vertex attribute to the array
+  void linkAttribute(std::shared_ptr<UxVertexInputAttribute> iInputAttribute, GLenum iDataAttributeType, uint32_t iNbComponents, 
+                     uint32_t iAttributeSize, uint32_t iAttributeOffset, bool iNormalized);
+
+private:
+  void restoreBuffer();
+
+protected:
+  // To be implemented by derived class tempate
+  virtual uint32_t     getElementNumber() const = 0;
+  virtual uint32_t     getStructureSize() const = 0;
+  virtual const void*  getData() const = 0;
+};
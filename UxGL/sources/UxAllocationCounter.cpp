@@ -0,0 +1,204 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxAllocationCounter.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+std::atomic<uint64_t>                 UxAllocationCounter::_AllocationNb(0);
+std::atomic<uint64_t>                 UxAllocationCounter::_AllocatedSize(0);
+UxAllocationCounter::Hook             UxAllocationCounter::_Hook = nullptr;
+
+std::atomic<bool>                     UxAllocationCounter::_Tracking(false);
+thread_local UxAllocationCounter::Tag UxAllocationCounter::_CurrentTag = UxAllocationCounter::Untagged;
+std::atomic<uint64_t>                 UxAllocationCounter::_FrameAllocationNb[TagNb];
+std::atomic<uint64_t>                 UxAllocationCounter::_FrameAllocatedSize[TagNb];
+UxAllocationCounter::Statistics       UxAllocationCounter::_LastFrame[TagNb];
+UxAllocationCounter::Statistics       UxAllocationCounter::_MaxFrame[TagNb];
+UxAllocationCounter::Statistics       UxAllocationCounter::_Total[TagNb];
+uint64_t                              UxAllocationCounter::_FrameNb = 0;
+
+void UxAllocationCounter::count(size_t iSize)
+{
+  _AllocationNb.fetch_add(1, std::memory_order_relaxed);
+  _AllocatedSize.fetch_add(iSize, std::memory_order_relaxed);
+  if (_Tracking.load(std::memory_order_relaxed))
+  {
+    _FrameAllocationNb[_CurrentTag].fetch_add(1, std::memory_order_relaxed);
+    _FrameAllocatedSize[_CurrentTag].fetch_add(iSize, std::memory_order_relaxed);
+  }
+  if (_Hook)
+    _Hook(iSize);
+}
+
+void UxAllocationCounter::endFrame()
+{
+  for (uint32_t tag = 0; tag < TagNb; tag++)
+  {
+    Statistics frame;
+    frame.allocationNb  = _FrameAllocationNb[tag].exchange(0, std::memory_order_relaxed);
+    frame.allocatedSize = _FrameAllocatedSize[tag].exchange(0, std::memory_order_relaxed);
+
+    _LastFrame[tag] = frame;
+    if (frame.allocationNb > _MaxFrame[tag].allocationNb)
+      _MaxFrame[tag].allocationNb = frame.allocationNb;
+    if (frame.allocatedSize > _MaxFrame[tag].allocatedSize)
+      _MaxFrame[tag].allocatedSize = frame.allocatedSize;
+    _Total[tag].allocationNb  += frame.allocationNb;
+    _Total[tag].allocatedSize += frame.allocatedSize;
+  }
+  _FrameNb++;
+}
+
+const char* UxAllocationCounter::getTagName(Tag iTag)
+{
+  static const char* names[TagNb] = { "untagged", "terrain_data", "shader_preprocessing", "buffer_staging", "overlay_text" };
+  return names[iTag];
+}
+
+bool UxAllocationCounter::writeJSON(const std::string& iFileName)
+{
+  FILE* fp = nullptr;
+  if (fopen_s(&fp, iFileName.c_str(), "w"))
+    return false;
+
+  fprintf(fp, "{\n  \"frames\": %llu,\n  \"subsystems\": {", (unsigned long long)_FrameNb);
+  for (uint32_t tag = 0; tag < TagNb; tag++)
+  {
+    const Statistics* statistics[3] = { &_LastFrame[tag], &_MaxFrame[tag], &_Total[tag] };
+    const char*       names[3]      = { "last_frame", "max_frame", "total" };
+
+    fprintf(fp, "%s\n    \"%s\": {", tag == 0 ? "" : ",", getTagName((Tag)tag));
+    for (uint32_t index = 0; index < 3; index++)
+      fprintf(fp, "%s\n      \"%s\": { \"allocations\": %llu, \"bytes\": %llu }", index == 0 ? "" : ",", names[index],
+        (unsigned long long)statistics[index]->allocationNb, (unsigned long long)statistics[index]->allocatedSize);
+    fprintf(fp, "\n    }");
+  }
+  fprintf(fp, "\n  }\n}\n");
+
+  fclose(fp);
+  return true;
+}
+
+//========================================================================
+//  Replacement of the global allocation functions (linked with the
+//  counter, this module being referenced by the application)
+//========================================================================
+
+void* operator new(size_t iSize)
+{
+  UxAllocationCounter::count(iSize);
+  void* p = malloc(iSize ? iSize : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t iSize)
+{
+  return operator new(iSize);
+}
+
+void* operator new(size_t iSize, const std::nothrow_t&) noexcept
+{
+  UxAllocationCounter::count(iSize);
+  return malloc(iSize ? iSize : 1);
+}
+
+void* operator new[](size_t iSize, const std::nothrow_t& iTag) noexcept
+{
+  return operator new(iSize, iTag);
+}
+
+void operator delete(void* iPointer) noexcept
+{
+  free(iPointer);
+}
+
+void operator delete[](void* iPointer) noexcept
+{
+  free(iPointer);
+}
+
+void operator delete(void* iPointer, size_t) noexcept
+{
+  free(iPointer);
+}
+
+void operator delete[](void* iPointer, size_t) noexcept
+{
+  free(iPointer);
+}
+
+void operator delete(void* iPointer, const std::nothrow_t&) noexcept
+{
+  free(iPointer);
+}
+
+void operator delete[](void* iPointer, const std::nothrow_t&) noexcept
+{
+  free(iPointer);
+}
+
+// Over-aligned types (alignment above the default of new), served by the aligned heap of the C runtime
+
+void* operator new(size_t iSize, std::align_val_t iAlignment)
+{
+  UxAllocationCounter::count(iSize);
+  void* p = _aligned_malloc(iSize ? iSize : 1, (size_t)iAlignment);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t iSize, std::align_val_t iAlignment)
+{
+  return operator new(iSize, iAlignment);
+}
+
+void* operator new(size_t iSize, std::align_val_t iAlignment, const std::nothrow_t&) noexcept
+{
+  UxAllocationCounter::count(iSize);
+  return _aligned_malloc(iSize ? iSize : 1, (size_t)iAlignment);
+}
+
+void* operator new[](size_t iSize, std::align_val_t iAlignment, const std::nothrow_t& iTag) noexcept
+{
+  return operator new(iSize, iAlignment, iTag);
+}
+
+void operator delete(void* iPointer, std::align_val_t) noexcept
+{
+  _aligned_free(iPointer);
+}
+
+void operator delete[](void* iPointer, std::align_val_t) noexcept
+{
+  _aligned_free(iPointer);
+}
+
+void operator delete(void* iPointer, size_t, std::align_val_t) noexcept
+{
+  _aligned_free(iPointer);
+}
+
+void operator delete[](void* iPointer, size_t, std::align_val_t) noexcept
+{
+  _aligned_free(iPointer);
+}
+
+void operator delete(void* iPointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  _aligned_free(iPointer);
+}
+
+void operator delete[](void* iPointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+  _aligned_free(iPointer);
+}
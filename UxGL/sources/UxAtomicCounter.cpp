@@ -1,52 +1,50 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "UxAtomicCounter.h"
-
-#include "UxError.h"
-
-#include <cassert>
-
-UxAtomicCounter::UxAtomicCounter(GLuint iBinding, GLuint iOffset)
-{
-  _Buffer  = 0;
-  _Binding = iBinding;
-  _Offset  = iOffset;
-
-  glGenBuffers(1, &_Buffer);
-  __CheckGLErrors;
-  glBindBuffer(GL_ATOMIC_COUNTER_BUFFER , _Buffer);
-  __CheckGLErrors;
-  glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, _Binding, _Buffer);
-  glBufferData(GL_ATOMIC_COUNTER_BUFFER , sizeof(GLuint), nullptr, GL_DYNAMIC_READ);
-  __CheckGLErrors;
-}
-
-UxAtomicCounter::~UxAtomicCounter()
-{
-  glDeleteBuffers(1, &_Buffer);
-  _Buffer = 0;
-}
-
-void UxAtomicCounter::set(uint32_t iValue)
-{
-  assert(_Buffer);
-  glBindBuffer(GL_ATOMIC_COUNTER_BUFFER , _Buffer);
-  __CheckGLErrors;
-  glBufferSubData(GL_ATOMIC_COUNTER_BUFFER , _Offset, sizeof(GLuint), &iValue);
-  __CheckGLErrors;
-}
-
-uint32_t UxAtomicCounter::get() const
-{
-  assert(_Buffer);
-  GLuint rValue = -1;
-  glBindBuffer(GL_ATOMIC_COUNTER_BUFFER , _Buffer);
-  __CheckGLErrors;
-  glGetBufferSubData(GL_ATOMIC_COUNTER_BUFFER , _Offset, sizeof(GLuint), &rValue);
-  __CheckGLErrors;
-  return rValue;
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxAtomicCounter.h"
+#include "UxGLState.h"
+#include "UxGPUMemoryRegistry.h"
+
+#include "UxError.h"
+
+#include <cassert>
+
+UxAtomicCounter::UxAtomicCounter(GLuint iBinding, GLuint iOffset)
+{
+  _Buffer  = 0;
+  _Binding = iBinding;
+  _Offset  = iOffset;
+
+  // Buffer bound once to its binding point, the value being set and read without binding
+  glCreateBuffers(1, &_Buffer);
+  __CheckGLErrors;
+  glNamedBufferData(_Buffer, sizeof(GLuint), nullptr, GL_DYNAMIC_READ);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Buffer, _Buffer, "UxAtomicCounter", sizeof(GLuint), GL_DYNAMIC_READ);
+  glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, _Binding, _Buffer);
+  __CheckGLErrors;
+}
+
+UxAtomicCounter::~UxAtomicCounter()
+{
+  UxGLState::deleteBuffer(_Buffer);
+}
+
+void UxAtomicCounter::set(uint32_t iValue)
+{
+  assert(_Buffer);
+  glNamedBufferSubData(_Buffer, _Offset, sizeof(GLuint), &iValue);
+  __CheckGLErrors;
+}
+
+uint32_t UxAtomicCounter::get() const
+{
+  assert(_Buffer);
+  GLuint rValue = -1;
+  glGetNamedBufferSubData(_Buffer, _Offset, sizeof(GLuint), &rValue);
+  __CheckGLErrors;
+  return rValue;
+}
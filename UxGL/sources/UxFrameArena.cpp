@@ -0,0 +1,116 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxFrameArena.h"
+#include "UxError.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdarg>
+#include <cstdlib>
+
+uint8_t*             UxFrameArena::_Block     = nullptr;
+size_t               UxFrameArena::_Capacity  = 0;
+size_t               UxFrameArena::_Used      = 0;
+size_t               UxFrameArena::_Requested = 0;
+std::vector<void*>*  UxFrameArena::_Overflows = nullptr;
+
+void UxFrameArena::reserve(size_t iCapacity)
+{
+  assert(_Used == 0);
+
+  if (iCapacity <= _Capacity)
+    return;
+
+  free(_Block);
+  _Block = reinterpret_cast<uint8_t*>(malloc(iCapacity));
+  if (!_Block)
+  {
+    UxError::error(__FILE__, __LINE__) << "Can't allocate the frame arena (" << iCapacity << " bytes).\n";
+    UxError::exit(-1);
+  }
+  _Capacity = iCapacity;
+}
+
+void UxFrameArena::reset()
+{
+  if (_Overflows && !_Overflows->empty())
+  {
+    for (auto block : *_Overflows)
+      free(block);
+    _Overflows->clear();
+  }
+
+  // Block enlarged to the needs of the last frame (with margin) so the next frames don't overflow
+  size_t requested = _Requested;
+  _Used      = 0;
+  _Requested = 0;
+  if (requested > _Capacity)
+    reserve(requested + requested / 2);
+}
+
+void* UxFrameArena::allocate(size_t iSize, size_t iAlignment)
+{
+  assert(iAlignment > 0 && (iAlignment & (iAlignment - 1)) == 0);
+
+  size_t start = (_Used + iAlignment - 1) & ~(iAlignment - 1);
+  _Requested += iSize + iAlignment - 1;
+
+  if (_Block && start + iSize <= _Capacity)
+  {
+    _Used = start + iSize;
+    return _Block + start;
+  }
+
+  // Overflow served by the heap until the next reset (malloc aligned for any fundamental type)
+  assert(iAlignment <= alignof(max_align_t));
+  if (!_Overflows)
+    _Overflows = new std::vector<void*>();
+  void* block = malloc(iSize);
+  if (!block)
+  {
+    UxError::error(__FILE__, __LINE__) << "Can't allocate the overflow of the frame arena (" << iSize << " bytes).\n";
+    UxError::exit(-1);
+  }
+  _Overflows->push_back(block);
+  return block;
+}
+
+const char* UxFrameArena::format(const char* iFormat, ...)
+{
+  va_list args;
+  va_start(args, iFormat);
+  int length = vsnprintf(nullptr, 0, iFormat, args);
+  va_end(args);
+
+  char* text = allocate<char>(length + 1);
+  va_start(args, iFormat);
+  vsnprintf(text, length + 1, iFormat, args);
+  va_end(args);
+  return text;
+}
+
+UxFrameText::UxFrameText(size_t iCapacity)
+{
+  assert(iCapacity > 0);
+
+  _Text     = UxFrameArena::allocate<char>(iCapacity);
+  _Text[0]  = '\0';
+  _Length   = 0;
+  _Capacity = iCapacity;
+}
+
+UxFrameText& UxFrameText::append(const char* iFormat, ...)
+{
+  va_list args;
+  va_start(args, iFormat);
+  int length = vsnprintf(_Text + _Length, _Capacity - _Length, iFormat, args);
+  va_end(args);
+
+  if (length > 0)
+    _Length = _Length + length < _Capacity ? _Length + length : _Capacity - 1;
+  return *this;
+}
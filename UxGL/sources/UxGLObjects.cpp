@@ -1,61 +1,102 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "UxGLObjects.h"
-
-#include "UxVertexInputAttribute.h"
-#include "UxUniformBlockBase.h"
-
-bool UxGLObjects::_Startup = false;
-std::vector<std::shared_ptr<UxUniformBlockBase>>*      UxGLObjects::_UniformBlocks   = nullptr;
-std::vector<std::shared_ptr<UxVertexInputAttribute>>*  UxGLObjects::_InputAttributes = nullptr;
-
-void UxGLObjects::Startup()
-{
-  if (!_Startup)
-  {
-    _UniformBlocks   = new std::vector<std::shared_ptr<UxUniformBlockBase>>();
-    _InputAttributes = new std::vector<std::shared_ptr<UxVertexInputAttribute>>();
-
-    _Startup = true;
-  }
-}
-
-void UxGLObjects::addInputAttribute(const std::string& iAttributeName)
-{
-  Startup();
-
-  UxVertexInputAttribute* pAttribute = new UxVertexInputAttribute(iAttributeName);
-  _InputAttributes->push_back(std::shared_ptr<UxVertexInputAttribute>(pAttribute));
-}
-
-std::shared_ptr<UxVertexInputAttribute> UxGLObjects::getInputAttribute(const std::string& iAttributeName)
-{
-  Startup();
-
-  for (auto it = _InputAttributes->cbegin(); it != _InputAttributes->cend(); it++)
-  {
-    if ((*it)->getName() == iAttributeName)
-      return *it;
-  }
-
-  __Assert(std::string("Vertex Input Attribute \"") + iAttributeName + "\" not (yet) registered.");
-  return std::shared_ptr<UxVertexInputAttribute>();
-}
-
-std::shared_ptr<UxUniformBlockBase> UxGLObjects::getUniformBlock(const std::string& iBlockName)
-{
-  Startup();
-
-  for (auto it = _UniformBlocks->cbegin(); it != _UniformBlocks->cend(); it++)
-  {
-    if ((*it)->getName() == iBlockName)
-      return *it;
-  }
-
-  __Assert(std::string("Uniform Block \"") + iBlockName + "\" not (yet) registered.");
-  return nullptr;
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxGLObjects.h"
+
+#include "UxVertexInputAttribute.h"
+#include "UxUniformBlockBase.h"
+#include "UxShaderStorageBase.h"
+
+#include <cassert>
+
+bool UxGLObjects::_Startup = false;
+std::vector<std::shared_ptr<UxUniformBlockBase>>*      UxGLObjects::_UniformBlocks   = nullptr;
+std::vector<std::shared_ptr<UxVertexInputAttribute>>*  UxGLObjects::_InputAttributes = nullptr;
+std::vector<std::shared_ptr<UxShaderStorageBase>>*     UxGLObjects::_ShaderStorages  = nullptr;
+
+void UxGLObjects::Startup()
+{
+  if (!_Startup)
+  {
+    _UniformBlocks   = new std::vector<std::shared_ptr<UxUniformBlockBase>>();
+    _InputAttributes = new std::vector<std::shared_ptr<UxVertexInputAttribute>>();
+    _ShaderStorages  = new std::vector<std::shared_ptr<UxShaderStorageBase>>();
+
+    _Startup = true;
+  }
+}
+
+UxHandle<UxVertexInputAttribute> UxGLObjects::addInputAttribute(const std::string& iAttributeName)
+{
+  Startup();
+
+  UxVertexInputAttribute* pAttribute = new UxVertexInputAttribute(iAttributeName);
+  _InputAttributes->push_back(std::shared_ptr<UxVertexInputAttribute>(pAttribute));
+  return pAttribute->getHandle();
+}
+
+std::shared_ptr<UxVertexInputAttribute> UxGLObjects::getInputAttribute(const std::string& iAttributeName)
+{
+  Startup();
+
+  for (auto it = _InputAttributes->cbegin(); it != _InputAttributes->cend(); it++)
+  {
+    if ((*it)->getName() == iAttributeName)
+      return *it;
+  }
+
+  __Assert(std::string("Vertex Input Attribute \"") + iAttributeName + "\" not (yet) registered.");
+  return std::shared_ptr<UxVertexInputAttribute>();
+}
+
+UxVertexInputAttribute* UxGLObjects::getInputAttribute(const UxHandle<UxVertexInputAttribute>& iAttribute)
+{
+  UxVertexInputAttribute* pAttribute = UxVertexInputAttribute::getAttribute(iAttribute);
+  assert(pAttribute);
+  return pAttribute;
+}
+
+std::shared_ptr<UxUniformBlockBase> UxGLObjects::getUniformBlock(const std::string& iBlockName)
+{
+  Startup();
+
+  for (auto it = _UniformBlocks->cbegin(); it != _UniformBlocks->cend(); it++)
+  {
+    if ((*it)->getName() == iBlockName)
+      return *it;
+  }
+
+  __Assert(std::string("Uniform Block \"") + iBlockName + "\" not (yet) registered.");
+  return nullptr;
+}
+
+UxUniformBlockBase* UxGLObjects::getUniformBlock(const UxHandle<UxUniformBlockBase>& iUniformBlock)
+{
+  UxUniformBlockBase* pBlock = UxUniformBlockBase::get(iUniformBlock);
+  assert(pBlock);
+  return pBlock;
+}
+
+std::shared_ptr<UxShaderStorageBase> UxGLObjects::getShaderStorage(const std::string& iStorageName)
+{
+  Startup();
+
+  for (auto it = _ShaderStorages->cbegin(); it != _ShaderStorages->cend(); it++)
+  {
+    if ((*it)->getName() == iStorageName)
+      return *it;
+  }
+
+  __Assert(std::string("Shader Storage \"") + iStorageName + "\" not (yet) registered.");
+  return nullptr;
+}
+
+UxShaderStorageBase* UxGLObjects::getShaderStorage(const UxHandle<UxShaderStorageBase>& iShaderStorage)
+{
+  UxShaderStorageBase* pStorage = UxShaderStorageBase::get(iShaderStorage);
+  assert(pStorage);
+  return pStorage;
+}
@@ -0,0 +1,153 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxGLState.h"
+
+#include "UxError.h"
+#include "UxGPUMemoryRegistry.h"
+
+// Unknown state (forces the next change to be sent)
+static const GLuint UnknownName = 0xFFFFFFFF;
+
+GLuint                    UxGLState::_Program               = UnknownName;
+GLuint                    UxGLState::_VertexArray           = UnknownName;
+std::map<GLuint, GLuint>  UxGLState::_ElementBuffers;
+std::map<GLenum, GLuint>  UxGLState::_Buffers;
+std::map<GLenum, bool>    UxGLState::_Capabilities;
+uint64_t                  UxGLState::_ChangeNb              = 0;
+uint64_t                  UxGLState::_SkippedChangeNb       = 0;
+
+void UxGLState::useProgram(GLuint iProgram)
+{
+  if (_Program == iProgram)
+  {
+    _SkippedChangeNb++;
+    return;
+  }
+
+  glUseProgram(iProgram);
+  __CheckGLErrors;
+  _Program = iProgram;
+  _ChangeNb++;
+}
+
+void UxGLState::bindVertexArray(GLuint iVertexArray, GLuint iElementBuffer)
+{
+  // The element buffer is a state of the vertex array (attached without binding)
+  auto it = _ElementBuffers.find(iVertexArray);
+  if (iVertexArray != 0 && (it == _ElementBuffers.end() || it->second != iElementBuffer))
+  {
+    glVertexArrayElementBuffer(iVertexArray, iElementBuffer);
+    __CheckGLErrors;
+    _ElementBuffers[iVertexArray] = iElementBuffer;
+    _ChangeNb++;
+  }
+  else
+    _SkippedChangeNb++;
+
+  if (_VertexArray == iVertexArray)
+  {
+    _SkippedChangeNb++;
+    return;
+  }
+
+  glBindVertexArray(iVertexArray);
+  __CheckGLErrors;
+  _VertexArray = iVertexArray;
+  _ChangeNb++;
+}
+
+void UxGLState::bindBuffer(GLenum iTarget, GLuint iBuffer)
+{
+  auto it = _Buffers.find(iTarget);
+  if (it != _Buffers.end() && it->second == iBuffer)
+  {
+    _SkippedChangeNb++;
+    return;
+  }
+
+  glBindBuffer(iTarget, iBuffer);
+  __CheckGLErrors;
+  _Buffers[iTarget] = iBuffer;
+  _ChangeNb++;
+}
+
+void UxGLState::setCapability(GLenum iCapability, bool iEnabled)
+{
+  auto it = _Capabilities.find(iCapability);
+  if (it != _Capabilities.end() && it->second == iEnabled)
+  {
+    _SkippedChangeNb++;
+    return;
+  }
+
+  if (iEnabled)
+    glEnable(iCapability);
+  else
+    glDisable(iCapability);
+  __CheckGLErrors;
+  _Capabilities[iCapability] = iEnabled;
+  _ChangeNb++;
+}
+
+void UxGLState::deleteProgram(GLuint& ioProgram)
+{
+  if (ioProgram == 0)
+    return;
+
+  if (_Program == ioProgram)
+    _Program = UnknownName;
+
+  glDeleteProgram(ioProgram);
+  ioProgram = 0;
+}
+
+void UxGLState::deleteVertexArray(GLuint& ioVertexArray)
+{
+  if (ioVertexArray == 0)
+    return;
+
+  // Deleting the bound vertex array reverts the binding to zero
+  if (_VertexArray == ioVertexArray)
+    _VertexArray = 0;
+  _ElementBuffers.erase(ioVertexArray);
+
+  glDeleteVertexArrays(1, &ioVertexArray);
+  ioVertexArray = 0;
+}
+
+void UxGLState::deleteBuffer(GLuint& ioBuffer)
+{
+  if (ioBuffer == 0)
+    return;
+
+  // Deleting a buffer unbinds it from the context, but not from the vertex arrays not bound: forgetting the
+  // attachment forces it to be set again if the name is reused
+  for (auto& buffer : _Buffers)
+  {
+    if (buffer.second == ioBuffer)
+      buffer.second = 0;
+  }
+  for (auto it = _ElementBuffers.begin(); it != _ElementBuffers.end();)
+  {
+    if (it->second == ioBuffer)
+      it = _ElementBuffers.erase(it);
+    else
+      it++;
+  }
+
+  UxGPUMemoryRegistry::release(UxGPUMemoryRegistry::Buffer, ioBuffer);
+  glDeleteBuffers(1, &ioBuffer);
+  ioBuffer = 0;
+}
+
+void UxGLState::invalidate()
+{
+  _Program               = UnknownName;
+  _VertexArray           = UnknownName;
+  _Buffers.clear();
+  _Capabilities.clear();
+}
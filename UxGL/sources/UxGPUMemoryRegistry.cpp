@@ -0,0 +1,121 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxGPUMemoryRegistry.h"
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+std::mutex                                                               UxGPUMemoryRegistry::_Mutex;
+std::map<std::pair<UxGPUMemoryRegistry::Type, GLuint>, UxGPUMemoryRegistry::Allocation> UxGPUMemoryRegistry::_Allocations;
+UxGPUMemoryRegistry::Statistics                                          UxGPUMemoryRegistry::_Frame[TypeNb];
+UxGPUMemoryRegistry::Statistics                                          UxGPUMemoryRegistry::_LastFrame[TypeNb];
+uint64_t                                                                 UxGPUMemoryRegistry::_PeakSize[TypeNb];
+uint64_t                                                                 UxGPUMemoryRegistry::_FrameNb = 0;
+
+void UxGPUMemoryRegistry::record(Type iType, GLuint iName, const std::string& iOwner, uint64_t iSize, GLenum iUsage)
+{
+  std::lock_guard<std::mutex> lock(_Mutex);
+
+  Statistics& frame = _Frame[iType];
+  auto it = _Allocations.find({ iType, iName });
+  if (it == _Allocations.end())
+  {
+    Allocation allocation = { iOwner, iSize, iUsage, 0, _FrameNb };
+    _Allocations[{ iType, iName }] = allocation;
+    frame.objectNb++;
+    frame.size += iSize;
+  }
+  else
+  {
+    // Storage replaced: previous bytes released
+    Allocation& allocation = it->second;
+    frame.size          += iSize;
+    frame.size          -= allocation.size;
+    frame.releasedSize  += allocation.size;
+    allocation.size      = iSize;
+    allocation.usage     = iUsage;
+    allocation.frame     = _FrameNb;
+    allocation.reallocationNb++;
+  }
+  frame.allocatedSize += iSize;
+  frame.peakSize       = std::max(frame.peakSize, frame.size);
+  _PeakSize[iType]     = std::max(_PeakSize[iType], frame.size);
+}
+
+void UxGPUMemoryRegistry::release(Type iType, GLuint iName)
+{
+  std::lock_guard<std::mutex> lock(_Mutex);
+
+  auto it = _Allocations.find({ iType, iName });
+  if (it == _Allocations.end())
+    return;
+
+  Statistics& frame = _Frame[iType];
+  frame.objectNb--;
+  frame.size         -= it->second.size;
+  frame.releasedSize += it->second.size;
+  _Allocations.erase(it);
+}
+
+void UxGPUMemoryRegistry::endFrame()
+{
+  std::lock_guard<std::mutex> lock(_Mutex);
+
+  for (uint32_t type = 0; type < TypeNb; type++)
+  {
+    _LastFrame[type] = _Frame[type];
+
+    // Next frame starting from the current total
+    _Frame[type].peakSize      = _Frame[type].size;
+    _Frame[type].allocatedSize = 0;
+    _Frame[type].releasedSize  = 0;
+  }
+  _FrameNb++;
+}
+
+const char* UxGPUMemoryRegistry::getTypeName(Type iType)
+{
+  static const char* names[TypeNb] = { "buffer", "texture" };
+  return names[iType];
+}
+
+bool UxGPUMemoryRegistry::writeJSON(const std::string& iFileName)
+{
+  std::lock_guard<std::mutex> lock(_Mutex);
+
+  FILE* fp = nullptr;
+  if (fopen_s(&fp, iFileName.c_str(), "w"))
+    return false;
+
+  fprintf(fp, "{\n  \"frames\": %llu,\n  \"types\": {", (unsigned long long)_FrameNb);
+  for (uint32_t type = 0; type < TypeNb; type++)
+  {
+    fprintf(fp, "%s\n    \"%s\": { \"objects\": %u, \"bytes\": %llu, \"peak_bytes\": %llu, \"last_frame_peak_bytes\": %llu }", type == 0 ? "" : ",",
+      getTypeName((Type)type), _Frame[type].objectNb, (unsigned long long)_Frame[type].size, (unsigned long long)_PeakSize[type], (unsigned long long)_LastFrame[type].peakSize);
+  }
+
+  // Largest allocations first
+  typedef std::map<std::pair<Type, GLuint>, Allocation>::value_type Entry;
+  std::vector<const Entry*> allocations;
+  for (const auto& allocation : _Allocations)
+    allocations.push_back(&allocation);
+  std::sort(allocations.begin(), allocations.end(), [](const Entry* iA, const Entry* iB) { return iA->second.size > iB->second.size; });
+
+  fprintf(fp, "\n  },\n  \"allocations\": [");
+  for (size_t rank = 0; rank < allocations.size(); rank++)
+  {
+    const Allocation& allocation = allocations[rank]->second;
+    fprintf(fp, "%s\n    { \"type\": \"%s\", \"name\": %u, \"owner\": \"%s\", \"bytes\": %llu, \"usage\": \"0x%04X\", \"reallocations\": %u, \"frame\": %llu }", rank == 0 ? "" : ",",
+      getTypeName(allocations[rank]->first.first), allocations[rank]->first.second, allocation.owner.c_str(), (unsigned long long)allocation.size, allocation.usage,
+      allocation.reallocationNb, (unsigned long long)allocation.frame);
+  }
+  fprintf(fp, "\n  ]\n}\n");
+
+  fclose(fp);
+  return true;
+}
@@ -1,181 +1,290 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "UxIndexBuffer.h"
-#include "UxError.h"
-
-#include <cassert>
-
-UxIndexBuffer::UxIndexBuffer()
-{
-  _Buffer                =  0;
-  _BufferSize            = -1;
-  _PrimitiveRestartIndex =  0;
-}
-
-UxIndexBuffer::~UxIndexBuffer()
-{
-  if (_Buffer)
-  {
-    glDeleteBuffers(1, &_Buffer);
-    _Buffer = 0;
-  }
-}
-
-void UxIndexBuffer::clearVector()
-{
-  _BufferSize = -1;
-  _IndexVector.clear();
-}
-
-void UxIndexBuffer::store(GLenum iUsage)
-{
-  assert(_BufferSize == -1);
-
-  if (_Buffer == 0)
-  {
-    glGenBuffers(1, &_Buffer);
-    __CheckGLErrors;
-  }
-
-  _BufferSize = _IndexVector.size(); 
-  assert(_BufferSize > -1);
-
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _Buffer);
-  __CheckGLErrors;
-
-  GLuint* pData = _IndexVector.data();  
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, _BufferSize*sizeof(pData[0]), (void*)pData, iUsage);
-  __CheckGLErrors;
-
-  _IndexVector.clear();
-}
-
-void UxIndexBuffer::bind() const
-{
-  assert(_BufferSize > -1);
-  
-  if (_PrimitiveRestartIndex)
-  {
-    glEnable(GL_PRIMITIVE_RESTART);
-    glPrimitiveRestartIndex(_PrimitiveRestartIndex);
-  }
-  else
-    glDisable(GL_PRIMITIVE_RESTART);
-
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _Buffer);
-}
-
-void UxIndexBuffer::unbind()
-{
-  glDisable(GL_PRIMITIVE_RESTART);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
-
-uint32_t UxIndexBuffer::getBufferSize() const
-{
-  assert(_BufferSize > -1);
-  return _BufferSize;
-}
-
-void UxIndexBuffer::addElement(int32_t iOffset, uint32_t iIndex)
-{
-  assert(_BufferSize == -1);
-  _IndexVector.push_back(iOffset+iIndex);
-}
-
-void UxIndexBuffer::addLinearRow(int32_t iOffset, uint32_t iLength)
-{
-  assert(_BufferSize == -1);
-  
-  uint32_t size = _IndexVector.size();
-  _IndexVector.reserve(size + iLength);
-
-  uint32_t indexNb = iOffset + iLength;
-  for (uint32_t index = iOffset; index < indexNb; index++)
-    _IndexVector.push_back(index);
-}
-
-void UxIndexBuffer::addLinearMatrix(int32_t iOffset, uint32_t iColNumber, uint32_t iRowNumber)
-{
-  assert(_BufferSize == -1);
-  
-  uint32_t size = _IndexVector.size();
-  uint32_t length = iColNumber*iRowNumber; 
-  _IndexVector.reserve(size + length);
-
-  uint32_t indexNb = iOffset + length; 
-  for (uint32_t index = iOffset; index < indexNb; index++)
-    _IndexVector.push_back(index);
-}
-
-void UxIndexBuffer::addPatchesFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber)
-{
-  assert(_BufferSize == -1);
-  
-  uint32_t size   = _IndexVector.size();
-  uint32_t length = (iColNumber-1)*(iRowNumber-1);
-  _IndexVector.reserve(size + 4 * length);
-
-  uint32_t pos   = iOffset;
-  uint32_t shift = iColumnMajorOrder ? iRowNumber : iColNumber;
-  for (uint32_t iX = 0; iX < iColNumber - 1; iX++)
-  {
-    for (uint32_t iY = 0; iY < iRowNumber - 1; iY++)
-    {
-      _IndexVector.push_back(pos);
-      _IndexVector.push_back(pos + shift);
-      _IndexVector.push_back(pos + shift + 1);
-      _IndexVector.push_back(pos + 1);
-      pos++;
-    }
-    pos++;
-  }
-}
-
-void UxIndexBuffer::addColumnLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex)
-{
-  addColumnLineStrips(iOffset, iColumnMajorOrder, iRowNumber, iColNumber, iRowNumber, iPrimitiveRestartIndex);
-}
-
-void UxIndexBuffer::addRowLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex)
-{
-  addColumnLineStrips(iOffset, !iColumnMajorOrder, iColNumber, iRowNumber, iColNumber, iPrimitiveRestartIndex);
-}
-
-void UxIndexBuffer::addColumnLineStrips(int32_t iOffset, bool iColumnMajorOrder, uint32_t iStrip, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex)
-{
-  assert(_BufferSize == -1 && (_PrimitiveRestartIndex == 0 || iPrimitiveRestartIndex == _PrimitiveRestartIndex));
-  
-  uint32_t size     = _IndexVector.size();
-  uint32_t strip    = iRowNumber;
-  uint32_t vertexNb = iColNumber*iRowNumber;
-  uint32_t length   = vertexNb + strip;
-
-  _IndexVector.reserve(size + length);
-
-  uint32_t base    = 0; 
-  uint32_t modulo  = 0;
-  uint32_t delta = iColNumber + iRowNumber - strip;
-  uint32_t indexNb = iOffset + vertexNb;
-  for (uint32_t index = iOffset; index < indexNb; index++)
-  {
-    if (iColumnMajorOrder)
-      _IndexVector.push_back(index);
-    else
-      _IndexVector.push_back(base + modulo*delta);
-    modulo++;
-    if (modulo == strip)
-    {
-      _IndexVector.push_back(iPrimitiveRestartIndex);
-      modulo = 0;
-      base++;
-    }
-  }
-
-  _PrimitiveRestartIndex = iPrimitiveRestartIndex;
-}
-
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxIndexBuffer.h"
+#include "UxStreamBuffer.h"
+#include "UxAllocationCounter.h"
+#include "UxGPUMemoryRegistry.h"
+#include "UxGLState.h"
+#include "UxError.h"
+
+#include <cassert>
+
+UxIndexBuffer::UxIndexBuffer()
+{
+  _Buffer                =  0;
+  _BufferSize            = -1;
+  _PrimitiveRestartIndex =  0;
+  _Type                  =  GL_UNSIGNED_INT;
+  _AllocatedSize         =  0;
+  _StreamBuffer          =  0;
+  _Offset                =  0;
+  _StreamData            =  nullptr;
+  _StreamCapacity        =  0;
+  _StreamIndexNb         =  0;
+}
+
+UxIndexBuffer::~UxIndexBuffer()
+{
+  UxGLState::deleteBuffer(_Buffer);
+}
+
+void UxIndexBuffer::clearVector()
+{
+  _BufferSize   = -1;
+  _StreamBuffer = 0;
+  _Offset       = 0;
+  _IndexVector.clear();
+}
+
+void UxIndexBuffer::store(GLenum iUsage)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::BufferStaging);
+  assert(_BufferSize == -1 && !_StreamData);
+
+  if (_Buffer == 0)
+  {
+    glCreateBuffers(1, &_Buffer);
+    __CheckGLErrors;
+  }
+
+  _BufferSize   = _IndexVector.size(); 
+  _StreamBuffer = 0;
+  _Offset       = 0;
+  assert(_BufferSize > -1);
+
+  // Type selected from the max index (restart indices excluded)
+  uint32_t maxIndex = 0;
+  for (auto index : _IndexVector)
+  {
+    if ((_PrimitiveRestartIndex == 0 || index != _PrimitiveRestartIndex) && index > maxIndex)
+      maxIndex = index;
+  }
+  _Type = selectType(maxIndex);
+
+  // Indices narrowed to the type, the restart index becoming the max value of the type
+  const void* pData = _IndexVector.data();
+  std::vector<uint8_t> narrowed;
+  if (_Type != GL_UNSIGNED_INT)
+  {
+    narrowed.resize(_BufferSize*getTypeSize(_Type));
+    GLuint restart = getRestartIndex(_Type);
+    for (int32_t rank = 0; rank < _BufferSize; rank++)
+    {
+      GLuint index = _IndexVector[rank];
+      if (_PrimitiveRestartIndex != 0 && index == _PrimitiveRestartIndex)
+        index = restart;
+      if (_Type == GL_UNSIGNED_SHORT)
+        reinterpret_cast<GLushort*>(narrowed.data())[rank] = (GLushort)index;
+      else
+        narrowed[rank] = (GLubyte)index;
+    }
+    pData = narrowed.data();
+  }
+  else if (_PrimitiveRestartIndex != 0 && _PrimitiveRestartIndex != getRestartIndex(_Type))
+  {
+    for (auto& index : _IndexVector)
+    {
+      if (index == _PrimitiveRestartIndex)
+        index = getRestartIndex(_Type);
+    }
+  }
+
+  // The storage is only reallocated if the content doesn't fit
+  GLsizeiptr size = _BufferSize*getTypeSize(_Type);
+  if (size > _AllocatedSize || size == 0)
+  {
+    glNamedBufferData(_Buffer, size, pData, iUsage);
+    _AllocatedSize = size;
+    UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Buffer, _Buffer, "UxIndexBuffer", size, iUsage);
+  }
+  else
+    glNamedBufferSubData(_Buffer, 0, size, pData);
+  __CheckGLErrors;
+
+  _IndexVector.clear();
+}
+
+void* UxIndexBuffer::beginStream(UxStreamBuffer& ioStream, uint32_t iMaxIndexNb, uint32_t iMaxIndex)
+{
+  assert(_BufferSize == -1 && _IndexVector.empty() && !_StreamData && iMaxIndexNb > 0);
+
+  _Type = selectType(iMaxIndex);
+  uint32_t typeSize = getTypeSize(_Type);
+
+  UxStreamBuffer::Allocation allocation = ioStream.allocate(iMaxIndexNb*typeSize, typeSize);
+  _StreamBuffer   = allocation.buffer;
+  _Offset         = allocation.offset;
+  _StreamData     = reinterpret_cast<uint8_t*>(allocation.data);
+  _StreamCapacity = iMaxIndexNb;
+  _StreamIndexNb  = 0;
+  return _StreamData;
+}
+
+void UxIndexBuffer::endStream(int32_t iIndexNb)
+{
+  assert(_StreamData && _IndexVector.empty() && (iIndexNb == -1 || (uint32_t)iIndexNb <= _StreamCapacity));
+
+  _BufferSize = iIndexNb == -1 ? _StreamIndexNb : iIndexNb;
+  _StreamData = nullptr;
+}
+
+void UxIndexBuffer::setPrimitiveRestart() const
+{
+  assert(_BufferSize > -1);
+  // Restart index being the max value of the type, no index state to set
+  UxGLState::setCapability(GL_PRIMITIVE_RESTART_FIXED_INDEX, _PrimitiveRestartIndex != 0);
+}
+
+GLenum UxIndexBuffer::selectType(uint32_t iMaxIndex)
+{
+  if (iMaxIndex < 0xFF)
+    return GL_UNSIGNED_BYTE;
+  if (iMaxIndex < 0xFFFF)
+    return GL_UNSIGNED_SHORT;
+  return GL_UNSIGNED_INT;
+}
+
+uint32_t UxIndexBuffer::getTypeSize(GLenum iType)
+{
+  switch (iType)
+  {
+    case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+    case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+    case GL_UNSIGNED_INT:   return sizeof(GLuint);
+  }
+
+  __Assert("Invalid index type");
+  return 0;
+}
+
+GLuint UxIndexBuffer::getRestartIndex(GLenum iType)
+{
+  switch (iType)
+  {
+    case GL_UNSIGNED_BYTE:  return 0xFF;
+    case GL_UNSIGNED_SHORT: return 0xFFFF;
+  }
+  return 0xFFFFFFFF;
+}
+
+uint32_t UxIndexBuffer::getBufferSize() const
+{
+  assert(_BufferSize > -1);
+  return _BufferSize;
+}
+
+void UxIndexBuffer::addElement(int32_t iOffset, uint32_t iIndex)
+{
+  assert(_BufferSize == -1);
+
+  if (_StreamData)
+  {
+    GLuint index = iOffset+iIndex;
+    assert(_StreamIndexNb < _StreamCapacity && index < getRestartIndex(_Type));
+    if (_Type == GL_UNSIGNED_INT)
+      reinterpret_cast<GLuint*>(_StreamData)[_StreamIndexNb++] = index;
+    else if (_Type == GL_UNSIGNED_SHORT)
+      reinterpret_cast<GLushort*>(_StreamData)[_StreamIndexNb++] = (GLushort)index;
+    else
+      _StreamData[_StreamIndexNb++] = (GLubyte)index;
+  }
+  else
+    _IndexVector.push_back(iOffset+iIndex);
+}
+
+void UxIndexBuffer::addLinearRow(int32_t iOffset, uint32_t iLength)
+{
+  assert(_BufferSize == -1);
+  
+  uint32_t size = _IndexVector.size();
+  _IndexVector.reserve(size + iLength);
+
+  uint32_t indexNb = iOffset + iLength;
+  for (uint32_t index = iOffset; index < indexNb; index++)
+    _IndexVector.push_back(index);
+}
+
+void UxIndexBuffer::addLinearMatrix(int32_t iOffset, uint32_t iColNumber, uint32_t iRowNumber)
+{
+  assert(_BufferSize == -1);
+  
+  uint32_t size = _IndexVector.size();
+  uint32_t length = iColNumber*iRowNumber; 
+  _IndexVector.reserve(size + length);
+
+  uint32_t indexNb = iOffset + length; 
+  for (uint32_t index = iOffset; index < indexNb; index++)
+    _IndexVector.push_back(index);
+}
+
+void UxIndexBuffer::addPatchesFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber)
+{
+  assert(_BufferSize == -1);
+  
+  uint32_t size   = _IndexVector.size();
+  uint32_t length = (iColNumber-1)*(iRowNumber-1);
+  _IndexVector.reserve(size + 4 * length);
+
+  uint32_t pos   = iOffset;
+  uint32_t shift = iColumnMajorOrder ? iRowNumber : iColNumber;
+  for (uint32_t iX = 0; iX < iColNumber - 1; iX++)
+  {
+    for (uint32_t iY = 0; iY < iRowNumber - 1; iY++)
+    {
+      _IndexVector.push_back(pos);
+      _IndexVector.push_back(pos + shift);
+      _IndexVector.push_back(pos + shift + 1);
+      _IndexVector.push_back(pos + 1);
+      pos++;
+    }
+    pos++;
+  }
+}
+
+void UxIndexBuffer::addColumnLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex)
+{
+  addColumnLineStrips(iOffset, iColumnMajorOrder, iRowNumber, iColNumber, iRowNumber, iPrimitiveRestartIndex);
+}
+
+void UxIndexBuffer::addRowLineStripsFromMatrix(int32_t iOffset, bool iColumnMajorOrder, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex)
+{
+  addColumnLineStrips(iOffset, !iColumnMajorOrder, iColNumber, iRowNumber, iColNumber, iPrimitiveRestartIndex);
+}
+
+void UxIndexBuffer::addColumnLineStrips(int32_t iOffset, bool iColumnMajorOrder, uint32_t iStrip, uint32_t iColNumber, uint32_t iRowNumber, GLuint iPrimitiveRestartIndex)
+{
+  assert(_BufferSize == -1 && (_PrimitiveRestartIndex == 0 || iPrimitiveRestartIndex == _PrimitiveRestartIndex));
+  
+  uint32_t size     = _IndexVector.size();
+  uint32_t strip    = iRowNumber;
+  uint32_t vertexNb = iColNumber*iRowNumber;
+  uint32_t length   = vertexNb + strip;
+
+  _IndexVector.reserve(size + length);
+
+  uint32_t base    = 0; 
+  uint32_t modulo  = 0;
+  uint32_t delta = iColNumber + iRowNumber - strip;
+  uint32_t indexNb = iOffset + vertexNb;
+  for (uint32_t index = iOffset; index < indexNb; index++)
+  {
+    if (iColumnMajorOrder)
+      _IndexVector.push_back(index);
+    else
+      _IndexVector.push_back(base + modulo*delta);
+    modulo++;
+    if (modulo == strip)
+    {
+      _IndexVector.push_back(iPrimitiveRestartIndex);
+      modulo = 0;
+      base++;
+    }
+  }
+
+  _PrimitiveRestartIndex = iPrimitiveRestartIndex;
+}
+
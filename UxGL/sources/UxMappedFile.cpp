@@ -0,0 +1,69 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxMappedFile.h"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+UxMappedFile::UxMappedFile()
+{
+  _File    = INVALID_HANDLE_VALUE;
+  _Mapping = nullptr;
+  _Data    = nullptr;
+  _Size    = 0;
+}
+
+UxMappedFile::~UxMappedFile()
+{
+  close();
+}
+
+bool UxMappedFile::open(const std::string& iPath)
+{
+  close();
+
+  _File = CreateFileA(iPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (_File == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(_File, &size) || size.QuadPart == 0)
+  {
+    close();
+    return false;
+  }
+
+  _Mapping = CreateFileMappingA(_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (_Mapping)
+    _Data = reinterpret_cast<const uint8_t*>(MapViewOfFile(_Mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!_Data)
+  {
+    close();
+    return false;
+  }
+
+  _Path = iPath;
+  _Size = size.QuadPart;
+  return true;
+}
+
+void UxMappedFile::close()
+{
+  if (_Data)
+    UnmapViewOfFile(_Data);
+  if (_Mapping)
+    CloseHandle(_Mapping);
+  if (_File != INVALID_HANDLE_VALUE)
+    CloseHandle(_File);
+
+  _File    = INVALID_HANDLE_VALUE;
+  _Mapping = nullptr;
+  _Data    = nullptr;
+  _Size    = 0;
+  _Path.clear();
+}
@@ -0,0 +1,59 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxProgramVariants.h"
+
+#include "UxProgram.h"
+#include "UxShader.h"
+
+UxProgramVariants::UxProgramVariants(const char* iName, const std::vector<ShaderFiles>& iShaders, Setup iSetup)
+{
+  _Name        = iName;
+  _Shaders     = iShaders;
+  _Setup       = iSetup;
+}
+
+UxProgramVariants::~UxProgramVariants()
+{
+  for (auto& variant : _Variants)
+    delete variant.second;
+  _Variants.clear();
+}
+
+UxProgram* UxProgramVariants::get(uint32_t iKey, const DefinesBuilder& iBuilder)
+{
+  auto it = _Variants.find(iKey);
+  if (it != _Variants.end())
+    return it->second;
+
+  std::vector<std::string> defines;
+  iBuilder(defines);
+  UxProgram* program = link(defines);
+  _Variants[iKey] = program;
+  return program;
+}
+
+UxProgram* UxProgramVariants::link(const std::vector<std::string>& iDefines)
+{
+  std::string key;
+  for (auto& define : iDefines)
+    key += (key.empty() ? "" : ",") + define;
+
+  // Compiles the shaders with the defines of the variant, links them and completes the program
+  std::vector<UxShader> shaders;
+  for (auto& shader : _Shaders)
+    shaders.emplace_back(shader.first, shader.second, iDefines);
+
+  std::string name = _Name + " [" + key + "]";
+  UxProgram* program = new UxProgram(name.c_str());
+  program->attachShaders(shaders, 0, shaders.size() - 1);
+
+  for (auto& shader : shaders)
+    glDeleteShader(shader.getGLName());
+
+  _Setup(program);
+  return program;
+}
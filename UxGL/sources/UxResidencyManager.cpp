@@ -0,0 +1,123 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxResidencyManager.h"
+
+#include "UxError.h"
+#include "UxUtils.h"
+
+#include <algorithm>
+
+std::map<GLuint64, UxResidencyManager::Entry>  UxResidencyManager::_Entries;
+uint64_t                                       UxResidencyManager::_Budget        = 0;
+uint64_t                                       UxResidencyManager::_Frame         = 1;
+uint64_t                                       UxResidencyManager::_FrameUsedSize = 0;
+UxResidencyManager::Statistics                 UxResidencyManager::_Statistics    = {};
+
+void UxResidencyManager::registerHandle(GLuint64 iHandle, GLuint iTextureName)
+{
+  __AssertIfNot(iHandle != 0 && _Entries.find(iHandle) == _Entries.end(), "Invalid or already registered texture handle");
+
+  Entry entry = {};
+  entry.size = UxUtils::getTextureSize(iTextureName);
+  _Entries[iHandle] = entry;
+
+  _Statistics.handleNb++;
+  _Statistics.registeredSize += entry.size;
+}
+
+void UxResidencyManager::unregisterHandle(GLuint64 iHandle)
+{
+  auto it = _Entries.find(iHandle);
+  if (it == _Entries.end())
+    return;
+
+  Entry& entry = it->second;
+  if (entry.isResident)
+  {
+    glMakeTextureHandleNonResidentARB(iHandle);
+    __CheckGLErrors;
+    _Statistics.residentHandleNb--;
+    _Statistics.residentSize -= entry.size;
+  }
+  _Statistics.handleNb--;
+  _Statistics.registeredSize -= entry.size;
+  _Entries.erase(it);
+}
+
+void UxResidencyManager::use(GLuint64 iHandle)
+{
+  auto it = _Entries.find(iHandle);
+  __AssertIfNot(it != _Entries.end(), "Texture handle used without being registered");
+
+  Entry& entry = it->second;
+  if (entry.lastUsedFrame != _Frame)
+  {
+    entry.lastUsedFrame = _Frame;
+    _FrameUsedSize += entry.size;
+  }
+  if (entry.isResident)
+    return;
+
+  makeRoom(entry.size);
+
+  glMakeTextureHandleResidentARB(iHandle);
+  __CheckGLErrors;
+  entry.isResident = true;
+  _Statistics.residentHandleNb++;
+  _Statistics.residentSize += entry.size;
+  _Statistics.peakResidentSize = std::max(_Statistics.peakResidentSize, _Statistics.residentSize);
+  _Statistics.residencyNb++;
+
+  // Evicted too early: needed again shortly after
+  if (entry.isEvicted && _Frame - entry.evictionFrame <= ThrashFrameNb)
+    _Statistics.thrashNb++;
+  entry.isEvicted = false;
+}
+
+void UxResidencyManager::endFrame()
+{
+  // Budget lowered or exceeded by the handles of the frame: room made for the next frame
+  makeRoom(0);
+
+  _Statistics.usedSize = _FrameUsedSize;
+  _FrameUsedSize = 0;
+  _Frame++;
+}
+
+void UxResidencyManager::makeRoom(uint64_t iSize)
+{
+  if (_Budget == 0)
+    return;
+
+  while (_Statistics.residentSize + iSize > _Budget)
+  {
+    // Least recently used resident handle not used by the frame (few handles: linear search)
+    auto lru = _Entries.end();
+    for (auto it = _Entries.begin(); it != _Entries.end(); ++it)
+    {
+      if (it->second.isResident && it->second.lastUsedFrame != _Frame && (lru == _Entries.end() || it->second.lastUsedFrame < lru->second.lastUsedFrame))
+        lru = it;
+    }
+    if (lru == _Entries.end())
+      return;
+
+    evict(lru->first, lru->second);
+  }
+}
+
+void UxResidencyManager::evict(GLuint64 iHandle, Entry& ioEntry)
+{
+  glMakeTextureHandleNonResidentARB(iHandle);
+  __CheckGLErrors;
+
+  ioEntry.isResident    = false;
+  ioEntry.isEvicted     = true;
+  ioEntry.evictionFrame = _Frame;
+  _Statistics.residentHandleNb--;
+  _Statistics.residentSize -= ioEntry.size;
+  _Statistics.evictionNb++;
+}
@@ -0,0 +1,163 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxStreamBuffer.h"
+#include "UxGLState.h"
+#include "UxGPUMemoryRegistry.h"
+#include "UxError.h"
+#include "UxAllocationCounter.h"
+
+#include <cassert>
+#include <algorithm>
+
+// Granularity of the ring capacity (multiple of any allocation alignment)
+static const GLsizeiptr CapacityGranularity = 256;
+
+UxStreamBuffer::UxStreamBuffer(const std::string& iName, GLsizeiptr iCapacity)
+{
+  _Name       = iName;
+  _Buffer     = 0;
+  _Capacity   = 0;
+  _MappedData = nullptr;
+  _WaitNb     = 0;
+  _FirstFence = 0;
+  _FenceNb    = 0;
+
+  create(iCapacity);
+}
+
+UxStreamBuffer::~UxStreamBuffer()
+{
+  destroy();
+}
+
+void UxStreamBuffer::create(GLsizeiptr iCapacity)
+{
+  assert(_Buffer == 0 && iCapacity > 0);
+
+  _Capacity = (iCapacity + CapacityGranularity - 1) / CapacityGranularity * CapacityGranularity;
+  _Head     = 0;
+  _Released = 0;
+  _Fenced   = 0;
+
+  // Immutable storage mapped once: coherent writes are visible to the next commands without flush nor barrier
+  GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  glCreateBuffers(1, &_Buffer);
+  __CheckGLErrors;
+  glNamedBufferStorage(_Buffer, _Capacity, nullptr, flags);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Buffer, _Buffer, "UxStreamBuffer " + _Name, _Capacity, 0);
+
+  _MappedData = reinterpret_cast<uint8_t*>(glMapNamedBufferRange(_Buffer, 0, _Capacity, flags));
+  __CheckGLErrors;
+  if (!_MappedData)
+  {
+    UxError::error(__FILE__, __LINE__) << "Can't map the stream buffer \"" << _Name << "\" (" << _Capacity << " bytes).\n";
+    UxError::exit(-1);
+  }
+}
+
+void UxStreamBuffer::destroy()
+{
+  while (_FenceNb > 0)
+    waitOldestFence();
+
+  if (_Buffer)
+  {
+    glUnmapNamedBuffer(_Buffer);
+    __CheckGLErrors;
+    UxGLState::deleteBuffer(_Buffer);
+  }
+  _MappedData = nullptr;
+}
+
+UxStreamBuffer::Allocation UxStreamBuffer::allocate(GLsizeiptr iSize, GLsizeiptr iAlignment)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::BufferStaging);
+  assert(iSize > 0 && iAlignment > 0 && iAlignment <= CapacityGranularity && (iAlignment & (iAlignment - 1)) == 0);
+
+  if (FrameInFlightNb * iSize > _Capacity)
+  {
+    // Ring replaced by a larger one (room for an allocation of this size per frame in flight, so that writing the
+    // frame never waits for the draws of the previous ones)
+    GLsizeiptr capacity = std::max(2 * _Capacity, (GLsizeiptr)FrameInFlightNb * iSize);
+    destroy();
+    create(capacity);
+  }
+
+  // Region kept contiguous: skips the end of the ring if the allocation doesn't hold
+  uint64_t start = (_Head + iAlignment - 1) & ~(uint64_t)(iAlignment - 1);
+  if (start % _Capacity + iSize > (uint64_t)_Capacity)
+    start = (start / _Capacity + 1) * _Capacity;
+
+  // Waits for the GPU to release the region (draws of the previous frames)
+  if (start + iSize > _Released + _Capacity)
+  {
+    _WaitNb++;
+    while (start + iSize > _Released + _Capacity)
+    {
+      if (_FenceNb == 0)
+      {
+        UxError::error(__FILE__, __LINE__) << "Stream buffer \"" << _Name << "\" (" << _Capacity << " bytes) too small for the data written between two fences.\n";
+        UxError::exit(-1);
+      }
+      waitOldestFence();
+    }
+  }
+
+  _Head = start + iSize;
+
+  Allocation allocation;
+  allocation.buffer = _Buffer;
+  allocation.offset = start % _Capacity;
+  allocation.data   = _MappedData + allocation.offset;
+  allocation.size   = iSize;
+  return allocation;
+}
+
+void UxStreamBuffer::fence()
+{
+  if (_Head == _Fenced)
+    return;
+
+  // Oldest fence waited for if all the slots are pending (more frames in flight than the driver queues)
+  if (_FenceNb == MaxFenceNb)
+    waitOldestFence();
+
+  Fence& fence = _Fences[(_FirstFence + _FenceNb) % MaxFenceNb];
+  fence.sync     = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  __CheckGLErrors;
+  fence.position = _Head;
+  _FenceNb++;
+  _Fenced = _Head;
+}
+
+void UxStreamBuffer::waitOldestFence()
+{
+  assert(_FenceNb > 0);
+
+  Fence& fence = _Fences[_FirstFence];
+
+  // Commands flushed at first wait (the fence might not be sent yet)
+  GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+  GLenum status = GL_TIMEOUT_EXPIRED;
+  while (status == GL_TIMEOUT_EXPIRED)
+  {
+    status = glClientWaitSync(fence.sync, flags, 1000000000);
+    flags = 0;
+  }
+
+  if (status == GL_WAIT_FAILED)
+  {
+    UxError::error(__FILE__, __LINE__) << "Wait on a fence of the stream buffer \"" << _Name << "\" failed.\n";
+    UxError::exit(-1);
+  }
+
+  glDeleteSync(fence.sync);
+  _Released   = fence.position;
+  _FirstFence = (_FirstFence + 1) % MaxFenceNb;
+  _FenceNb--;
+}
@@ -0,0 +1,133 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+UxThreadPool::UxThreadPool(uint32_t iThreadNb)
+{
+  _Stopping = false;
+
+  uint32_t threadNb = iThreadNb;
+  if (threadNb == 0)
+    threadNb = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+  for (uint32_t rank = 0; rank < threadNb; rank++)
+    _Threads.emplace_back(&UxThreadPool::run, this);
+}
+
+UxThreadPool::~UxThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Stopping = true;
+  }
+  _Condition.notify_all();
+
+  for (auto& thread : _Threads)
+    thread.join();
+}
+
+std::future<void> UxThreadPool::submit(std::function<void()> iTask)
+{
+  std::packaged_task<void()> task(std::move(iTask));
+  std::future<void> future = task.get_future();
+  {
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Tasks.push_back(std::move(task));
+  }
+  _Condition.notify_one();
+  return future;
+}
+
+void UxThreadPool::parallelFor(uint32_t iBegin, uint32_t iEnd, const std::function<void(uint32_t)>& iFunction)
+{
+  uint32_t indexNb = iEnd > iBegin ? iEnd - iBegin : 0;
+  if (indexNb <= 1 || _Threads.empty())
+  {
+    for (uint32_t index = iBegin; index < iEnd; index++)
+      iFunction(index);
+    return;
+  }
+
+  // Chunks claimed in order by the helpers and the caller (several per thread for balance)
+  struct Loop
+  {
+    std::atomic<uint32_t>                      nextChunk;
+    uint32_t                                   chunkNb;
+    uint32_t                                   chunkSize;
+    uint32_t                                   begin;
+    uint32_t                                   end;
+    const std::function<void(uint32_t)>*       function;
+    std::mutex                                 mutex;
+    std::condition_variable                    condition;
+    uint32_t                                   doneChunkNb;
+  };
+
+  uint32_t chunkNb = std::min(indexNb, 4 * ((uint32_t)_Threads.size() + 1));
+  std::shared_ptr<Loop> loop = std::make_shared<Loop>();
+  loop->nextChunk   = 0;
+  loop->chunkSize   = (indexNb + chunkNb - 1) / chunkNb;
+  loop->chunkNb     = (indexNb + loop->chunkSize - 1) / loop->chunkSize;
+  loop->begin       = iBegin;
+  loop->end         = iEnd;
+  loop->function    = &iFunction;
+  loop->doneChunkNb = 0;
+
+  // Runs chunks until none is left: the function is only reached through a claimed chunk, the caller waiting for all of
+  // them (late helpers find no chunk and return)
+  auto runChunks = [](Loop& ioLoop)
+  {
+    for (uint32_t chunk = ioLoop.nextChunk++; chunk < ioLoop.chunkNb; chunk = ioLoop.nextChunk++)
+    {
+      uint32_t start = ioLoop.begin + chunk * ioLoop.chunkSize;
+      uint32_t end   = std::min(start + ioLoop.chunkSize, ioLoop.end);
+      for (uint32_t index = start; index < end; index++)
+        (*ioLoop.function)(index);
+
+      std::lock_guard<std::mutex> lock(ioLoop.mutex);
+      if (++ioLoop.doneChunkNb == ioLoop.chunkNb)
+        ioLoop.condition.notify_all();
+    }
+  };
+
+  uint32_t helperNb = std::min((uint32_t)_Threads.size(), loop->chunkNb - 1);
+  for (uint32_t helper = 0; helper < helperNb; helper++)
+    submit([loop, runChunks]() { runChunks(*loop); });
+
+  runChunks(*loop);
+
+  std::unique_lock<std::mutex> lock(loop->mutex);
+  loop->condition.wait(lock, [&loop]() { return loop->doneChunkNb == loop->chunkNb; });
+}
+
+UxThreadPool& UxThreadPool::getShared()
+{
+  static UxThreadPool* pool = new UxThreadPool();
+  return *pool;
+}
+
+void UxThreadPool::run()
+{
+  for (;;)
+  {
+    std::packaged_task<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(_Mutex);
+      _Condition.wait(lock, [this]() { return _Stopping || !_Tasks.empty(); });
+
+      // Pending tasks completed before stopping
+      if (_Tasks.empty())
+        return;
+      task = std::move(_Tasks.front());
+      _Tasks.pop_front();
+    }
+    task();
+  }
+}
@@ -0,0 +1,58 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxTransformFeedback.h"
+#include "UxVertexArrayBase.h"
+
+#include "UxError.h"
+
+#include <cassert>
+
+UxTransformFeedback::UxTransformFeedback()
+{
+  _Feedback   = 0;
+  _IsActive   = false;
+  _IsCaptured = false;
+
+  glCreateTransformFeedbacks(1, &_Feedback);
+  __CheckGLErrors;
+}
+
+UxTransformFeedback::~UxTransformFeedback()
+{
+  assert(!_IsActive);
+  glDeleteTransformFeedbacks(1, &_Feedback);
+  _Feedback = 0;
+}
+
+void UxTransformFeedback::attach(const UxVertexArrayBase& iCaptureArray)
+{
+  assert(_Feedback && !_IsActive);
+  glTransformFeedbackBufferBase(_Feedback, 0, iCaptureArray.getBuffer());
+  __CheckGLErrors;
+  _IsCaptured = false;
+}
+
+void UxTransformFeedback::begin(GLenum iPrimitiveMode)
+{
+  assert(_Feedback && !_IsActive);
+  glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, _Feedback);
+  __CheckGLErrors;
+  glBeginTransformFeedback(iPrimitiveMode);
+  __CheckGLErrors;
+  _IsActive = true;
+}
+
+void UxTransformFeedback::end()
+{
+  assert(_Feedback && _IsActive);
+  glEndTransformFeedback();
+  __CheckGLErrors;
+  glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+  __CheckGLErrors;
+  _IsActive   = false;
+  _IsCaptured = true;
+}
@@ -1,83 +1,97 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "UxUniformBlockBase.h"
-#include "UxProgram.h"
-#include "UxError.h"
-
-#include <cassert>
-
-
-UxUniformBlockBase::UxUniformBlockBase(const std::string& iName, GLenum iUsage, int32_t iBinding, const std::string& iStructureName, size_t iBufferSize)
-{
-  _Name          = iName;
-  _Buffer        = 0;
-  _Binding       = allocator::allocate(this, _Name, iBinding);
-  _StructureName = iStructureName;
-  _BufferSize    = iBufferSize;
-  _IsMapped      = false;
-
-  glGenBuffers(1, &_Buffer);
-  __CheckGLErrors;
-  glBindBuffer(GL_UNIFORM_BUFFER, _Buffer);
-  __CheckGLErrors;
-
-  glBufferData(GL_UNIFORM_BUFFER, _BufferSize, nullptr, iUsage);
-  __CheckGLErrors;
-  glBindBufferRange(GL_UNIFORM_BUFFER, _Buffer, _Binding, 0, _BufferSize);
-  __CheckGLErrors;
-}
-
-UxUniformBlockBase::~UxUniformBlockBase()
-{
-  glDeleteBuffers(1, &_Buffer);
-  _Buffer = 0;
-}
-
-void UxUniformBlockBase::map()
-{
-  assert(_Buffer && !_IsMapped);
-  glBindBufferBase(GL_UNIFORM_BUFFER, _Binding, _Buffer);
-  __CheckGLErrors;
-  _IsMapped = true;
-}
-
-void UxUniformBlockBase::unmap()
-{
-  assert(_Buffer && _IsMapped);
-  glBindBufferBase(GL_UNIFORM_BUFFER, _Binding, _Buffer);
-  __CheckGLErrors;
-  glUnmapBuffer(GL_UNIFORM_BUFFER);
-  __CheckGLErrors;
-  _IsMapped = false;
-}
-
-void UxUniformBlockBase::bindToProgram(const UxProgram* iProgram, const std::string& iUniformName)
-{
-  // "layout(std140) uniform xxxBlock" with xxx as uniform name
-  std::string blockName = iUniformName + "Block";
-
-  GLuint unifBlockIndex = glGetUniformBlockIndex(iProgram->id(), blockName.c_str());
-  
-  if (unifBlockIndex == -1)
-  {
-    UxError::error(__FILE__, __LINE__) << "Undefined Uniform Block \"" << blockName.c_str() << "\" in program \"" << iProgram->getName() << ".\n";
-    UxError::UxError::exit(-1);
-  }
-
-  // Verifies that the buffer size identical to the block uniform's size
-  GLint size;
-  glGetActiveUniformBlockiv(iProgram->id(), unifBlockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
-  if (_BufferSize != size)
-  {
-    UxError::error(__FILE__,__LINE__) << "Inconsistent definition between structure associated to the UBO \"" << _StructureName << "\" (size=" << _BufferSize
-      << ") and the Uniform Block \"" << blockName.c_str() << "\" in program \"" << iProgram->getName() << "\" (size=" << size << ").\n";
-    UxError::UxError::exit(-1);
-  }
-
-  glUniformBlockBinding(iProgram->id(), unifBlockIndex, _Binding);
-  __CheckGLErrors;
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxUniformBlockBase.h"
+#include "UxProgram.h"
+#include "UxGLState.h"
+#include "UxGPUMemoryRegistry.h"
+#include "UxError.h"
+
+#include <cassert>
+#include <cstring>
+
+
+UxUniformBlockBase::UxUniformBlockBase(const std::string& iName, GLenum iUsage, int32_t iBinding, const std::string& iStructureName, size_t iBufferSize)
+{
+  _Name          = iName;
+  _Buffer        = 0;
+  _Binding       = allocator::allocate(this, _Name, iBinding);
+  _StructureName = iStructureName;
+  _BufferSize    = iBufferSize;
+  _IsMapped      = false;
+  _Revision      = 0;
+  _Content.assign(_BufferSize, 0);
+  _Staging.assign(_BufferSize, 0);
+
+  // Buffer bound once to its binding point, its content being updated without binding
+  glCreateBuffers(1, &_Buffer);
+  __CheckGLErrors;
+
+  glNamedBufferData(_Buffer, _BufferSize, nullptr, iUsage);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Buffer, _Buffer, "UxUniformBlock " + _Name, _BufferSize, iUsage);
+  glBindBufferBase(GL_UNIFORM_BUFFER, _Binding, _Buffer);
+  __CheckGLErrors;
+}
+
+UxUniformBlockBase::~UxUniformBlockBase()
+{
+  UxGLState::deleteBuffer(_Buffer);
+}
+
+void* UxUniformBlockBase::map()
+{
+  assert(_Buffer && !_IsMapped);
+
+  // The accessor works on a copy of the current content: no synchronisation with the GPU is needed
+  // and unmodified blocks are not sent again (their revision is kept)
+  _Staging  = _Content;
+  _IsMapped = true;
+  return _Staging.data();
+}
+
+void UxUniformBlockBase::unmap()
+{
+  assert(_Buffer && _IsMapped);
+
+  if (_Revision == 0 || memcmp(_Staging.data(), _Content.data(), _BufferSize) != 0)
+  {
+    glNamedBufferSubData(_Buffer, 0, _BufferSize, _Staging.data());
+    __CheckGLErrors;
+
+    _Content.swap(_Staging);
+    _Revision++;
+  }
+
+  _IsMapped = false;
+}
+
+void UxUniformBlockBase::bindToProgram(const UxProgram* iProgram, const std::string& iUniformName)
+{
+  // "layout(std140) uniform xxxBlock" with xxx as uniform name
+  std::string blockName = iUniformName + "Block";
+
+  GLuint unifBlockIndex = glGetUniformBlockIndex(iProgram->id(), blockName.c_str());
+  
+  if (unifBlockIndex == -1)
+  {
+    UxError::error(__FILE__, __LINE__) << "Undefined Uniform Block \"" << blockName.c_str() << "\" in program \"" << iProgram->getName() << ".\n";
+    UxError::UxError::exit(-1);
+  }
+
+  // Verifies that the buffer size identical to the block uniform's size
+  GLint size;
+  glGetActiveUniformBlockiv(iProgram->id(), unifBlockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+  if (_BufferSize != size)
+  {
+    UxError::error(__FILE__,__LINE__) << "Inconsistent definition between structure associated to the UBO \"" << _StructureName << "\" (size=" << _BufferSize
+      << ") and the Uniform Block \"" << blockName.c_str() << "\" in program \"" << iProgram->getName() << "\" (size=" << size << ").\n";
+    UxError::UxError::exit(-1);
+  }
+
+  glUniformBlockBinding(iProgram->id(), unifBlockIndex, _Binding);
+  __CheckGLErrors;
+}
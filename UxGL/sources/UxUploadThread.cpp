@@ -0,0 +1,153 @@
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxUploadThread.h"
+#include "UxError.h"
+
+#include <cassert>
+
+std::thread*                     UxUploadThread::_Thread   = nullptr;
+std::deque<UxUploadThread::Job>  UxUploadThread::_Jobs;
+std::mutex                       UxUploadThread::_Mutex;
+std::condition_variable          UxUploadThread::_Condition;
+bool                             UxUploadThread::_Stopping = false;
+
+UxUploadTicket::UxUploadTicket()
+{
+  _Fence      = nullptr;
+  _IsComplete = false;
+}
+
+UxUploadTicket::~UxUploadTicket()
+{
+  GLsync fence = _Fence;
+  if (fence)
+    glDeleteSync(fence);
+}
+
+bool UxUploadTicket::isComplete()
+{
+  if (_IsComplete)
+    return true;
+
+  GLsync fence = _Fence;
+  if (!fence)
+    return false;
+
+  GLenum status = glClientWaitSync(fence, 0, 0);
+  if (status == GL_WAIT_FAILED)
+  {
+    UxError::error(__FILE__, __LINE__) << "Wait on the fence of an upload job failed.\n";
+    UxError::exit(-1);
+  }
+
+  _IsComplete = (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED);
+  if (_IsComplete)
+  {
+    glDeleteSync(fence);
+    _Fence = nullptr;
+  }
+  return _IsComplete;
+}
+
+void UxUploadTicket::wait()
+{
+  // Job run by the upload thread first, then executed by the GPU
+  while (!_Fence && !_IsComplete)
+    std::this_thread::yield();
+
+  while (!isComplete())
+    std::this_thread::yield();
+}
+
+void UxUploadThread::start(const std::function<void(bool)>& iBindContext)
+{
+  assert(!_Thread);
+
+  _Stopping = false;
+  _Thread   = new std::thread([iBindContext]()
+  {
+    iBindContext(true);
+    for (;;)
+    {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(_Mutex);
+        _Condition.wait(lock, []() { return _Stopping || !_Jobs.empty(); });
+
+        // Pending jobs completed before stopping
+        if (_Jobs.empty())
+          break;
+        job = std::move(_Jobs.front());
+        _Jobs.pop_front();
+      }
+
+      job.job();
+      if (job.ticket)
+        signal(*job.ticket);
+    }
+    iBindContext(false);
+  });
+}
+
+void UxUploadThread::stop()
+{
+  if (!_Thread)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Stopping = true;
+  }
+  _Condition.notify_one();
+
+  _Thread->join();
+  delete _Thread;
+  _Thread = nullptr;
+}
+
+void UxUploadThread::signal(UxUploadTicket& ioTicket)
+{
+  GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  __CheckGLErrors;
+  glFlush();
+  ioTicket._Fence = fence;
+}
+
+bool UxUploadThread::isStarted()
+{
+  return _Thread != nullptr;
+}
+
+std::shared_ptr<UxUploadTicket> UxUploadThread::submit(const std::function<void()>& iJob)
+{
+  auto spTicket = std::make_shared<UxUploadTicket>();
+
+  if (!_Thread)
+  {
+    iJob();
+    signal(*spTicket);
+    return spTicket;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Jobs.push_back({ iJob, spTicket });
+  }
+  _Condition.notify_one();
+  return spTicket;
+}
+
+void UxUploadThread::post(const std::function<void()>& iJob)
+{
+  assert(_Thread);
+
+  {
+    std::lock_guard<std::mutex> lock(_Mutex);
+    _Jobs.push_back({ iJob, nullptr });
+  }
+  _Condition.notify_one();
+}
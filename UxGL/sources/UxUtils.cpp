@@ -1,151 +1,919 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "UxUtils.h"
-
-#include "UxError.h"
-
-#include <regex>
-#include <cassert>
-#include <IL/il.h>
-//#include <IL/ilut.h>
-
-Matrix3f UxUtils::cofactor(Matrix3f m)
-{
-  Matrix3f result;
-
-  result.at(0, 0) = m.at(1, 1) * m.at(2, 2) - m.at(2, 1) * m.at(1, 2);
-  result.at(0, 1) = m.at(2, 1) * m.at(0, 2) - m.at(0, 1) * m.at(2, 2);
-  result.at(0, 2) = m.at(0, 1) * m.at(1, 2) - m.at(1, 1) * m.at(0, 2);
-  result.at(1, 0) = m.at(2, 0) * m.at(1, 2) - m.at(1, 0) * m.at(2, 2);
-  result.at(1, 1) = m.at(0, 0) * m.at(2, 2) - m.at(2, 0) * m.at(0, 2);
-  result.at(1, 2) = m.at(1, 0) * m.at(0, 2) - m.at(0, 0) * m.at(1, 2);
-  result.at(2, 0) = m.at(1, 0) * m.at(2, 1) - m.at(2, 0) * m.at(1, 1);
-  result.at(2, 1) = m.at(2, 0) * m.at(0, 1) - m.at(0, 0) * m.at(2, 1);
-  result.at(2, 2) = m.at(0, 0) * m.at(1, 1) - m.at(1, 0) * m.at(0, 1);
-  return result;
-}
-
-Matrix4f UxUtils::cofactor(Matrix4f m)
-{
-  Matrix4f result;
-
-  result.at(0, 0) = m.at(1, 1) * m.at(2, 2) - m.at(2, 1) * m.at(1, 2);
-  result.at(0, 1) = m.at(2, 1) * m.at(0, 2) - m.at(0, 1) * m.at(2, 2);
-  result.at(0, 2) = m.at(0, 1) * m.at(1, 2) - m.at(1, 1) * m.at(0, 2);
-  result.at(1, 0) = m.at(2, 0) * m.at(1, 2) - m.at(1, 0) * m.at(2, 2);
-  result.at(1, 1) = m.at(0, 0) * m.at(2, 2) - m.at(2, 0) * m.at(0, 2);
-  result.at(1, 2) = m.at(1, 0) * m.at(0, 2) - m.at(0, 0) * m.at(1, 2);
-  result.at(2, 0) = m.at(1, 0) * m.at(2, 1) - m.at(2, 0) * m.at(1, 1);
-  result.at(2, 1) = m.at(2, 0) * m.at(0, 1) - m.at(0, 0) * m.at(2, 1);
-  result.at(2, 2) = m.at(0, 0) * m.at(1, 1) - m.at(1, 0) * m.at(0, 1);
-  result.at(0, 3) = m.at(0, 3);
-  result.at(1, 3) = m.at(1, 3); 
-  result.at(2, 3) = m.at(2, 3); 
-  result.at(3, 0) = m.at(3, 0);
-  result.at(3, 1) = m.at(3, 1);
-  result.at(3, 2) = m.at(3, 2);
-  result.at(3, 3) = 1.f;
-  return result;
-}
-
-
-Vector3f UxUtils::rotatePoint(const Vector3f& iPointToRotate, const Vector3f& iPointOnAxis, const Vector3f& iAxisDirection, float iRadAngle)
-{
-  Vector3f dir = iAxisDirection;
-  dir.normalize();
-  // Vector from pointOnAxis to pointToRotate (link)
-  Vector3f l = iPointToRotate - iPointOnAxis;
-  // Vector from pointOnAxis to the projection of pointToRotate onto the axis (projection)
-  Vector3f s = dir * l.dotProduct(dir);
-  // Vector from the projection of pointToRotate onto the axis to the pointToRotate (distance)
-  Vector3f d = l - s;
-  return iPointOnAxis + s + d*cos(iRadAngle) + dir.crossProduct(d)*sin(iRadAngle);
-}
-
-Vector3f UxUtils::rotateVector(const Vector3f& iVectorToRotate, const Vector3f& iAxisDirection, float iRadAngle)
-{
-  Vector3f dir = iAxisDirection;
-  dir.normalize();
-  // Vector from pointOnAxis to the projection of pointToRotate onto the axis (projection)
-  Vector3f s = dir * iVectorToRotate.dotProduct(dir);
-  // Vector from the projection of pointToRotate onto the axis to the pointToRotate (distance)
-  Vector3f d = iVectorToRotate - s;
-  return s + d*cos(iRadAngle) + dir.crossProduct(d)*sin(iRadAngle);
-}
-
-void UxUtils::createBindlessTexture(const std::string& iFilePath, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident)
-{
-  ILubyte *buffer       = nullptr;
-  ILuint   bufferLength = 0;
-  FILE*    fp           = nullptr;
-
-  /*assert(!fopen_s(&fp, filePath, "rb"));
-
-  fseek(fp, 0, SEEK_END);
-  bufferLength = ftell(fp);
-
-  buffer = (ILubyte*)malloc(bufferLength);
-  fseek(fp, 0, SEEK_SET);
-  fread(buffer, 1, bufferLength, fp);
-  fclose(fp);
-
-  ilLoadL(IL_PNG, buffer, bufferLength);
-  free(buffer);
-  buffer = nullptr;
-  */
-
-  ilLoadImage((const wchar_t*)iFilePath.c_str());
-
-  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-  __CheckGLErrors;
-
-  glGenTextures(1, &oTextureName);
-  glBindTexture(GL_TEXTURE_2D, oTextureName);
-  
-  uint32_t width  = ilGetInteger(IL_IMAGE_WIDTH);
-  uint32_t height = ilGetInteger(IL_IMAGE_HEIGHT);
-  uint32_t fmt    = ilGetInteger(IL_IMAGE_FORMAT);
-  uint32_t type   = ilGetInteger(IL_IMAGE_TYPE);
-  ILubyte* data   = ilGetData();
-
-  //glTexStorage2D(GL_TEXTURE_2D, 1, GL_R16, width, height);
-  //glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, fmt, type, data);
-  glTexImage2D(GL_TEXTURE_2D, 0, fmt, width, height, 0, fmt, type, data);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); 
-  __CheckGLErrors;
-
-  oTextureHandle = glGetTextureHandleARB(oTextureName);
-  __CheckGLErrors;
-  if (iMakeResident)
-  {
-    glMakeTextureHandleResidentARB(oTextureHandle);
-    __CheckGLErrors;
-  }
-}
-
-
-std::string UxUtils::GLSLTypeToCPlusPlus(const char* iDeclaration)
-{
-  static const char *table[][2] = { {"Vector([234])f", "vec$1"}, { "Vector([234])([diu])", "$2vec$1" }, { "Matrix([34])f", "mat$1"}, { "Matrix([34])d", "dmat$1" }, { "uint32_t", "uint" }, { "int32_t", "int" } };
-
-  for (auto couple : table)
-  {
-    if (std::regex_search(iDeclaration, std::regex(couple[0])))
-      return std::regex_replace(iDeclaration, std::regex(couple[0]), couple[1]);
-  }
-
-  return iDeclaration;
-}
-
-
-bool UxUtils::deviation(float iRefValue, float iComputedValue, float iRatio)
-{
-  return fabs(iComputedValue - iRefValue) < iRatio;
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxUtils.h"
+
+#include "UxError.h"
+#include "UxResidencyManager.h"
+#include "UxGPUMemoryRegistry.h"
+#include "UxThreadPool.h"
+
+#include <regex>
+#include <cassert>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+#include <IL/il.h>
+//#include <IL/ilut.h>
+#include <png.h>
+#include <tiffio.h>
+
+Matrix3f UxUtils::cofactor(Matrix3f m)
+{
+  Matrix3f result;
+
+  result.at(0, 0) = m.at(1, 1) * m.at(2, 2) - m.at(2, 1) * m.at(1, 2);
+  result.at(0, 1) = m.at(2, 1) * m.at(0, 2) - m.at(0, 1) * m.at(2, 2);
+  result.at(0, 2) = m.at(0, 1) * m.at(1, 2) - m.at(1, 1) * m.at(0, 2);
+  result.at(1, 0) = m.at(2, 0) * m.at(1, 2) - m.at(1, 0) * m.at(2, 2);
+  result.at(1, 1) = m.at(0, 0) * m.at(2, 2) - m.at(2, 0) * m.at(0, 2);
+  result.at(1, 2) = m.at(1, 0) * m.at(0, 2) - m.at(0, 0) * m.at(1, 2);
+  result.at(2, 0) = m.at(1, 0) * m.at(2, 1) - m.at(2, 0) * m.at(1, 1);
+  result.at(2, 1) = m.at(2, 0) * m.at(0, 1) - m.at(0, 0) * m.at(2, 1);
+  result.at(2, 2) = m.at(0, 0) * m.at(1, 1) - m.at(1, 0) * m.at(0, 1);
+  return result;
+}
+
+Matrix4f UxUtils::cofactor(Matrix4f m)
+{
+  Matrix4f result;
+
+  result.at(0, 0) = m.at(1, 1) * m.at(2, 2) - m.at(2, 1) * m.at(1, 2);
+  result.at(0, 1) = m.at(2, 1) * m.at(0, 2) - m.at(0, 1) * m.at(2, 2);
+  result.at(0, 2) = m.at(0, 1) * m.at(1, 2) - m.at(1, 1) * m.at(0, 2);
+  result.at(1, 0) = m.at(2, 0) * m.at(1, 2) - m.at(1, 0) * m.at(2, 2);
+  result.at(1, 1) = m.at(0, 0) * m.at(2, 2) - m.at(2, 0) * m.at(0, 2);
+  result.at(1, 2) = m.at(1, 0) * m.at(0, 2) - m.at(0, 0) * m.at(1, 2);
+  result.at(2, 0) = m.at(1, 0) * m.at(2, 1) - m.at(2, 0) * m.at(1, 1);
+  result.at(2, 1) = m.at(2, 0) * m.at(0, 1) - m.at(0, 0) * m.at(2, 1);
+  result.at(2, 2) = m.at(0, 0) * m.at(1, 1) - m.at(1, 0) * m.at(0, 1);
+  result.at(0, 3) = m.at(0, 3);
+  result.at(1, 3) = m.at(1, 3); 
+  result.at(2, 3) = m.at(2, 3); 
+  result.at(3, 0) = m.at(3, 0);
+  result.at(3, 1) = m.at(3, 1);
+  result.at(3, 2) = m.at(3, 2);
+  result.at(3, 3) = 1.f;
+  return result;
+}
+
+
+Vector3f UxUtils::rotatePoint(const Vector3f& iPointToRotate, const Vector3f& iPointOnAxis, const Vector3f& iAxisDirection, float iRadAngle)
+{
+  Vector3f dir = iAxisDirection;
+  dir.normalize();
+  // Vector from pointOnAxis to pointToRotate (link)
+  Vector3f l = iPointToRotate - iPointOnAxis;
+  // Vector from pointOnAxis to the projection of pointToRotate onto the axis (projection)
+  Vector3f s = dir * l.dotProduct(dir);
+  // Vector from the projection of pointToRotate onto the axis to the pointToRotate (distance)
+  Vector3f d = l - s;
+  return iPointOnAxis + s + d*cos(iRadAngle) + dir.crossProduct(d)*sin(iRadAngle);
+}
+
+Vector3f UxUtils::rotateVector(const Vector3f& iVectorToRotate, const Vector3f& iAxisDirection, float iRadAngle)
+{
+  Vector3f dir = iAxisDirection;
+  dir.normalize();
+  // Vector from pointOnAxis to the projection of pointToRotate onto the axis (projection)
+  Vector3f s = dir * iVectorToRotate.dotProduct(dir);
+  // Vector from the projection of pointToRotate onto the axis to the pointToRotate (distance)
+  Vector3f d = iVectorToRotate - s;
+  return s + d*cos(iRadAngle) + dir.crossProduct(d)*sin(iRadAngle);
+}
+
+// DevIL decodes into a global bound image: decodings serialized
+static std::mutex gDecoderMutex;
+
+void UxUtils::createBindlessTexture(const std::string& iFilePath, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident, bool iMipmaps)
+{
+  Image image;
+  decodeImage(iFilePath, image);
+  createTexture(image, oTextureName, oTextureHandle, iMakeResident, iMipmaps);
+}
+
+void UxUtils::decodeImage(const std::string& iFilePath, Image& oImage)
+{
+  std::lock_guard<std::mutex> lock(gDecoderMutex);
+
+  ILubyte *buffer       = nullptr;
+  ILuint   bufferLength = 0;
+  FILE*    fp           = nullptr;
+
+  /*assert(!fopen_s(&fp, filePath, "rb"));
+
+  fseek(fp, 0, SEEK_END);
+  bufferLength = ftell(fp);
+
+  buffer = (ILubyte*)malloc(bufferLength);
+  fseek(fp, 0, SEEK_SET);
+  fread(buffer, 1, bufferLength, fp);
+  fclose(fp);
+
+  ilLoadL(IL_PNG, buffer, bufferLength);
+  free(buffer);
+  buffer = nullptr;
+  */
+
+  if (!ilLoadImage((const wchar_t*)iFilePath.c_str()))
+  {
+    UxError::error(__FILE__, __LINE__) << " Can't load the image " << iFilePath << ".\n";
+    UxError::exit(-1);
+  }
+
+  oImage.width       = ilGetInteger(IL_IMAGE_WIDTH);
+  oImage.height      = ilGetInteger(IL_IMAGE_HEIGHT);
+  oImage.format      = ilGetInteger(IL_IMAGE_FORMAT);
+  oImage.type        = ilGetInteger(IL_IMAGE_TYPE);
+  oImage.componentNb = ilGetInteger(IL_IMAGE_CHANNELS);
+
+  // Luminance stored as red, read back as luminance through the swizzle
+  oImage.isLuminance = (oImage.format == IL_LUMINANCE || oImage.format == IL_LUMINANCE_ALPHA);
+  if (oImage.isLuminance)
+    oImage.format = (oImage.format == IL_LUMINANCE ? GL_RED : GL_RG);
+
+  const ILubyte* data = ilGetData();
+  oImage.data.assign(data, data + ilGetInteger(IL_IMAGE_SIZE_OF_DATA));
+}
+
+void UxUtils::createTexture(const Image& iImage, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident, bool iMipmaps)
+{
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  __CheckGLErrors;
+
+  GLsizei levelNb = 1;
+  if (iMipmaps)
+  {
+    while ((std::max(iImage.width, iImage.height) >> levelNb) > 0)
+      levelNb++;
+  }
+
+  // Immutable storage (direct state access)
+  glCreateTextures(GL_TEXTURE_2D, 1, &oTextureName);
+  __CheckGLErrors;
+  glTextureStorage2D(oTextureName, levelNb, getSizedFormat(iImage.componentNb, iImage.type), iImage.width, iImage.height);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Texture, oTextureName, "UxUtils texture", getTextureSize(oTextureName), getSizedFormat(iImage.componentNb, iImage.type));
+  uploadTextureRows(oTextureName, 0, 0, iImage.width, iImage.height, iImage.format, iImage.type, iImage.data.data(), iImage.data.size());
+  glTextureParameteri(oTextureName, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTextureParameteri(oTextureName, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTextureParameteri(oTextureName, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTextureParameteri(oTextureName, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  if (iImage.isLuminance)
+  {
+    GLint swizzle[] = { GL_RED, GL_RED, GL_RED, iImage.componentNb == 1 ? GL_ONE : GL_GREEN };
+    glTextureParameteriv(oTextureName, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+  }
+  __CheckGLErrors;
+
+  if (iMipmaps)
+  {
+    if (iImage.type == IL_UNSIGNED_BYTE)
+      createMipmaps(oTextureName, iImage.width, iImage.height, iImage.format, iImage.componentNb, iImage.data.data());
+    else
+      glGenerateTextureMipmap(oTextureName);
+    glTextureParameteri(oTextureName, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+    __CheckGLErrors;
+  }
+
+  oTextureHandle = glGetTextureHandleARB(oTextureName);
+  __CheckGLErrors;
+  if (iMakeResident)
+  {
+    UxResidencyManager::registerHandle(oTextureHandle, oTextureName);
+    UxResidencyManager::use(oTextureHandle);
+  }
+}
+
+// Rows decoded per strip (unit of the parallel decoding and of the progressive upload)
+static const uint32_t StripRowNb = 256;
+
+// Rows [iFirstRow, iFirstRow+iRowNb[ of the source, read into ioBuffer if not in memory
+typedef std::function<const uint8_t*(uint32_t iFirstRow, uint32_t iRowNb, std::vector<uint8_t>& ioBuffer)> StripReader;
+
+// Luminance of a source pixel (integer types normalized), weighted as the DevIL conversion for the color formats
+static float getLuminance(const uint8_t* iPixel, GLenum iType, uint32_t iComponentNb, bool iIsBGR)
+{
+  auto component = [iPixel, iType](uint32_t iRank) -> float
+  {
+    if (iType == GL_UNSIGNED_BYTE)
+      return iPixel[iRank] / 255.0f;
+    else if (iType == GL_UNSIGNED_SHORT)
+      return reinterpret_cast<const uint16_t*>(iPixel)[iRank] / 65535.0f;
+    return reinterpret_cast<const float*>(iPixel)[iRank];
+  };
+
+  if (iComponentNb < 3)
+    return component(0);
+  return 0.212671f*component(iIsBGR ? 2 : 0) + 0.715160f*component(1) + 0.072169f*component(iIsBGR ? 0 : 2);
+}
+
+// Source converted strip by strip (in parallel) into the single channel of the image, whose dimensions and format are set
+static void decodeStrips(const StripReader& iReader, GLenum iSourceType, uint32_t iComponentNb, bool iIsBGR, UxUtils::HeightImage& ioImage, const UxUtils::HeightDecodingListener* iListener)
+{
+  uint32_t stripNb      = (ioImage.height + StripRowNb - 1) / StripRowNb;
+  size_t   pixelSize    = UxUtils::getTypeSize(iSourceType)*iComponentNb;
+  uint32_t sampleSize   = UxUtils::getTypeSize(ioImage.type);
+  bool     isFloat      = (ioImage.type == GL_FLOAT || ioImage.type == GL_HALF_FLOAT);
+  bool     isRawCopy    = (iSourceType == ioImage.type && iComponentNb == 1);
+  auto     getRowNb     = [&ioImage](uint32_t iStrip) { return std::min(StripRowNb, ioImage.height - iStrip*StripRowNb); };
+
+  // Elevations of the float sources remapped from their extent to the normalized storages (additional pass)
+  Vector2f sourceRange = { 1.0f, 0.0f };
+  if (iSourceType == GL_FLOAT && !isFloat)
+  {
+    std::vector<float> minimums(stripNb), maximums(stripNb);
+    UxUtils::parallelFor(0, stripNb, [&](uint32_t iStrip)
+    {
+      std::vector<uint8_t> buffer;
+      const uint8_t* pixel = iReader(iStrip*StripRowNb, getRowNb(iStrip), buffer);
+      size_t pixelNb = (size_t)getRowNb(iStrip)*ioImage.width;
+      float  value   = getLuminance(pixel, iSourceType, iComponentNb, iIsBGR);
+      minimums[iStrip] = maximums[iStrip] = value;
+      for (size_t rank = 1; rank < pixelNb; rank++)
+      {
+        value = getLuminance(pixel + rank*pixelSize, iSourceType, iComponentNb, iIsBGR);
+        minimums[iStrip] = std::min(minimums[iStrip], value);
+        maximums[iStrip] = std::max(maximums[iStrip], value);
+      }
+    });
+
+    float minimum = *std::min_element(minimums.begin(), minimums.end());
+    float delta   = *std::max_element(maximums.begin(), maximums.end()) - minimum;
+    sourceRange   = delta > 0.0f ? Vector2f(1.0f / delta, -minimum / delta) : Vector2f(0.0f, 0.0f);
+  }
+
+  ioImage.samples.resize((size_t)ioImage.width*ioImage.height*sampleSize);
+  if (iListener && iListener->onStart)
+    iListener->onStart(ioImage);
+
+  // Extent of the stored values (range of the float storages)
+  std::vector<float> minimums(stripNb), maximums(stripNb);
+  UxUtils::parallelFor(0, stripNb, [&](uint32_t iStrip)
+  {
+    uint32_t firstRow = iStrip*StripRowNb;
+    uint32_t rowNb    = getRowNb(iStrip);
+    size_t   pixelNb  = (size_t)rowNb*ioImage.width;
+    uint8_t* samples  = ioImage.samples.data() + (size_t)firstRow*ioImage.width*sampleSize;
+
+    std::vector<uint8_t> buffer;
+    const uint8_t* pixel = iReader(firstRow, rowNb, buffer);
+    if (isRawCopy && !isFloat)
+      memcpy(samples, pixel, pixelNb*sampleSize);
+    else
+    {
+      minimums[iStrip] = FLT_MAX;
+      maximums[iStrip] = -FLT_MAX;
+      for (size_t rank = 0; rank < pixelNb; rank++)
+      {
+        float value = getLuminance(pixel + rank*pixelSize, iSourceType, iComponentNb, iIsBGR)*sourceRange[0] + sourceRange[1];
+        UxUtils::storeSample(samples + rank*sampleSize, ioImage.type, value);
+        minimums[iStrip] = std::min(minimums[iStrip], value);
+        maximums[iStrip] = std::max(maximums[iStrip], value);
+      }
+    }
+
+    if (iListener && iListener->onStrip)
+      iListener->onStrip(firstRow, rowNb);
+  });
+
+  // Normalized sources already in [0,1] (whatever the storage), elevations of float sources stored as float remapped
+  // from their extent
+  ioImage.range = { 1.0f, 0.0f };
+  if (iSourceType == GL_FLOAT && isFloat)
+  {
+    float minimum = *std::min_element(minimums.begin(), minimums.end());
+    float delta   = *std::max_element(maximums.begin(), maximums.end()) - minimum;
+    ioImage.range = delta > 0.0f ? Vector2f(1.0f / delta, -minimum / delta) : Vector2f(0.0f, 0.0f);
+  }
+}
+
+// Format of the storage following the precision of the source if not imposed
+static GLenum getHeightFormat(GLenum iInternalFormat, GLenum iSourceType)
+{
+  if (iInternalFormat != 0)
+    return iInternalFormat;
+  return iSourceType == GL_UNSIGNED_BYTE ? GL_R8 : (iSourceType == GL_UNSIGNED_SHORT ? GL_R16 : GL_R32F);
+}
+
+// Headerless raw file of iSourceType samples (iSize, square if null), every strip read by its own file stream
+static void decodeRawHeightMap(const std::string& iFilePath, GLenum iSourceType, GLenum iInternalFormat, const Vector2i& iSize, UxUtils::HeightImage& oImage, const UxUtils::HeightDecodingListener* iListener)
+{
+  FILE* fp = nullptr;
+  if (fopen_s(&fp, iFilePath.c_str(), "rb"))
+  {
+    UxError::error(__FILE__, __LINE__) << " Can't open the height map " << iFilePath << ".\n";
+    UxError::exit(-1);
+  }
+  _fseeki64(fp, 0, SEEK_END);
+  uint64_t sampleNb = _ftelli64(fp) / UxUtils::getTypeSize(iSourceType);
+  fclose(fp);
+
+  uint32_t width  = iSize[0];
+  uint32_t height = iSize[1];
+  if (width == 0 || height == 0)
+  {
+    width = (uint32_t)sqrt((double)sampleNb);
+    while ((uint64_t)width*width < sampleNb)
+      width++;
+    height = width;
+    if (sampleNb == 0 || (uint64_t)width*height != sampleNb)
+    {
+      UxError::error(__FILE__, __LINE__) << " The raw height map " << iFilePath << " is not square (dimensions to be given).\n";
+      UxError::exit(-1);
+    }
+  }
+  else if ((uint64_t)width*height != sampleNb)
+  {
+    UxError::error(__FILE__, __LINE__) << " The raw height map " << iFilePath << " holds " << sampleNb << " samples, not " << width << "x" << height << ".\n";
+    UxError::exit(-1);
+  }
+
+  oImage.internalFormat = getHeightFormat(iInternalFormat, iSourceType);
+  oImage.type   = UxUtils::getHeightType(oImage.internalFormat);
+  oImage.width  = width;
+  oImage.height = height;
+
+  size_t rowSize = (size_t)width*UxUtils::getTypeSize(iSourceType);
+  decodeStrips([&iFilePath, rowSize](uint32_t iFirstRow, uint32_t iRowNb, std::vector<uint8_t>& ioBuffer) -> const uint8_t*
+  {
+    ioBuffer.resize(rowSize*iRowNb);
+    FILE* fp = nullptr;
+    if (fopen_s(&fp, iFilePath.c_str(), "rb") || _fseeki64(fp, (int64_t)rowSize*iFirstRow, SEEK_SET) || fread(ioBuffer.data(), rowSize, iRowNb, fp) != iRowNb)
+    {
+      UxError::error(__FILE__, __LINE__) << " Can't read the rows " << iFirstRow << " to " << iFirstRow + iRowNb - 1 << " of the height map " << iFilePath << ".\n";
+      UxError::exit(-1);
+    }
+    fclose(fp);
+    return ioBuffer.data();
+  }, iSourceType, 1, false, oImage, iListener);
+}
+
+// libpng errors reported as the other decoding errors (no return to the decoder)
+static void onPngError(png_structp iPng, png_const_charp iMessage)
+{
+  UxError::error(__FILE__, __LINE__) << " Can't decode the height map " << (const char*)png_get_error_ptr(iPng) << " (" << iMessage << ").\n";
+  UxError::exit(-1);
+}
+
+static void onPngWarning(png_structp iPng, png_const_charp iMessage)
+{
+}
+
+// File read through the application's runtime (no FILE* handed to the library)
+static void readPngData(png_structp iPng, png_bytep oData, png_size_t iSize)
+{
+  if (fread(oData, 1, iSize, (FILE*)png_get_io_ptr(iPng)) != iSize)
+    png_error(iPng, "unexpected end of file");
+}
+
+// PNG decoded by libpng: the rows of the single deflate stream inflated in order by the strip needing them, the strips
+// already inflated being converted meanwhile by the other threads. Returns false for the images left to DevIL (palette,
+// interlacing)
+static bool decodePngHeightMap(const std::string& iFilePath, GLenum iInternalFormat, UxUtils::HeightImage& oImage, const UxUtils::HeightDecodingListener* iListener)
+{
+  FILE* fp = nullptr;
+  if (fopen_s(&fp, iFilePath.c_str(), "rb"))
+  {
+    UxError::error(__FILE__, __LINE__) << " Can't open the height map " << iFilePath << ".\n";
+    UxError::exit(-1);
+  }
+
+  png_structp png  = png_create_read_struct(PNG_LIBPNG_VER_STRING, (png_voidp)iFilePath.c_str(), onPngError, onPngWarning);
+  png_infop   info = png_create_info_struct(png);
+  png_set_read_fn(png, fp, readPngData);
+  png_read_info(png, info);
+
+  png_uint_32 width = 0, height = 0;
+  int bitDepth = 0, colorType = 0, interlaceType = 0;
+  png_get_IHDR(png, info, &width, &height, &bitDepth, &colorType, &interlaceType, nullptr, nullptr);
+  if (colorType == PNG_COLOR_TYPE_PALETTE || interlaceType != PNG_INTERLACE_NONE)
+  {
+    png_destroy_read_struct(&png, &info, nullptr);
+    fclose(fp);
+    return false;
+  }
+
+  // Samples of less than 8 bits read as bytes, 16 bits samples in the host order (little endian)
+  if (bitDepth < 8)
+    png_set_expand_gray_1_2_4_to_8(png);
+  if (bitDepth == 16)
+    png_set_swap(png);
+  png_read_update_info(png, info);
+
+  GLenum   sourceType  = (bitDepth == 16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE);
+  uint32_t componentNb = png_get_channels(png, info);
+  size_t   rowSize     = png_get_rowbytes(png, info);
+
+  oImage.internalFormat = getHeightFormat(iInternalFormat, sourceType);
+  oImage.type   = UxUtils::getHeightType(oImage.internalFormat);
+  oImage.width  = width;
+  oImage.height = height;
+
+  std::vector<uint8_t> rows(rowSize*height);
+  uint32_t             inflatedRowNb = 0;
+  std::mutex           inflatingMutex;
+  decodeStrips([&](uint32_t iFirstRow, uint32_t iRowNb, std::vector<uint8_t>& ioBuffer) -> const uint8_t*
+  {
+    std::lock_guard<std::mutex> lock(inflatingMutex);
+    for (; inflatedRowNb < iFirstRow + iRowNb; inflatedRowNb++)
+      png_read_row(png, rows.data() + rowSize*inflatedRowNb, nullptr);
+    return rows.data() + rowSize*iFirstRow;
+  }, sourceType, componentNb, false, oImage, iListener);
+
+  png_destroy_read_struct(&png, &info, nullptr);
+  fclose(fp);
+  return true;
+}
+
+// TIFF decoded by libtiff: every strip of rows read by its own handle from the TIFF strips covering it (compressed
+// independently, decompressed in parallel). Returns false for the images left to DevIL (tiles, separate planes, palette,
+// TIFF strips larger than the decoding strips...)
+static bool decodeTiffHeightMap(const std::string& iFilePath, GLenum iInternalFormat, UxUtils::HeightImage& oImage, const UxUtils::HeightDecodingListener* iListener)
+{
+  // Private tags (GeoTIFF...) unknown to the library not reported
+  TIFFSetWarningHandler(nullptr);
+
+  TIFF* tiff = TIFFOpen(iFilePath.c_str(), "r");
+  if (!tiff)
+  {
+    UxError::error(__FILE__, __LINE__) << " Can't open the height map " << iFilePath << ".\n";
+    UxError::exit(-1);
+  }
+
+  uint32_t width = 0, height = 0, rowsPerStrip = 0;
+  uint16_t bitsPerSample = 0, componentNb = 0, sampleFormat = 0, planarConfig = 0, photometric = 0;
+  TIFFGetField(tiff, TIFFTAG_IMAGEWIDTH, &width);
+  TIFFGetField(tiff, TIFFTAG_IMAGELENGTH, &height);
+  TIFFGetField(tiff, TIFFTAG_PHOTOMETRIC, &photometric);
+  TIFFGetFieldDefaulted(tiff, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
+  TIFFGetFieldDefaulted(tiff, TIFFTAG_SAMPLESPERPIXEL, &componentNb);
+  TIFFGetFieldDefaulted(tiff, TIFFTAG_SAMPLEFORMAT, &sampleFormat);
+  TIFFGetFieldDefaulted(tiff, TIFFTAG_PLANARCONFIG, &planarConfig);
+  TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+  bool isTiled = (TIFFIsTiled(tiff) != 0);
+  TIFFClose(tiff);
+
+  GLenum sourceType = 0;
+  if (sampleFormat == SAMPLEFORMAT_UINT && bitsPerSample == 8)
+    sourceType = GL_UNSIGNED_BYTE;
+  else if (sampleFormat == SAMPLEFORMAT_UINT && bitsPerSample == 16)
+    sourceType = GL_UNSIGNED_SHORT;
+  else if (sampleFormat == SAMPLEFORMAT_IEEEFP && bitsPerSample == 32)
+    sourceType = GL_FLOAT;
+
+  rowsPerStrip = std::min(rowsPerStrip, height);
+  if (sourceType == 0 || isTiled || planarConfig != PLANARCONFIG_CONTIG || (photometric != PHOTOMETRIC_MINISBLACK && photometric != PHOTOMETRIC_RGB)
+      || componentNb == 0 || componentNb > 4 || width == 0 || height == 0 || rowsPerStrip > StripRowNb)
+    return false;
+
+  oImage.internalFormat = getHeightFormat(iInternalFormat, sourceType);
+  oImage.type   = UxUtils::getHeightType(oImage.internalFormat);
+  oImage.width  = width;
+  oImage.height = height;
+
+  size_t rowSize = (size_t)width*componentNb*UxUtils::getTypeSize(sourceType);
+  decodeStrips([&iFilePath, rowSize, rowsPerStrip](uint32_t iFirstRow, uint32_t iRowNb, std::vector<uint8_t>& ioBuffer) -> const uint8_t*
+  {
+    TIFF* tiff = TIFFOpen(iFilePath.c_str(), "r");
+    if (!tiff)
+    {
+      UxError::error(__FILE__, __LINE__) << " Can't open the height map " << iFilePath << ".\n";
+      UxError::exit(-1);
+    }
+
+    ioBuffer.resize(rowSize*iRowNb);
+    std::vector<uint8_t> strip((size_t)TIFFStripSize(tiff));
+    for (uint32_t row = iFirstRow; row < iFirstRow + iRowNb;)
+    {
+      uint32_t stripFirstRow = row - row % rowsPerStrip;
+      uint32_t rowNb         = std::min(stripFirstRow + rowsPerStrip, iFirstRow + iRowNb) - row;
+      tmsize_t size          = TIFFReadEncodedStrip(tiff, TIFFComputeStrip(tiff, row, 0), strip.data(), (tmsize_t)strip.size());
+      if (size < (tmsize_t)(rowSize*(row - stripFirstRow + rowNb)))
+      {
+        UxError::error(__FILE__, __LINE__) << " Can't read the rows " << row << " to " << row + rowNb - 1 << " of the height map " << iFilePath << ".\n";
+        UxError::exit(-1);
+      }
+      memcpy(ioBuffer.data() + rowSize*(row - iFirstRow), strip.data() + rowSize*(row - stripFirstRow), rowSize*rowNb);
+      row += rowNb;
+    }
+
+    TIFFClose(tiff);
+    return ioBuffer.data();
+  }, sourceType, componentNb, false, oImage, iListener);
+  return true;
+}
+
+void UxUtils::decodeHeightMap(const std::string& iFilePath, GLenum iInternalFormat, HeightImage& oImage, const HeightDecodingListener* iListener, const Vector2i& iRawSize)
+{
+  std::string extension = iFilePath.substr(std::min(iFilePath.find_last_of('.'), iFilePath.size()));
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  if (extension == ".r8" || extension == ".r16" || extension == ".raw" || extension == ".r32")
+  {
+    GLenum sourceType = (extension == ".r8" ? GL_UNSIGNED_BYTE : (extension == ".r32" ? GL_FLOAT : GL_UNSIGNED_SHORT));
+    decodeRawHeightMap(iFilePath, sourceType, iInternalFormat, iRawSize, oImage, iListener);
+    return;
+  }
+  if (extension == ".png" && decodePngHeightMap(iFilePath, iInternalFormat, oImage, iListener))
+    return;
+  if ((extension == ".tif" || extension == ".tiff") && decodeTiffHeightMap(iFilePath, iInternalFormat, oImage, iListener))
+    return;
+
+  std::lock_guard<std::mutex> lock(gDecoderMutex);
+
+  if (!ilLoadImage((const wchar_t*)iFilePath.c_str()))
+  {
+    UxError::error(__FILE__, __LINE__) << " Can't load the height map " << iFilePath << ".\n";
+    UxError::exit(-1);
+  }
+
+  // Format following the decoded precision if not imposed
+  uint32_t decodedType = ilGetInteger(IL_IMAGE_TYPE);
+  oImage.internalFormat = iInternalFormat;
+  if (oImage.internalFormat == 0)
+  {
+    if (decodedType == IL_UNSIGNED_BYTE || decodedType == IL_BYTE)
+      oImage.internalFormat = GL_R8;
+    else if (decodedType == IL_UNSIGNED_SHORT || decodedType == IL_SHORT)
+      oImage.internalFormat = GL_R16;
+    else
+      oImage.internalFormat = GL_R32F;
+  }
+  oImage.type = getHeightType(oImage.internalFormat);
+
+  // Decoded components read as they are (the single channel is extracted by the strips, no converted copy of the
+  // image), the unusual types being converted to floats first and the other formats (palette indices, alpha...) to
+  // luminance
+  uint32_t format = ilGetInteger(IL_IMAGE_FORMAT);
+  bool isTypeRead   = (decodedType == IL_UNSIGNED_BYTE || decodedType == IL_UNSIGNED_SHORT || decodedType == IL_FLOAT);
+  bool isFormatRead = (format == IL_LUMINANCE || format == IL_RGB || format == IL_RGBA || format == IL_BGR || format == IL_BGRA);
+  if (!isTypeRead || !isFormatRead)
+  {
+    uint32_t convertedType   = isTypeRead ? decodedType : IL_FLOAT;
+    uint32_t convertedFormat = isFormatRead ? format : IL_LUMINANCE;
+    if (!ilConvertImage(convertedFormat, convertedType))
+    {
+      UxError::error(__FILE__, __LINE__) << " Can't convert the height map " << iFilePath << " to a readable format.\n";
+      UxError::exit(-1);
+    }
+    decodedType = convertedType;
+    format      = convertedFormat;
+  }
+
+  oImage.width  = ilGetInteger(IL_IMAGE_WIDTH);
+  oImage.height = ilGetInteger(IL_IMAGE_HEIGHT);
+  uint32_t componentNb = ilGetInteger(IL_IMAGE_CHANNELS);
+  const uint8_t* data    = ilGetData();
+  size_t         rowSize = (size_t)oImage.width*componentNb*getTypeSize(decodedType);
+
+  decodeStrips([data, rowSize](uint32_t iFirstRow, uint32_t iRowNb, std::vector<uint8_t>& ioBuffer) -> const uint8_t*
+  {
+    return data + rowSize*iFirstRow;
+  }, decodedType, componentNb, format == IL_BGR || format == IL_BGRA, oImage, iListener);
+}
+
+void UxUtils::createHeightTexture(const HeightImage& iImage, GLuint& oTextureName, GLuint64& oTextureHandle, bool iMakeResident, bool iMipmaps)
+{
+  createHeightStorage(iImage, oTextureName, iMipmaps);
+  uploadHeightRows(oTextureName, iImage, 0, iImage.height);
+  completeHeightTexture(iImage, oTextureName, oTextureHandle, iMakeResident, iMipmaps);
+}
+
+void UxUtils::createHeightStorage(const HeightImage& iImage, GLuint& oTextureName, bool iMipmaps)
+{
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  __CheckGLErrors;
+
+  GLsizei levelNb = 1;
+  if (iMipmaps)
+  {
+    while ((std::max(iImage.width, iImage.height) >> levelNb) > 0)
+      levelNb++;
+  }
+
+  glCreateTextures(GL_TEXTURE_2D, 1, &oTextureName);
+  __CheckGLErrors;
+  glTextureStorage2D(oTextureName, levelNb, iImage.internalFormat, iImage.width, iImage.height);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Texture, oTextureName, "UxUtils height map", getTextureSize(oTextureName), iImage.internalFormat);
+  glTextureParameteri(oTextureName, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTextureParameteri(oTextureName, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTextureParameteri(oTextureName, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTextureParameteri(oTextureName, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  __CheckGLErrors;
+}
+
+void UxUtils::uploadHeightRows(GLuint iTextureName, const HeightImage& iImage, uint32_t iFirstRow, uint32_t iRowNb)
+{
+  size_t rowSize = (size_t)iImage.width*getTypeSize(iImage.type);
+  uploadTextureRows(iTextureName, 0, iFirstRow, iImage.width, iRowNb, GL_RED, iImage.type, iImage.samples.data() + rowSize*iFirstRow, rowSize*iRowNb);
+}
+
+void UxUtils::completeHeightTexture(const HeightImage& iImage, GLuint iTextureName, GLuint64& oTextureHandle, bool iMakeResident, bool iMipmaps)
+{
+  if (iMipmaps)
+  {
+    if (iImage.type == GL_UNSIGNED_BYTE)
+      createMipmaps(iTextureName, iImage.width, iImage.height, GL_RED, 1, iImage.samples.data());
+    else
+      glGenerateTextureMipmap(iTextureName);
+    glTextureParameteri(iTextureName, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+    __CheckGLErrors;
+  }
+
+  oTextureHandle = glGetTextureHandleARB(iTextureName);
+  __CheckGLErrors;
+  if (iMakeResident)
+  {
+    UxResidencyManager::registerHandle(oTextureHandle, iTextureName);
+    UxResidencyManager::use(oTextureHandle);
+  }
+}
+
+uint64_t UxUtils::getTextureSize(GLuint iTextureName)
+{
+  GLint levelNb = 0;
+  glGetTextureParameteriv(iTextureName, GL_TEXTURE_IMMUTABLE_LEVELS, &levelNb);
+  __CheckGLErrors;
+
+  uint64_t size = 0;
+  for (GLint level = 0; level < std::max(levelNb, 1); level++)
+  {
+    GLint width = 0, height = 0, depth = 0, isCompressed = 0;
+    glGetTextureLevelParameteriv(iTextureName, level, GL_TEXTURE_WIDTH, &width);
+    glGetTextureLevelParameteriv(iTextureName, level, GL_TEXTURE_HEIGHT, &height);
+    glGetTextureLevelParameteriv(iTextureName, level, GL_TEXTURE_DEPTH, &depth);
+    glGetTextureLevelParameteriv(iTextureName, level, GL_TEXTURE_COMPRESSED, &isCompressed);
+    if (isCompressed)
+    {
+      GLint compressedSize = 0;
+      glGetTextureLevelParameteriv(iTextureName, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &compressedSize);
+      size += (uint64_t)compressedSize;
+      continue;
+    }
+
+    // Bits per texel: sum of the component sizes
+    const GLenum components[] = { GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE, GL_TEXTURE_DEPTH_SIZE, GL_TEXTURE_STENCIL_SIZE };
+    GLint texelBits = 0;
+    for (GLenum component : components)
+    {
+      GLint bits = 0;
+      glGetTextureLevelParameteriv(iTextureName, level, component, &bits);
+      texelBits += bits;
+    }
+    size += (uint64_t)width * height * std::max(depth, 1) * texelBits / 8;
+  }
+  __CheckGLErrors;
+
+  return size;
+}
+
+GLenum UxUtils::getHeightType(GLenum iInternalFormat)
+{
+  switch (iInternalFormat)
+  {
+  case GL_R8:
+    return GL_UNSIGNED_BYTE;
+  case GL_R16:
+    return GL_UNSIGNED_SHORT;
+  case GL_R16F:
+    return GL_HALF_FLOAT;
+  case GL_R32F:
+    return GL_FLOAT;
+  }
+
+  UxError::error(__FILE__, __LINE__) << " Unsupported height map format (" << iInternalFormat << ").\n";
+  UxError::exit(-1);
+  return 0;
+}
+
+uint32_t UxUtils::getTypeSize(GLenum iType)
+{
+  switch (iType)
+  {
+  case GL_UNSIGNED_BYTE:
+    return 1;
+  case GL_UNSIGNED_SHORT:
+  case GL_HALF_FLOAT:
+    return 2;
+  }
+  return 4;
+}
+
+float UxUtils::halfToFloat(uint16_t iHalf)
+{
+  uint32_t sign     = (iHalf & 0x8000u) << 16;
+  uint32_t exponent = (iHalf >> 10) & 0x1Fu;
+  uint32_t mantissa = iHalf & 0x3FFu;
+
+  uint32_t bits;
+  if (exponent == 0x1Fu)
+    bits = sign | 0x7F800000u | (mantissa << 13);                  // Infinity, NaN
+  else if (exponent != 0)
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);     // Normalized (bias 15 -> 127)
+  else if (mantissa != 0)
+  {
+    // Subnormal: mantissa normalized
+    exponent = 113;
+    while ((mantissa & 0x400u) == 0)
+    {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+  }
+  else
+    bits = sign;
+
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint16_t UxUtils::floatToHalf(float iValue)
+{
+  uint32_t bits;
+  memcpy(&bits, &iValue, sizeof(bits));
+
+  uint16_t sign     = (uint16_t)((bits >> 16) & 0x8000u);
+  int32_t  exponent = (int32_t)((bits >> 23) & 0xFFu) - 112;   // Bias 127 -> 15
+  uint32_t mantissa = bits & 0x7FFFFFu;
+
+  if (((bits >> 23) & 0xFFu) == 0xFFu)
+    return sign | 0x7C00u | (mantissa ? 0x200u : 0u);           // Infinity, NaN
+  if (exponent >= 0x1F)
+    return sign | 0x7C00u;                                      // Overflow: infinity
+  if (exponent <= 0)
+  {
+    // Subnormal (or zero), rounded to nearest
+    if (exponent < -10)
+      return sign;
+    mantissa |= 0x800000u;
+    uint32_t shift = 14 - exponent;
+    uint32_t half  = mantissa >> shift;
+    if ((mantissa >> (shift - 1)) & 1u)
+      half++;
+    return sign | (uint16_t)half;
+  }
+
+  // Normalized, rounded to nearest (a carry into the exponent remains valid)
+  uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+  if (mantissa & 0x1000u)
+    half++;
+  return sign | (uint16_t)half;
+}
+
+
+float UxUtils::loadSample(const uint8_t* iSample, GLenum iType)
+{
+  if (iType == GL_UNSIGNED_BYTE)
+    return *iSample / 255.0f;
+  else if (iType == GL_UNSIGNED_SHORT)
+    return *reinterpret_cast<const uint16_t*>(iSample) / 65535.0f;
+  else if (iType == GL_HALF_FLOAT)
+    return halfToFloat(*reinterpret_cast<const uint16_t*>(iSample));
+  return *reinterpret_cast<const float*>(iSample);
+}
+
+void UxUtils::storeSample(uint8_t* oSample, GLenum iType, float iValue)
+{
+  if (iType == GL_UNSIGNED_BYTE)
+    *oSample = (uint8_t)(std::min(std::max(iValue, 0.0f), 1.0f)*255.0f + 0.5f);
+  else if (iType == GL_UNSIGNED_SHORT)
+    *reinterpret_cast<uint16_t*>(oSample) = (uint16_t)(std::min(std::max(iValue, 0.0f), 1.0f)*65535.0f + 0.5f);
+  else if (iType == GL_HALF_FLOAT)
+    *reinterpret_cast<uint16_t*>(oSample) = floatToHalf(iValue);
+  else
+    *reinterpret_cast<float*>(oSample) = iValue;
+}
+
+std::string UxUtils::GLSLTypeToCPlusPlus(const char* iDeclaration)
+{
+  static const char *table[][2] = { {"Vector([234])f", "vec$1"}, { "Vector([234])([diu])", "$2vec$1" }, { "Matrix([34])f", "mat$1"}, { "Matrix([34])d", "dmat$1" }, { "uint32_t", "uint" }, { "int32_t", "int" } };
+
+  for (auto couple : table)
+  {
+    if (std::regex_search(iDeclaration, std::regex(couple[0])))
+      return std::regex_replace(iDeclaration, std::regex(couple[0]), couple[1]);
+  }
+
+  return iDeclaration;
+}
+
+
+GLenum UxUtils::getSizedFormat(uint32_t iComponentNb, GLenum iType)
+{
+  static const GLenum formats[][4] = { { GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 }, { GL_R16, GL_RG16, GL_RGB16, GL_RGBA16 }, { GL_R32F, GL_RG32F, GL_RGB32F, GL_RGBA32F } };
+
+  if (iComponentNb < 1 || iComponentNb > 4 || (iType != GL_UNSIGNED_BYTE && iType != GL_UNSIGNED_SHORT && iType != GL_FLOAT))
+  {
+    UxError::error(__FILE__, __LINE__) << " Unsupported texture format (" << iComponentNb << " components of type " << iType << ").\n";
+    UxError::UxError::exit(-1);
+  }
+
+  return formats[iType == GL_UNSIGNED_BYTE ? 0 : (iType == GL_UNSIGNED_SHORT ? 1 : 2)][iComponentNb - 1];
+}
+
+void UxUtils::uploadTextureRows(GLuint iTextureName, GLint iLevel, uint32_t iFirstRow, uint32_t iWidth, uint32_t iRowNb, GLenum iFormat, GLenum iType, const void* iData, size_t iSize)
+{
+  // Pixels copied into a staging buffer, the texture being filled from it by the GPU (the copy doesn't wait for
+  // the texture to be idle, the buffer storage is released once the transfer is done)
+  GLuint buffer = 0;
+  glCreateBuffers(1, &buffer);
+  __CheckGLErrors;
+  glNamedBufferStorage(buffer, iSize, nullptr, GL_MAP_WRITE_BIT);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Buffer, buffer, "UxUtils staging", iSize, 0);
+
+  void* mappedData = glMapNamedBufferRange(buffer, 0, iSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  __CheckGLErrors;
+  if (!mappedData)
+  {
+    UxError::error(__FILE__, __LINE__) << "Can't map the staging buffer of a texture (" << iSize << " bytes).\n";
+    UxError::exit(-1);
+  }
+  memcpy(mappedData, iData, iSize);
+  glUnmapNamedBuffer(buffer);
+
+  // Raw bindings (UxGLState caches the bindings of the rendering context only, this may run on the upload thread)
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+  glTextureSubImage2D(iTextureName, iLevel, 0, iFirstRow, iWidth, iRowNb, iFormat, iType, nullptr);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  UxGPUMemoryRegistry::release(UxGPUMemoryRegistry::Buffer, buffer);
+  glDeleteBuffers(1, &buffer);
+  __CheckGLErrors;
+}
+
+void UxUtils::createMipmaps(GLuint iTextureName, uint32_t iWidth, uint32_t iHeight, GLenum iFormat, uint32_t iComponentNb, const uint8_t* iData)
+{
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  __CheckGLErrors;
+
+  std::vector<uint8_t> source(iData, iData + iWidth*iHeight*iComponentNb);
+  uint32_t width  = iWidth;
+  uint32_t height = iHeight;
+  for (GLint level = 1; width > 1 || height > 1; level++)
+  {
+    uint32_t levelWidth  = std::max(width / 2, 1u);
+    uint32_t levelHeight = std::max(height / 2, 1u);
+    std::vector<uint8_t> target(levelWidth*levelHeight*iComponentNb);
+
+    // Every texel averages the 2x2 texels of the previous level (rows computed in parallel)
+    parallelFor(0, levelHeight, [&](uint32_t iRow)
+    {
+      uint32_t rows[2] = { std::min(2*iRow, height-1), std::min(2*iRow+1, height-1) };
+      for (uint32_t column = 0; column < levelWidth; column++)
+      {
+        uint32_t columns[2] = { std::min(2*column, width-1), std::min(2*column+1, width-1) };
+        for (uint32_t component = 0; component < iComponentNb; component++)
+        {
+          uint32_t sum = 0;
+          for (uint32_t row : rows)
+          {
+            for (uint32_t sourceColumn : columns)
+              sum += source[(row*width + sourceColumn)*iComponentNb + component];
+          }
+          target[(iRow*levelWidth + column)*iComponentNb + component] = (uint8_t)((sum + 2) / 4);
+        }
+      }
+    });
+
+    glTextureSubImage2D(iTextureName, level, 0, 0, levelWidth, levelHeight, iFormat, GL_UNSIGNED_BYTE, target.data());
+    __CheckGLErrors;
+
+    source.swap(target);
+    width  = levelWidth;
+    height = levelHeight;
+  }
+}
+
+void UxUtils::parallelFor(uint32_t iBegin, uint32_t iEnd, const std::function<void(uint32_t)>& iFunction)
+{
+  UxThreadPool::getShared().parallelFor(iBegin, iEnd, iFunction);
+}
+
+bool UxUtils::deviation(float iRefValue, float iComputedValue, float iRatio)
+{
+  return fabs(iComputedValue - iRefValue) < iRatio;
+}
+
+uint32_t UxUtils::mortonCode(uint16_t iX, uint16_t iY)
+{
+  auto spreadBits = [](uint32_t value)
+  {
+    value = (value | (value << 8)) & 0x00FF00FFu;
+    value = (value | (value << 4)) & 0x0F0F0F0Fu;
+    value = (value | (value << 2)) & 0x33333333u;
+    value = (value | (value << 1)) & 0x55555555u;
+    return value;
+  };
+
+  return spreadBits(iX) | (spreadBits(iY) << 1);
+}
@@ -1,92 +1,132 @@
-//========================================================================
-//  Height Map Terrain Model
-//  MIT License
-//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
-//========================================================================
-
-#include "UxVertexArrayBase.h"
-
-UxVertexArrayBase::UxVertexArrayBase()
-{
-  _Array     = -1; // Avoid use if "VAO object 0 a default object"
-  _Buffer    =  0;
-  _BufferSize = -1;
-
-  glGenVertexArrays(1, &_Array);
-  __CheckGLErrors;
-  
-  glGenBuffers(1, &_Buffer);
-  __CheckGLErrors;
-   
-  glBindBuffer(GL_ARRAY_BUFFER, _Buffer);
-  __CheckGLErrors;
-}
-
-UxVertexArrayBase::~UxVertexArrayBase()
-{
-  if (_Array != -1)
-  {
-    glDeleteVertexArrays(1, &_Array);
-    _Array = -1;
-  }
-
-  if (_Buffer)
-  {
-    glDeleteBuffers(1, &_Buffer);
-    _Buffer = 0;
-  }
-}
-
-void UxVertexArrayBase::clearVector()
-{
-  _BufferSize = -1;
-}
-
-void UxVertexArrayBase::store(GLenum iUsage)
-{
-  assert(_BufferSize == -1);
-
-  glBindBuffer(GL_ARRAY_BUFFER, _Buffer);
-  __CheckGLErrors;
-
-  _BufferSize = getElementNumber();
-  assert(_BufferSize > -1);
-
-  glBufferData(GL_ARRAY_BUFFER, getStructureSize()*_BufferSize, getData(), GL_STREAM_DRAW);
-  __CheckGLErrors;
-
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  __CheckGLErrors;
-}
-
-void UxVertexArrayBase::bind(const UxIndexBuffer& iIndexBuffer) const
-{
-  assert(_Array != -1 && _Buffer != 0 && _BufferSize != -1);
-  glBindVertexArray(_Array);
-  glBindBuffer(GL_ARRAY_BUFFER, _Buffer);
-  iIndexBuffer.bind();
-}
-
-void UxVertexArrayBase::unbind()
-{
-  glBindVertexArray(0);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  UxIndexBuffer::unbind();
-}
-
-void UxVertexArrayBase::linkAttribute(std::shared_ptr<UxVertexInputAttribute> iInputAttribute, GLenum iDataAttributeType, uint32_t iNbComponents, uint32_t iVertexSize, uint32_t iAttributeOffset, bool iNormalized)
-{
-  assert(iInputAttribute);
-
-  int32_t location = iInputAttribute->getLocation();
-  assert(location >= 0);
-
-  glBindVertexArray(_Array);
-  __CheckGLErrors;
-  glBindBuffer(GL_ARRAY_BUFFER, _Buffer);
-  __CheckGLErrors;
-  glEnableVertexAttribArray(location);
-  glVertexAttribPointer(location, iNbComponents, iDataAttributeType, iNormalized, iVertexSize, reinterpret_cast<const GLvoid*>(iAttributeOffset));
-  __CheckGLErrors;
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-}
+//========================================================================
+//  Height Map Terrain Model
+//  MIT License
+//  Copyright (c) 2017 Emmanuel DUPUIS, emmanuel.dupuis@undecentum.com
+//========================================================================
+
+#include "UxVertexArrayBase.h"
+#include "UxStreamBuffer.h"
+#include "UxGLState.h"
+#include "UxAllocationCounter.h"
+#include "UxGPUMemoryRegistry.h"
+
+UxVertexArrayBase::UxVertexArrayBase()
+{
+  _Array         =  0;
+  _Buffer        =  0;
+  _BufferSize    = -1;
+  _AllocatedSize =  0;
+  _IsStreamed    =  false;
+  _IsStreaming   =  false;
+
+  // Objects created without binding (direct state access)
+  glCreateVertexArrays(1, &_Array);
+  __CheckGLErrors;
+  
+  glCreateBuffers(1, &_Buffer);
+  __CheckGLErrors;
+}
+
+UxVertexArrayBase::~UxVertexArrayBase()
+{
+  UxGLState::deleteVertexArray(_Array);
+  UxGLState::deleteBuffer(_Buffer);
+}
+
+void UxVertexArrayBase::clearVector()
+{
+  assert(!_IsStreaming);
+  _BufferSize = -1;
+}
+
+void UxVertexArrayBase::store(GLenum iUsage)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::BufferStaging);
+  assert(_BufferSize == -1);
+
+  _BufferSize = getElementNumber();
+  assert(_BufferSize > -1 && !_IsStreaming);
+
+  // The storage is only reallocated if the content doesn't fit
+  GLsizeiptr size = getStructureSize()*_BufferSize;
+  if (size > _AllocatedSize || size == 0)
+  {
+    glNamedBufferData(_Buffer, size, getData(), iUsage);
+    _AllocatedSize = size;
+    UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Buffer, _Buffer, "UxVertexArray", size, iUsage);
+  }
+  else
+    glNamedBufferSubData(_Buffer, 0, size, getData());
+  __CheckGLErrors;
+
+  restoreBuffer();
+}
+
+void UxVertexArrayBase::reserve(uint32_t iElementNumber, GLenum iUsage)
+{
+  UxAllocationScope allocationScope(UxAllocationCounter::BufferStaging);
+  assert(!_IsStreaming);
+
+  _BufferSize = iElementNumber;
+  _AllocatedSize = getStructureSize()*_BufferSize;
+  glNamedBufferData(_Buffer, _AllocatedSize, nullptr, iUsage);
+  __CheckGLErrors;
+  UxGPUMemoryRegistry::record(UxGPUMemoryRegistry::Buffer, _Buffer, "UxVertexArray", _AllocatedSize, iUsage);
+
+  restoreBuffer();
+}
+
+void* UxVertexArrayBase::beginStream(UxStreamBuffer& ioStream, uint32_t iMaxElementNumber)
+{
+  assert(_BufferSize == -1 && !_IsStreaming && iMaxElementNumber > 0);
+
+  // The vertex buffer binding of the array points at the region (the draws start at the first vertex)
+  UxStreamBuffer::Allocation allocation = ioStream.allocate(getStructureSize()*iMaxElementNumber, 16);
+  glVertexArrayVertexBuffer(_Array, 0, allocation.buffer, allocation.offset, getStructureSize());
+  __CheckGLErrors;
+
+  _IsStreamed  = true;
+  _IsStreaming = true;
+  return allocation.data;
+}
+
+void UxVertexArrayBase::endStream(uint32_t iElementNumber)
+{
+  assert(_IsStreaming);
+  _BufferSize  = iElementNumber;
+  _IsStreaming = false;
+}
+
+void UxVertexArrayBase::restoreBuffer()
+{
+  // Array read from its own buffer again after a stream
+  if (_IsStreamed)
+  {
+    glVertexArrayVertexBuffer(_Array, 0, _Buffer, 0, getStructureSize());
+    __CheckGLErrors;
+    _IsStreamed = false;
+  }
+}
+
+void UxVertexArrayBase::bind(const UxIndexBuffer& iIndexBuffer) const
+{
+  assert(_Array != 0 && _Buffer != 0 && _BufferSize != -1);
+  UxGLState::bindVertexArray(_Array, iIndexBuffer.getBuffer());
+  iIndexBuffer.setPrimitiveRestart();
+}
+
+void UxVertexArrayBase::linkAttribute(std::shared_ptr<UxVertexInputAttribute> iInputAttribute, GLenum iDataAttributeType, uint32_t iNbComponents, uint32_t iVertexSize, uint32_t iAttributeOffset, bool iNormalized)
+{
+  assert(iInputAttribute);
+
+  int32_t location = iInputAttribute->getLocation();
+  assert(location >= 0);
+
+  // Every attribute read from the vertex buffer through the binding point 0
+  glVertexArrayVertexBuffer(_Array, 0, _Buffer, 0, iVertexSize);
+  __CheckGLErrors;
+  glEnableVertexArrayAttrib(_Array, location);
+  glVertexArrayAttribFormat(_Array, location, iNbComponents, iDataAttributeType, iNormalized, iAttributeOffset);
+  glVertexArrayAttribBinding(_Array, location, 0);
+  __CheckGLErrors;
+}